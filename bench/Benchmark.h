@@ -0,0 +1,171 @@
+/**
+ * @file Benchmark.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ * @brief A minimal microbenchmark harness that reports results as JSON
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Prevents the compiler from optimizing away a value computed in a benchmark loop
+ */
+template <class T>
+inline void DoNotOptimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Timing results for a single benchmark (and argument)
+ */
+struct BenchmarkResult
+{
+    std::string Name;
+    int64_t Arg;
+    uint64_t Iterations;
+    double NsPerOpMin;
+    double NsPerOpMedian;
+    double NsPerOpMean;
+};
+
+/**
+ * @brief
+ *  Passed to each benchmark body. The body performs any setup, then hands the operation
+ *  under test to Run(), which calibrates an iteration count and times several samples.
+ */
+class BenchmarkState
+{
+public:
+    BenchmarkState(std::string name, int64_t arg, std::chrono::nanoseconds minSampleTime) :
+        name(name),
+        arg(arg),
+        minSampleTime(minSampleTime)
+    { }
+
+    /**
+     * @brief Argument the benchmark was registered with (e.g. number of store entries)
+     */
+    int64_t Arg() const
+    {
+        return arg;
+    }
+
+    /**
+     * @brief Repeatedly times `operation`, one call per iteration
+     */
+    template <class TOperation>
+    void Run(TOperation&& operation)
+    {
+        // Grow the iteration count until a single sample takes long enough to measure
+        uint64_t iterations = 1;
+        while (true)
+        {
+            auto elapsed = timeIterations(operation, iterations);
+            if ((elapsed >= minSampleTime) || (iterations >= (uint64_t{1} << 40)))
+            {
+                break;
+            }
+            iterations *= 2;
+        }
+
+        std::vector<double> samples;
+        for (int i = 0; i < SAMPLE_COUNT; ++i)
+        {
+            auto elapsed = timeIterations(operation, iterations);
+            samples.push_back(static_cast<double>(elapsed.count()) / iterations);
+        }
+        std::sort(samples.begin(), samples.end());
+        double total = 0;
+        for (const auto& sample : samples)
+        {
+            total += sample;
+        }
+        result = BenchmarkResult
+        {
+            .Name = name,
+            .Arg = arg,
+            .Iterations = (iterations * SAMPLE_COUNT),
+            .NsPerOpMin = samples.front(),
+            .NsPerOpMedian = samples.at(samples.size() / 2),
+            .NsPerOpMean = (total / samples.size()),
+        };
+    }
+
+    const BenchmarkResult& GetResult() const
+    {
+        return result;
+    }
+
+private:
+    static constexpr int SAMPLE_COUNT = 5;
+    const std::string name;
+    const int64_t arg;
+    const std::chrono::nanoseconds minSampleTime;
+    BenchmarkResult result { };
+
+    template <class TOperation>
+    static std::chrono::nanoseconds timeIterations(TOperation& operation, uint64_t iterations)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < iterations; ++i)
+        {
+            operation();
+        }
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start);
+    }
+};
+
+/**
+ * @brief Global list of benchmarks, populated by ORCHESTRATOR_BENCHMARK at static init time
+ */
+class BenchmarkRegistry
+{
+public:
+    struct Entry
+    {
+        std::string Name;
+        std::vector<int64_t> Args;
+        std::function<void(BenchmarkState&)> Body;
+    };
+
+    static std::vector<Entry>& All()
+    {
+        static std::vector<Entry> entries;
+        return entries;
+    }
+
+    BenchmarkRegistry(
+        std::string name,
+        std::vector<int64_t> args,
+        std::function<void(BenchmarkState&)> body)
+    {
+        All().push_back(Entry { .Name = name, .Args = args, .Body = body });
+    }
+};
+
+#define ORCHESTRATOR_BENCHMARK_CONCAT_INNER(a, b) a##b
+#define ORCHESTRATOR_BENCHMARK_CONCAT(a, b) ORCHESTRATOR_BENCHMARK_CONCAT_INNER(a, b)
+
+/**
+ * @brief
+ *  Registers a benchmark body. Optional trailing arguments are run as separate cases and are
+ *  available through state.Arg().
+ *  ORCHESTRATOR_BENCHMARK("StreamStore lookup", 10000, 100000)(BenchmarkState& state) { ... }
+ */
+#define ORCHESTRATOR_BENCHMARK(name, ...) \
+    static void ORCHESTRATOR_BENCHMARK_CONCAT(benchmarkBody, __LINE__)(BenchmarkState&); \
+    static BenchmarkRegistry ORCHESTRATOR_BENCHMARK_CONCAT(benchmarkRegistration, __LINE__)( \
+        name, \
+        std::vector<int64_t>{ __VA_ARGS__ }, \
+        &ORCHESTRATOR_BENCHMARK_CONCAT(benchmarkBody, __LINE__)); \
+    static void ORCHESTRATOR_BENCHMARK_CONCAT(benchmarkBody, __LINE__)
@@ -0,0 +1,245 @@
+/**
+ * @file FtlConnectionBenchmarks.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ * @brief Microbenchmarks for FtlConnection message (de)serialization and framing
+ */
+
+#include "Benchmark.h"
+
+#include <FtlConnection.h>
+
+#include "../test/mocks/MockConnectionTransport.h"
+
+#pragma region Helpers
+namespace
+{
+    /**
+     * @brief Transport that throws away everything written to it, so Send* benchmarks only
+     *  measure serialization.
+     */
+    class NullConnectionTransport : public IConnectionTransport
+    {
+    public:
+        void StartAsync() override
+        { }
+
+        void Stop() override
+        { }
+
+        void Write(const std::vector<std::byte>& bytes) override
+        {
+            DoNotOptimize(bytes.data());
+        }
+
+        size_t GetPendingWriteSize() override
+        {
+            return 0;
+        }
+
+        void SetOnWriteProgress(std::function<void(size_t)>) override
+        { }
+
+        void SetOnBytesReceived(std::function<void(const std::vector<std::byte>&)>) override
+        { }
+
+        void SetOnConnectionClosed(std::function<void(void)>) override
+        { }
+    };
+
+    std::vector<std::byte> nodeStateRequestBytes(uint8_t messageId)
+    {
+        std::vector<std::byte> payload = FtlConnection::ConvertToNetworkPayload(uint32_t{10});
+        auto maxLoad = FtlConnection::ConvertToNetworkPayload(uint32_t{100});
+        payload.insert(payload.end(), maxLoad.begin(), maxLoad.end());
+        auto message = FtlConnection::SerializeMessageHeader(OrchestrationMessageHeader
+            {
+                .MessageDirection = OrchestrationMessageDirectionKind::Request,
+                .MessageFailure = false,
+                .MessageType = OrchestrationMessageType::NodeState,
+                .MessageId = messageId,
+                .MessagePayloadLength = static_cast<uint16_t>(payload.size()),
+            });
+        message.insert(message.end(), payload.begin(), payload.end());
+        return message;
+    }
+
+    /**
+     * @brief Feeds `readBuffer` to a started connection repeatedly, draining its responses
+     *  every so often so the mock's write buffer doesn't grow without bound.
+     */
+    void runFramingBenchmark(BenchmarkState& state, const std::vector<std::byte>& readBuffer)
+    {
+        auto mockTransport = std::make_shared<MockConnectionTransport>();
+        auto ftlConnection = std::make_shared<FtlConnection>(mockTransport);
+        ftlConnection->SetOnNodeState(
+            [](ConnectionNodeStatePayload payload)
+            {
+                DoNotOptimize(payload.CurrentLoad);
+                return ConnectionResult { .IsSuccess = true };
+            });
+        ftlConnection->Start();
+
+        uint64_t iteration = 0;
+        state.Run(
+            [&]()
+            {
+                mockTransport->MockSetReadBuffer(readBuffer);
+                if ((++iteration % 1024) == 0)
+                {
+                    mockTransport->WaitForWrite(std::chrono::milliseconds(0));
+                }
+            });
+        ftlConnection->Stop();
+    }
+}
+#pragma endregion Helpers
+
+#pragma region Header benchmarks
+ORCHESTRATOR_BENCHMARK("FtlConnection::ParseMessageHeader")(BenchmarkState& state)
+{
+    auto headerBytes = FtlConnection::SerializeMessageHeader(OrchestrationMessageHeader
+        {
+            .MessageDirection = OrchestrationMessageDirectionKind::Request,
+            .MessageFailure = false,
+            .MessageType = OrchestrationMessageType::StreamRelay,
+            .MessageId = 42,
+            .MessagePayloadLength = 1024,
+        });
+    state.Run(
+        [&]()
+        {
+            auto header = FtlConnection::ParseMessageHeader(headerBytes);
+            DoNotOptimize(header);
+        });
+}
+
+ORCHESTRATOR_BENCHMARK("FtlConnection::SerializeMessageHeader")(BenchmarkState& state)
+{
+    OrchestrationMessageHeader header
+    {
+        .MessageDirection = OrchestrationMessageDirectionKind::Request,
+        .MessageFailure = false,
+        .MessageType = OrchestrationMessageType::StreamRelay,
+        .MessageId = 42,
+        .MessagePayloadLength = 1024,
+    };
+    state.Run(
+        [&]()
+        {
+            auto headerBytes = FtlConnection::SerializeMessageHeader(header);
+            DoNotOptimize(headerBytes.data());
+        });
+}
+#pragma endregion Header benchmarks
+
+#pragma region Serializer benchmarks
+ORCHESTRATOR_BENCHMARK("FtlConnection::SendIntro")(BenchmarkState& state)
+{
+    FtlConnection connection(std::make_shared<NullConnectionTransport>());
+    ConnectionIntroPayload payload
+    {
+        .VersionMajor = 0,
+        .VersionMinor = 1,
+        .VersionRevision = 2,
+        .RelayLayer = 0,
+        .RegionCode = "sea",
+        .Hostname = "ingest-sea-01.example.com",
+    };
+    state.Run([&]() { connection.SendIntro(payload); });
+}
+
+ORCHESTRATOR_BENCHMARK("FtlConnection::SendOutro")(BenchmarkState& state)
+{
+    FtlConnection connection(std::make_shared<NullConnectionTransport>());
+    ConnectionOutroPayload payload { .DisconnectReason = "Shutting down for maintenance" };
+    state.Run([&]() { connection.SendOutro(payload); });
+}
+
+ORCHESTRATOR_BENCHMARK("FtlConnection::SendNodeState")(BenchmarkState& state)
+{
+    FtlConnection connection(std::make_shared<NullConnectionTransport>());
+    ConnectionNodeStatePayload payload { .CurrentLoad = 10, .MaximumLoad = 100 };
+    state.Run([&]() { connection.SendNodeState(payload); });
+}
+
+ORCHESTRATOR_BENCHMARK("FtlConnection::SendChannelSubscription")(BenchmarkState& state)
+{
+    FtlConnection connection(std::make_shared<NullConnectionTransport>());
+    ConnectionSubscriptionPayload payload
+    {
+        .IsSubscribe = true,
+        .ChannelId = 1234,
+        .StreamKey = std::vector<std::byte>(32, std::byte{0x7f}),
+    };
+    state.Run([&]() { connection.SendChannelSubscription(payload); });
+}
+
+ORCHESTRATOR_BENCHMARK("FtlConnection::SendStreamPublish")(BenchmarkState& state)
+{
+    FtlConnection connection(std::make_shared<NullConnectionTransport>());
+    ConnectionPublishPayload payload { .IsPublish = true, .ChannelId = 1234, .StreamId = 5678 };
+    state.Run([&]() { connection.SendStreamPublish(payload); });
+}
+
+ORCHESTRATOR_BENCHMARK("FtlConnection::SendStreamRelay")(BenchmarkState& state)
+{
+    FtlConnection connection(std::make_shared<NullConnectionTransport>());
+    ConnectionRelayPayload payload
+    {
+        .IsStartRelay = true,
+        .ChannelId = 1234,
+        .StreamId = 5678,
+        .TargetHostname = "edge-sea-01.example.com",
+        .StreamKey = std::vector<std::byte>(32, std::byte{0x7f}),
+    };
+    state.Run([&]() { connection.SendStreamRelay(payload); });
+}
+#pragma endregion Serializer benchmarks
+
+#pragma region Framing benchmarks
+ORCHESTRATOR_BENCHMARK("FtlConnection framing, messages per read", 1, 32)(
+    BenchmarkState& state)
+{
+    std::vector<std::byte> readBuffer;
+    for (int64_t i = 0; i < state.Arg(); ++i)
+    {
+        auto message = nodeStateRequestBytes(static_cast<uint8_t>(i));
+        readBuffer.insert(readBuffer.end(), message.begin(), message.end());
+    }
+    runFramingBenchmark(state, readBuffer);
+}
+
+ORCHESTRATOR_BENCHMARK("FtlConnection framing, message split across reads")(
+    BenchmarkState& state)
+{
+    // Each iteration delivers one half of a message, so the connection has to buffer a
+    // partial message every other call
+    auto message = nodeStateRequestBytes(0);
+    size_t splitPoint = (message.size() / 2);
+    std::vector<std::byte> firstHalf(message.begin(), message.begin() + splitPoint);
+    std::vector<std::byte> secondHalf(message.begin() + splitPoint, message.end());
+
+    auto mockTransport = std::make_shared<MockConnectionTransport>();
+    auto ftlConnection = std::make_shared<FtlConnection>(mockTransport);
+    ftlConnection->SetOnNodeState(
+        [](ConnectionNodeStatePayload)
+        {
+            return ConnectionResult { .IsSuccess = true };
+        });
+    ftlConnection->Start();
+
+    uint64_t iteration = 0;
+    state.Run(
+        [&]()
+        {
+            mockTransport->MockSetReadBuffer(((iteration & 1) == 0) ? firstHalf : secondHalf);
+            if ((++iteration % 1024) == 0)
+            {
+                mockTransport->WaitForWrite(std::chrono::milliseconds(0));
+            }
+        });
+    ftlConnection->Stop();
+}
+#pragma endregion Framing benchmarks
@@ -0,0 +1,193 @@
+/**
+ * @file OrchestratorBenchmarks.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ * @brief
+ *  Measures orchestration logic on its own by embedding an Orchestrator and driving it over
+ *  in-process connections, with no serialization or sockets involved
+ */
+
+#include "Benchmark.h"
+
+#include <InProcessConnection.h>
+#include <InProcessConnectionManager.h>
+#include <Orchestrator.h>
+
+#include <fmt/core.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#pragma region Helpers
+namespace
+{
+    constexpr ftl_channel_id_t CHANNEL_ID = 1234;
+    constexpr ftl_stream_id_t STREAM_ID = 1;
+
+    /**
+     * @brief
+     *  An Orchestrator running on its own thread with one ingest node and a number of edge
+     *  nodes connected, each subscribed to CHANNEL_ID
+     */
+    class EmbeddedOrchestrator
+    {
+    public:
+        EmbeddedOrchestrator(size_t edgeCount)
+        {
+            auto connectionManager = std::make_unique<InProcessConnectionManager>();
+            InProcessConnectionManager* connectionManagerPtr = connectionManager.get();
+            orchestrator = std::make_unique<Orchestrator<InProcessConnection>>(
+                std::move(connectionManager));
+            orchestrator->Init();
+            std::promise<void> readyPromise;
+            auto ready = readyPromise.get_future();
+            orchestratorThread = std::thread(
+                [this, readyPromise = std::move(readyPromise)]() mutable
+                {
+                    orchestrator->Run(std::move(readyPromise));
+                });
+            ready.wait();
+
+            ingest = connectionManagerPtr->Connect("ingest");
+            ingest->SetOnStreamRelay(
+                [this](ConnectionRelayPayload)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(relayMutex);
+                        ++relayCount;
+                    }
+                    relayConditionVariable.notify_all();
+                    return ConnectionResult { .IsSuccess = true };
+                });
+            ingest->Start();
+            sendIntro(ingest);
+            for (size_t i = 0; i < edgeCount; ++i)
+            {
+                auto edge = connectionManagerPtr->Connect(fmt::format("edge-{}", i));
+                edge->Start();
+                sendIntro(edge);
+                SetSubscribed(edge, true);
+                edges.push_back(edge);
+            }
+
+            // Nodes send from their own threads, so run one cycle to know every subscription
+            // has landed before anything is timed
+            SetPublished(true);
+            WaitForRelays(edges.size());
+            SetPublished(false);
+            WaitForRelays(edges.size());
+        }
+
+        ~EmbeddedOrchestrator()
+        {
+            orchestrator->Stop();
+            orchestratorThread.join();
+            ingest->Stop();
+            for (auto& edge : edges)
+            {
+                edge->Stop();
+            }
+        }
+
+        void SetPublished(bool isPublished)
+        {
+            ingest->SendStreamPublish(ConnectionPublishPayload
+                {
+                    .IsPublish = isPublished,
+                    .ChannelId = CHANNEL_ID,
+                    .StreamId = STREAM_ID,
+                });
+        }
+
+        void SetSubscribed(const std::shared_ptr<InProcessConnection>& edge, bool isSubscribed)
+        {
+            edge->SendChannelSubscription(ConnectionSubscriptionPayload
+                {
+                    .IsSubscribe = isSubscribed,
+                    .ChannelId = CHANNEL_ID,
+                    .StreamKey = std::vector<std::byte>(),
+                });
+        }
+
+        /**
+         * @brief Waits until the ingest has been sent `count` more relay messages
+         */
+        void WaitForRelays(size_t count)
+        {
+            expectedRelayCount += count;
+            std::unique_lock<std::mutex> lock(relayMutex);
+            if (!relayConditionVariable.wait_for(
+                lock,
+                std::chrono::seconds(10),
+                [this]() { return relayCount >= expectedRelayCount; }))
+            {
+                throw std::runtime_error("Timed out waiting for relays");
+            }
+        }
+
+        const std::vector<std::shared_ptr<InProcessConnection>>& GetEdges()
+        {
+            return edges;
+        }
+
+    private:
+        std::unique_ptr<Orchestrator<InProcessConnection>> orchestrator;
+        std::thread orchestratorThread;
+        std::shared_ptr<InProcessConnection> ingest;
+        std::vector<std::shared_ptr<InProcessConnection>> edges;
+        std::mutex relayMutex;
+        std::condition_variable relayConditionVariable;
+        size_t relayCount = 0;
+        size_t expectedRelayCount = 0;
+
+        static void sendIntro(const std::shared_ptr<InProcessConnection>& node)
+        {
+            node->SendIntro(ConnectionIntroPayload
+                {
+                    .VersionMajor = 0,
+                    .VersionMinor = 0,
+                    .VersionRevision = 0,
+                    .RelayLayer = 0,
+                    .RegionCode = "global",
+                    .Hostname = node->GetHostname(),
+                });
+        }
+    };
+}
+#pragma endregion Helpers
+
+#pragma region Orchestration benchmarks
+// Each iteration publishes and unpublishes a stream, waiting for the ingest to be told to start
+// and then stop relaying to every subscriber; the argument is the subscriber count
+ORCHESTRATOR_BENCHMARK("In-process publish/unpublish cycle", 1, 16, 256)(BenchmarkState& state)
+{
+    EmbeddedOrchestrator embedded(static_cast<size_t>(state.Arg()));
+    state.Run([&]()
+        {
+            embedded.SetPublished(true);
+            embedded.WaitForRelays(embedded.GetEdges().size());
+            embedded.SetPublished(false);
+            embedded.WaitForRelays(embedded.GetEdges().size());
+        });
+}
+
+// Each iteration has every edge unsubscribe from and resubscribe to a live stream, waiting for
+// all the resulting relay changes; the argument is the edge count
+ORCHESTRATOR_BENCHMARK("In-process subscription churn", 1, 16, 256)(BenchmarkState& state)
+{
+    EmbeddedOrchestrator embedded(static_cast<size_t>(state.Arg()));
+    embedded.SetPublished(true);
+    embedded.WaitForRelays(embedded.GetEdges().size());
+    state.Run([&]()
+        {
+            for (const auto& edge : embedded.GetEdges())
+            {
+                embedded.SetSubscribed(edge, false);
+                embedded.SetSubscribed(edge, true);
+            }
+            embedded.WaitForRelays(2 * embedded.GetEdges().size());
+        });
+}
+#pragma endregion Orchestration benchmarks
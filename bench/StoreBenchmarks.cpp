@@ -0,0 +1,182 @@
+/**
+ * @file StoreBenchmarks.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ * @brief Microbenchmarks for StreamStore and SubscriptionStore at increasing sizes
+ */
+
+#include "Benchmark.h"
+
+#include "../src/StreamStore.h"
+#include "../src/SubscriptionStore.h"
+#include "../test/mocks/MockConnection.h"
+
+#include <fmt/core.h>
+
+#include <memory>
+#include <vector>
+
+#pragma region Helpers
+namespace
+{
+    // Entries are spread across this many simulated nodes
+    constexpr size_t CONNECTION_COUNT = 1000;
+    // Each channel in the subscription store has this many subscribers
+    constexpr size_t SUBSCRIBERS_PER_CHANNEL = 10;
+    // Step through entries in a scattered order so lookups don't walk memory sequentially
+    constexpr size_t LOOKUP_STRIDE = 7919;
+
+    std::vector<std::shared_ptr<MockConnection>> makeConnections()
+    {
+        std::vector<std::shared_ptr<MockConnection>> connections;
+        for (size_t i = 0; i < CONNECTION_COUNT; ++i)
+        {
+            connections.push_back(std::make_shared<MockConnection>(fmt::format("node-{}", i)));
+        }
+        return connections;
+    }
+
+    /**
+     * @brief Fills a store with `count` streams, one per channel, spread across `connections`
+     */
+    void populateStreams(
+        StreamStore<MockConnection>& store,
+        const std::vector<std::shared_ptr<MockConnection>>& connections,
+        size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            store.AddStream(Stream<MockConnection>
+                {
+                    .IngestConnection = connections.at(i % connections.size()),
+                    .ChannelId = static_cast<ftl_channel_id_t>(i),
+                    .StreamId = static_cast<ftl_stream_id_t>(i),
+                });
+        }
+    }
+
+    /**
+     * @brief
+     *  Fills a store with `count` subscriptions; each channel gets SUBSCRIBERS_PER_CHANNEL
+     *  distinct subscribers.
+     */
+    void populateSubscriptions(
+        SubscriptionStore<MockConnection>& store,
+        const std::vector<std::shared_ptr<MockConnection>>& connections,
+        size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            store.AddSubscription(
+                connections.at(i % connections.size()),
+                static_cast<ftl_channel_id_t>(i / SUBSCRIBERS_PER_CHANNEL),
+                std::vector<std::byte>());
+        }
+    }
+}
+#pragma endregion Helpers
+
+#pragma region StreamStore benchmarks
+ORCHESTRATOR_BENCHMARK("StreamStore::GetStreamByChannelId", 10000, 100000, 1000000)(
+    BenchmarkState& state)
+{
+    auto connections = makeConnections();
+    StreamStore<MockConnection> store;
+    size_t count = static_cast<size_t>(state.Arg());
+    populateStreams(store, connections, count);
+
+    size_t index = 0;
+    state.Run(
+        [&]()
+        {
+            index = ((index + LOOKUP_STRIDE) % count);
+            auto stream = store.GetStreamByChannelId(static_cast<ftl_channel_id_t>(index));
+            DoNotOptimize(stream);
+        });
+}
+
+ORCHESTRATOR_BENCHMARK("StreamStore::AddStream + RemoveStream", 10000, 100000, 1000000)(
+    BenchmarkState& state)
+{
+    auto connections = makeConnections();
+    StreamStore<MockConnection> store;
+    size_t count = static_cast<size_t>(state.Arg());
+    populateStreams(store, connections, count);
+
+    Stream<MockConnection> stream
+    {
+        .IngestConnection = connections.front(),
+        .ChannelId = static_cast<ftl_channel_id_t>(count),
+        .StreamId = static_cast<ftl_stream_id_t>(count),
+    };
+    state.Run(
+        [&]()
+        {
+            store.AddStream(stream);
+            auto removed = store.RemoveStream(stream.ChannelId, stream.StreamId);
+            DoNotOptimize(removed);
+        });
+}
+#pragma endregion StreamStore benchmarks
+
+#pragma region SubscriptionStore benchmarks
+ORCHESTRATOR_BENCHMARK("SubscriptionStore::GetSubscriptions(channel)", 10000, 100000, 1000000)(
+    BenchmarkState& state)
+{
+    auto connections = makeConnections();
+    SubscriptionStore<MockConnection> store;
+    size_t count = static_cast<size_t>(state.Arg());
+    populateSubscriptions(store, connections, count);
+    size_t channelCount = (count / SUBSCRIBERS_PER_CHANNEL);
+
+    size_t index = 0;
+    state.Run(
+        [&]()
+        {
+            index = ((index + LOOKUP_STRIDE) % channelCount);
+            auto subscriptions = store.GetSubscriptions(static_cast<ftl_channel_id_t>(index));
+            DoNotOptimize(subscriptions.data());
+        });
+}
+
+ORCHESTRATOR_BENCHMARK(
+    "SubscriptionStore::GetSubscriptions(connection)", 10000, 100000, 1000000)(
+    BenchmarkState& state)
+{
+    auto connections = makeConnections();
+    SubscriptionStore<MockConnection> store;
+    size_t count = static_cast<size_t>(state.Arg());
+    populateSubscriptions(store, connections, count);
+
+    size_t index = 0;
+    state.Run(
+        [&]()
+        {
+            index = ((index + LOOKUP_STRIDE) % connections.size());
+            auto subscriptions = store.GetSubscriptions(connections.at(index));
+            DoNotOptimize(subscriptions.data());
+        });
+}
+
+ORCHESTRATOR_BENCHMARK(
+    "SubscriptionStore::AddSubscription + RemoveSubscription", 10000, 100000, 1000000)(
+    BenchmarkState& state)
+{
+    auto connections = makeConnections();
+    SubscriptionStore<MockConnection> store;
+    size_t count = static_cast<size_t>(state.Arg());
+    populateSubscriptions(store, connections, count);
+
+    auto connection = connections.front();
+    auto channelId = static_cast<ftl_channel_id_t>(count);
+    std::vector<std::byte> streamKey(32, std::byte{0x7f});
+    state.Run(
+        [&]()
+        {
+            store.AddSubscription(connection, channelId, streamKey);
+            bool removed = store.RemoveSubscription(connection, channelId);
+            DoNotOptimize(removed);
+        });
+}
+#pragma endregion SubscriptionStore benchmarks
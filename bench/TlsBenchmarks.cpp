@@ -0,0 +1,68 @@
+/**
+ * @file TlsBenchmarks.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ * @brief Microbenchmarks for TLS PSK handshakes over a local socket pair
+ */
+
+#include "Benchmark.h"
+
+#include <TlsConnectionTransport.h>
+#include <TlsTransportContext.h>
+
+#include <future>
+#include <sys/socket.h>
+
+#pragma region Helpers
+namespace
+{
+    const std::vector<std::byte> BENCHMARK_PSK(16, std::byte{0x42});
+
+    void handshake(
+        std::shared_ptr<TlsTransportContext> serverContext,
+        std::shared_ptr<TlsTransportContext> clientContext)
+    {
+        int socketHandles[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, socketHandles) != 0)
+        {
+            throw std::runtime_error("Could not create socket pair");
+        }
+        auto server = std::make_shared<TlsConnectionTransport>(
+            serverContext,
+            socketHandles[0],
+            sockaddr_in { 0 });
+        auto client = std::make_shared<TlsConnectionTransport>(
+            clientContext,
+            socketHandles[1],
+            sockaddr_in { 0 });
+        auto serverStarted = std::async(std::launch::async, [server]() { server->StartAsync(); });
+        client->StartAsync();
+        serverStarted.get();
+        client->Stop();
+        server->Stop();
+    }
+}
+#pragma endregion Helpers
+
+#pragma region Handshake benchmarks
+ORCHESTRATOR_BENCHMARK("TLS PSK handshake, shared transport context")(BenchmarkState& state)
+{
+    auto serverContext = std::make_shared<TlsTransportContext>(true /*isServer*/, BENCHMARK_PSK);
+    auto clientContext = std::make_shared<TlsTransportContext>(false /*isServer*/, BENCHMARK_PSK);
+    state.Run([&]() { handshake(serverContext, clientContext); });
+}
+
+ORCHESTRATOR_BENCHMARK("TLS PSK handshake, transport context per connection")(
+    BenchmarkState& state)
+{
+    // Mirrors the cost of building SSL_CTX and PSK session state on every connection
+    state.Run(
+        [&]()
+        {
+            handshake(
+                std::make_shared<TlsTransportContext>(true /*isServer*/, BENCHMARK_PSK),
+                std::make_shared<TlsTransportContext>(false /*isServer*/, BENCHMARK_PSK));
+        });
+}
+#pragma endregion Handshake benchmarks
@@ -0,0 +1,214 @@
+/**
+ * @file TransportBenchmarks.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ * @brief Echo benchmarks comparing the poll, io_uring and Unix socket server transports
+ */
+
+#include "Benchmark.h"
+
+#include <IoUringEventLoop.h>
+#include <IoUringTlsConnectionTransport.h>
+#include <TlsConnectionTransport.h>
+#include <TlsTransportContext.h>
+#include <UnixConnectionTransport.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <sys/socket.h>
+
+#pragma region Helpers
+namespace
+{
+    const std::vector<std::byte> BENCHMARK_PSK(16, std::byte{0x42});
+    constexpr size_t MESSAGE_SIZE = 64;
+
+    enum class EchoTransport
+    {
+        // TLS, with the server on TlsConnectionTransport
+        TlsPoll,
+        // TLS, with the server on IoUringTlsConnectionTransport
+        TlsIoUring,
+        // Plaintext UnixConnectionTransport on both ends
+        Unix,
+    };
+
+    /**
+     * @brief
+     *  A set of connections over local socket pairs whose server ends echo everything they
+     *  receive. TLS clients always use TlsConnectionTransport so only the server side differs.
+     */
+    class EchoConnections
+    {
+    public:
+        EchoConnections(size_t connectionCount, EchoTransport transport)
+        {
+            auto serverContext = std::make_shared<TlsTransportContext>(
+                true /*isServer*/,
+                BENCHMARK_PSK);
+            auto clientContext = std::make_shared<TlsTransportContext>(
+                false /*isServer*/,
+                BENCHMARK_PSK);
+            if (transport == EchoTransport::TlsIoUring)
+            {
+                eventLoop = std::make_shared<IoUringEventLoop>();
+                eventLoop->Start();
+            }
+
+            for (size_t i = 0; i < connectionCount; ++i)
+            {
+                int socketHandles[2];
+                if (socketpair(AF_UNIX, SOCK_STREAM, 0, socketHandles) != 0)
+                {
+                    throw std::runtime_error("Could not create socket pair");
+                }
+
+                std::shared_ptr<IConnectionTransport> server;
+                std::shared_ptr<IConnectionTransport> client;
+                if (transport == EchoTransport::Unix)
+                {
+                    server = std::make_shared<UnixConnectionTransport>(socketHandles[0]);
+                    client = std::make_shared<UnixConnectionTransport>(socketHandles[1]);
+                }
+                else if (eventLoop)
+                {
+                    server = std::make_shared<IoUringTlsConnectionTransport>(
+                        eventLoop,
+                        serverContext,
+                        socketHandles[0],
+                        sockaddr_in { 0 });
+                }
+                else
+                {
+                    server = std::make_shared<TlsConnectionTransport>(
+                        serverContext,
+                        socketHandles[0],
+                        sockaddr_in { 0 });
+                }
+                if (!client)
+                {
+                    client = std::make_shared<TlsConnectionTransport>(
+                        clientContext,
+                        socketHandles[1],
+                        sockaddr_in { 0 });
+                }
+                IConnectionTransport* serverPtr = server.get();
+                server->SetOnBytesReceived(
+                    [serverPtr](const std::vector<std::byte>& bytes) { serverPtr->Write(bytes); });
+
+                client->SetOnBytesReceived(
+                    [this](const std::vector<std::byte>& bytes)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(receivedMutex);
+                            receivedBytes += bytes.size();
+                        }
+                        receivedConditionVariable.notify_all();
+                    });
+
+                server->StartAsync();
+                client->StartAsync();
+                servers.push_back(server);
+                clients.push_back(client);
+            }
+        }
+
+        ~EchoConnections()
+        {
+            for (auto& client : clients)
+            {
+                client->Stop();
+            }
+            for (auto& server : servers)
+            {
+                server->Stop();
+            }
+            if (eventLoop)
+            {
+                eventLoop->Stop();
+            }
+        }
+
+        /**
+         * @brief Writes messageCount messages on every connection and waits for all the echoes
+         */
+        void RoundTrip(size_t messageCount)
+        {
+            const std::vector<std::byte> message(MESSAGE_SIZE, std::byte{0x5a});
+            for (size_t i = 0; i < messageCount; ++i)
+            {
+                for (auto& client : clients)
+                {
+                    client->Write(message);
+                }
+            }
+            expectedBytes += (messageCount * MESSAGE_SIZE * clients.size());
+
+            std::unique_lock<std::mutex> lock(receivedMutex);
+            if (!receivedConditionVariable.wait_for(
+                lock,
+                std::chrono::seconds(10),
+                [this]() { return receivedBytes >= expectedBytes; }))
+            {
+                throw std::runtime_error("Timed out waiting for echoes");
+            }
+        }
+
+    private:
+        std::shared_ptr<IoUringEventLoop> eventLoop;
+        std::vector<std::shared_ptr<IConnectionTransport>> servers;
+        std::vector<std::shared_ptr<IConnectionTransport>> clients;
+        std::mutex receivedMutex;
+        std::condition_variable receivedConditionVariable;
+        size_t receivedBytes = 0;
+        size_t expectedBytes = 0;
+    };
+
+    void runEcho(BenchmarkState& state, EchoTransport transport, size_t messageCount)
+    {
+        if ((transport == EchoTransport::TlsIoUring) && !IoUringEventLoop::IsSupported())
+        {
+            throw std::runtime_error("io_uring is not supported on this kernel");
+        }
+        EchoConnections connections(static_cast<size_t>(state.Arg()), transport);
+        state.Run([&]() { connections.RoundTrip(messageCount); });
+    }
+}
+#pragma endregion Helpers
+
+#pragma region Echo benchmarks
+// Each iteration writes to every connection and waits until all of them have echoed back;
+// the argument is the connection count
+ORCHESTRATOR_BENCHMARK("TLS echo round trip, poll server", 1, 16, 64)(BenchmarkState& state)
+{
+    runEcho(state, EchoTransport::TlsPoll, 1);
+}
+
+ORCHESTRATOR_BENCHMARK("TLS echo round trip, io_uring server", 1, 16, 64)(BenchmarkState& state)
+{
+    runEcho(state, EchoTransport::TlsIoUring, 1);
+}
+
+ORCHESTRATOR_BENCHMARK("TLS echo 256 message burst, poll server", 1, 16, 64)(
+    BenchmarkState& state)
+{
+    runEcho(state, EchoTransport::TlsPoll, 256);
+}
+
+ORCHESTRATOR_BENCHMARK("TLS echo 256 message burst, io_uring server", 1, 16, 64)(
+    BenchmarkState& state)
+{
+    runEcho(state, EchoTransport::TlsIoUring, 256);
+}
+
+ORCHESTRATOR_BENCHMARK("Unix echo round trip", 1, 16, 64)(BenchmarkState& state)
+{
+    runEcho(state, EchoTransport::Unix, 1);
+}
+
+ORCHESTRATOR_BENCHMARK("Unix echo 256 message burst", 1, 16, 64)(BenchmarkState& state)
+{
+    runEcho(state, EchoTransport::Unix, 256);
+}
+#pragma endregion Echo benchmarks
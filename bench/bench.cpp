@@ -0,0 +1,149 @@
+/**
+ * @file bench.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ * @brief Entrypoint for the microbenchmark suite
+ */
+
+#include "Benchmark.h"
+
+#include <spdlog/spdlog.h>
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <signal.h>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    const char* USAGE = 
+        "Usage: janus-ftl-orchestrator-bench [--option=value ...]\n"
+        "  --filter=<text>         only run benchmarks whose name contains this text\n"
+        "  --min-time-ms=100       minimum duration of each timed sample\n"
+        "  --output=<path>         write JSON results to a file instead of stdout\n";
+
+    std::string jsonEscape(const std::string& value)
+    {
+        std::stringstream escaped;
+        for (char c : value)
+        {
+            switch (c)
+            {
+            case '"':
+                escaped << "\\\"";
+                break;
+            case '\\':
+                escaped << "\\\\";
+                break;
+            default:
+                escaped << c;
+                break;
+            }
+        }
+        return escaped.str();
+    }
+
+    void writeJson(std::ostream& out, const std::vector<BenchmarkResult>& results)
+    {
+        out << std::fixed << std::setprecision(3);
+        out << "{\n  \"benchmarks\": [\n";
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const auto& result = results.at(i);
+            out << "    {"
+                << "\"name\": \"" << jsonEscape(result.Name) << "\", "
+                << "\"arg\": " << result.Arg << ", "
+                << "\"iterations\": " << result.Iterations << ", "
+                << "\"ns_per_op_min\": " << result.NsPerOpMin << ", "
+                << "\"ns_per_op_median\": " << result.NsPerOpMedian << ", "
+                << "\"ns_per_op_mean\": " << result.NsPerOpMean
+                << "}" << (((i + 1) < results.size()) ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::map<std::string, std::string> options;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg(argv[i]);
+        size_t separator = arg.find('=');
+        if ((arg.rfind("--", 0) != 0) || (separator == std::string::npos))
+        {
+            std::cerr << USAGE;
+            return 1;
+        }
+        options[arg.substr(2, separator - 2)] = arg.substr(separator + 1);
+    }
+
+    std::string filter;
+    std::string outputPath;
+    std::chrono::milliseconds minSampleTime(100);
+    try
+    {
+        for (const auto& [name, value] : options)
+        {
+            if (name == "filter") filter = value;
+            else if (name == "output") outputPath = value;
+            else if (name == "min-time-ms") minSampleTime = std::chrono::milliseconds(std::stoi(value));
+            else
+            {
+                std::cerr << "Unknown option --" << name << "\n" << USAGE;
+                return 1;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Invalid option value: " << e.what() << "\n" << USAGE;
+        return 1;
+    }
+
+    // TLS benchmarks tear down both ends of a socket pair; a write racing the peer's close
+    // should fail the write rather than kill the process
+    signal(SIGPIPE, SIG_IGN);
+
+    // Keep the code under test from logging into our measurements
+    spdlog::set_level(spdlog::level::off);
+
+    std::vector<BenchmarkResult> results;
+    for (const auto& entry : BenchmarkRegistry::All())
+    {
+        if (!filter.empty() && (entry.Name.find(filter) == std::string::npos))
+        {
+            continue;
+        }
+        std::vector<int64_t> args = entry.Args.empty() ? std::vector<int64_t>{ 0 } : entry.Args;
+        for (const auto& arg : args)
+        {
+            std::cerr << entry.Name << " [" << arg << "]... " << std::flush;
+            BenchmarkState state(entry.Name, arg, minSampleTime);
+            entry.Body(state);
+            results.push_back(state.GetResult());
+            std::cerr << std::fixed << std::setprecision(1)
+                << state.GetResult().NsPerOpMedian << " ns/op\n";
+        }
+    }
+
+    if (outputPath.empty())
+    {
+        writeJson(std::cout, results);
+    }
+    else
+    {
+        std::ofstream outputFile(outputPath);
+        if (!outputFile)
+        {
+            std::cerr << "Could not open " << outputPath << " for writing\n";
+            return 1;
+        }
+        writeJson(outputFile, results);
+    }
+    return 0;
+}
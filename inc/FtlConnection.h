@@ -10,17 +10,36 @@
 #include "FtlTypes.h"
 #include "IConnection.h"
 #include "IConnectionTransport.h"
+#include "Metrics.h"
 #include "OrchestrationProtocolTypes.h"
 
+#include <array>
 #include <atomic>
 #include <bit>
+#include <chrono>
 #include <functional>
 #include <future>
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <spdlog/spdlog.h>
 #include <thread>
 
+/**
+ * @brief Limits on how much FtlConnection lets pile up for a peer that isn't keeping up
+ */
+struct FtlConnectionWriteLimits
+{
+    // Once the transport has this many bytes waiting, further messages are held back
+    size_t HighWatermark = 256 * 1024;
+    // Held back messages are released once the transport drains to this many bytes
+    size_t LowWatermark = 64 * 1024;
+    // Holding back more messages than this overflows the connection
+    size_t MaxQueuedMessages = 4096;
+};
+
 /**
  * @brief
  *  FtlConnection translates FTL Orchestration Protocol binary data to/from an IConnectionTransport
@@ -33,11 +52,18 @@ public:
     /* Constructor/Destructor */
     FtlConnection(
         std::shared_ptr<IConnectionTransport> transport,
-        std::string hostname = std::string()) : 
+        std::string hostname = std::string(),
+        FtlConnectionWriteLimits writeLimits = FtlConnectionWriteLimits()) : 
         transport(transport),
+        writeLimits(writeLimits),
         hostname(hostname)
     { }
 
+    ~FtlConnection()
+    {
+        queuedMessageCount() -= queuedMessages.size();
+    }
+
     /* Static methods */
     /**
      * @brief Attempts to parse an Orchestration Protocol Message Header out of the given bytes
@@ -251,6 +277,8 @@ public:
                 this,
                 std::placeholders::_1));
         transport->SetOnConnectionClosed(std::bind(&FtlConnection::onTransportConnectionClosed, this));
+        transport->SetOnWriteProgress(
+            std::bind(&FtlConnection::onTransportWriteProgress, this, std::placeholders::_1));
 
         // Start the transport thread
         transport->StartAsync();
@@ -416,6 +444,47 @@ public:
             .MessagePayloadLength = static_cast<uint16_t>(messagePayload.size()),
         };
 
+        RelayRoute route
+        {
+            .ChannelId = payload.ChannelId,
+            .StreamId = payload.StreamId,
+            .TargetHostname = payload.TargetHostname,
+        };
+        sendMessage(header, messagePayload, &route, payload.IsStartRelay);
+    }
+
+    void SendPing() override
+    {
+        OrchestrationMessageHeader header
+        {
+            .MessageDirection = OrchestrationMessageDirectionKind::Request,
+            .MessageFailure = false,
+            .MessageType = OrchestrationMessageType::Ping,
+            .MessageId = nextOutgoingMessageId++,
+            .MessagePayloadLength = 0,
+        };
+
+        sendMessage(header, std::vector<std::byte>());
+    }
+
+    void SendStateReplication(const ConnectionReplicationPayload& payload) override
+    {
+        std::vector<std::byte> messagePayload
+        {
+            static_cast<std::byte>(payload.IsSubscribe),
+        };
+        messagePayload.reserve(1 + payload.Events.size());
+        messagePayload.insert(messagePayload.end(), payload.Events.begin(), payload.Events.end());
+
+        OrchestrationMessageHeader header
+        {
+            .MessageDirection = OrchestrationMessageDirectionKind::Request,
+            .MessageFailure = false,
+            .MessageType = OrchestrationMessageType::StateReplication,
+            .MessageId = nextOutgoingMessageId++,
+            .MessagePayloadLength = static_cast<uint16_t>(messagePayload.size()),
+        };
+
         sendMessage(header, messagePayload);
     }
 
@@ -454,6 +523,16 @@ public:
         this->onStreamRelay = onStreamRelay;
     }
 
+    void SetOnStateReplication(connection_cb_replication_t onStateReplication) override
+    {
+        this->onStateReplication = onStateReplication;
+    }
+
+    void SetOnWriteStateChanged(connection_cb_write_state_t onWriteStateChanged) override
+    {
+        this->onWriteStateChanged = onWriteStateChanged;
+    }
+
     std::string GetHostname() override
     {
         return hostname;
@@ -464,8 +543,55 @@ public:
         this->hostname = hostname;
     }
 
+    std::chrono::steady_clock::time_point GetLastActivityTime() override
+    {
+        return std::chrono::steady_clock::time_point(
+            std::chrono::steady_clock::duration(lastActivityTicks.load(std::memory_order_relaxed)));
+    }
+
+    /* Public methods */
+    ConnectionWriteState GetWriteState()
+    {
+        return writeState;
+    }
+
+    /**
+     * @brief Number of messages being held back until the peer catches up
+     */
+    size_t GetQueuedMessageCount()
+    {
+        std::lock_guard<std::mutex> lock(outboundMutex);
+        return queuedMessages.size();
+    }
+
 private:
+    /* Private types */
+    /**
+     * @brief Identifies the route a Stream Relay message starts or stops
+     */
+    struct RelayRoute
+    {
+        ftl_channel_id_t ChannelId;
+        ftl_stream_id_t StreamId;
+        std::string TargetHostname;
+
+        auto operator<=>(const RelayRoute&) const = default;
+    };
+
+    /**
+     * @brief A serialized message held back while the peer catches up
+     */
+    struct QueuedMessage
+    {
+        OrchestrationMessageType MessageType;
+        std::vector<std::byte> Bytes;
+        // Set for relay starts, which a later stop for the same route cancels out
+        std::optional<RelayRoute> StartedRoute;
+    };
+
+    /* Private members */
     std::shared_ptr<IConnectionTransport> transport;
+    const FtlConnectionWriteLimits writeLimits;
     std::vector<std::byte> transportReadBuffer;
     std::optional<OrchestrationMessageHeader> parsedTransportMessageHeader;
     std::function<void(void)> onConnectionClosed;
@@ -475,8 +601,131 @@ private:
     connection_cb_subscription_t onChannelSubscription;
     connection_cb_publishing_t onStreamPublish;
     connection_cb_relay_t onStreamRelay;
+    connection_cb_replication_t onStateReplication;
     std::string hostname;
     std::atomic<uint8_t> nextOutgoingMessageId { 0 };
+    // Guards everything below that's written to the transport, so held back messages go out in
+    // order ahead of new ones
+    std::mutex outboundMutex;
+    std::atomic<ConnectionWriteState> writeState { ConnectionWriteState::Flowing };
+    std::list<QueuedMessage> queuedMessages;
+    std::map<RelayRoute, std::list<QueuedMessage>::iterator> queuedRelayStarts;
+    connection_cb_write_state_t onWriteStateChanged;
+    // Read by heartbeats from other threads, so kept as a plain tick count
+    std::atomic<std::chrono::steady_clock::rep> lastActivityTicks {
+        std::chrono::steady_clock::now().time_since_epoch().count() };
+
+    /* Private static methods */
+    /**
+     * @brief Metrics tracked for each message type
+     */
+    struct MessageTypeMetrics
+    {
+        MetricCounter* Received;
+        MetricCounter* Sent;
+        MetricHistogram* HandlerDuration;
+    };
+
+    /**
+     * @brief Looks up the metrics for a message type. Registration only happens on first use.
+     */
+    static const MessageTypeMetrics& messageTypeMetrics(OrchestrationMessageType type)
+    {
+        static const std::array<MessageTypeMetrics, 64> allMessageTypeMetrics = 
+            []()
+            {
+                std::array<MessageTypeMetrics, 64> returnVal;
+                auto& registry = MetricsRegistry::Default();
+                for (size_t i = 0; i < returnVal.size(); ++i)
+                {
+                    std::string labels = fmt::format("type=\"{}\"", 
+                        messageTypeName(static_cast<OrchestrationMessageType>(i)));
+                    returnVal[i] = MessageTypeMetrics
+                    {
+                        .Received = &registry.GetCounter(
+                            "ftl_orchestrator_messages_received_total",
+                            "Orchestration protocol messages received",
+                            labels),
+                        .Sent = &registry.GetCounter(
+                            "ftl_orchestrator_messages_sent_total",
+                            "Orchestration protocol messages sent",
+                            labels),
+                        .HandlerDuration = &registry.GetHistogram(
+                            "ftl_orchestrator_message_handler_duration_seconds",
+                            "Time spent handling a received request, including callbacks",
+                            labels,
+                            1e-9),
+                    };
+                }
+                return returnVal;
+            }();
+        return allMessageTypeMetrics[static_cast<uint8_t>(type) & 0b00111111];
+    }
+
+    /**
+     * @brief Returns a short, label-friendly name for a message type
+     */
+    static std::string messageTypeName(OrchestrationMessageType type)
+    {
+        switch (type)
+        {
+        case OrchestrationMessageType::Intro:
+            return "intro";
+        case OrchestrationMessageType::Outro:
+            return "outro";
+        case OrchestrationMessageType::NodeState:
+            return "node_state";
+        case OrchestrationMessageType::Ping:
+            return "ping";
+        case OrchestrationMessageType::StateReplication:
+            return "state_replication";
+        case OrchestrationMessageType::ChannelSubscription:
+            return "channel_subscription";
+        case OrchestrationMessageType::StreamPublish:
+            return "stream_publish";
+        case OrchestrationMessageType::StreamRelay:
+            return "stream_relay";
+        default:
+            return std::to_string(static_cast<uint8_t>(type));
+        }
+    }
+
+    static MetricCounter& bytesReceivedCounter()
+    {
+        static MetricCounter& counter = MetricsRegistry::Default().GetCounter(
+            "ftl_orchestrator_received_bytes_total",
+            "Orchestration protocol bytes received from transports");
+        return counter;
+    }
+
+    static MetricCounter& bytesSentCounter()
+    {
+        static MetricCounter& counter = MetricsRegistry::Default().GetCounter(
+            "ftl_orchestrator_sent_bytes_total",
+            "Orchestration protocol bytes written to transports");
+        return counter;
+    }
+
+    static MetricCounter& coalescedRelaysCounter()
+    {
+        static MetricCounter& counter = MetricsRegistry::Default().GetCounter(
+            "ftl_orchestrator_coalesced_relay_messages_total",
+            "Stream Relay messages dropped or merged while held back from a backed up peer");
+        return counter;
+    }
+
+    /**
+     * @brief Messages held back across every connection, exported as a gauge
+     */
+    static std::atomic<size_t>& queuedMessageCount()
+    {
+        static std::atomic<size_t> count { 0 };
+        static MetricsRegistry::GaugeHandle gauge = MetricsRegistry::Default().AddGauge(
+            "ftl_orchestrator_outbound_queued_messages",
+            "Messages held back from peers that aren't keeping up with them",
+            []() { return static_cast<double>(count.load()); });
+        return count;
+    }
 
     /* Private methods */
     /**
@@ -485,8 +734,16 @@ private:
      */
     void onTransportBytesReceived(const std::vector<std::byte>& bytes)
     {
+        bytesReceivedCounter().Increment(bytes.size());
+        lastActivityTicks.store(
+            std::chrono::steady_clock::now().time_since_epoch().count(),
+            std::memory_order_relaxed);
+
         // Add received bytes to our buffer
-        spdlog::debug("{} received {} bytes ...", GetHostname(), bytes.size());
+        if (spdlog::should_log(spdlog::level::debug))
+        {
+            spdlog::debug("{} received {} bytes ...", hostname, bytes.size());
+        }
         transportReadBuffer.insert(transportReadBuffer.end(), bytes.begin(), bytes.end());
 
         while (true)
@@ -542,6 +799,43 @@ private:
         }
     }
 
+    /**
+     * @brief
+     *  Called from the transport's thread as writes drain. Releases held back messages once the
+     *  backlog is down to the low watermark.
+     * @param pendingWriteSize bytes the transport still has waiting
+     */
+    void onTransportWriteProgress(size_t pendingWriteSize)
+    {
+        if ((writeState != ConnectionWriteState::BackedUp) ||
+            (pendingWriteSize > writeLimits.LowWatermark))
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(outboundMutex);
+        if (writeState != ConnectionWriteState::BackedUp)
+        {
+            return;
+        }
+        while (!queuedMessages.empty() &&
+            (transport->GetPendingWriteSize() < writeLimits.HighWatermark))
+        {
+            QueuedMessage& message = queuedMessages.front();
+            if (message.StartedRoute)
+            {
+                queuedRelayStarts.erase(message.StartedRoute.value());
+            }
+            writeToTransport(message.MessageType, message.Bytes);
+            queuedMessages.pop_front();
+            --queuedMessageCount();
+        }
+        if (queuedMessages.empty())
+        {
+            setWriteState(ConnectionWriteState::Flowing);
+        }
+    }
+
     /**
      * @brief Processes an Orchestration Protocol Message with a payload.
      * @param header the parsed header
@@ -551,12 +845,15 @@ private:
         const OrchestrationMessageHeader& header,
         const std::vector<std::byte>& payload)
     {
+        const MessageTypeMetrics& metrics = messageTypeMetrics(header.MessageType);
+        metrics.Received->Increment();
         if (header.MessageDirection == OrchestrationMessageDirectionKind::Response)
         {
             // TODO: We don't handle responses yet.
             return;
         }
 
+        auto handlerStartTime = std::chrono::steady_clock::now();
         switch (header.MessageType)
         {
         case OrchestrationMessageType::Intro:
@@ -568,6 +865,12 @@ private:
         case OrchestrationMessageType::NodeState:
             processNodeStateMessage(header, payload);
             break;
+        case OrchestrationMessageType::Ping:
+            processPingMessage(header, payload);
+            break;
+        case OrchestrationMessageType::StateReplication:
+            processStateReplicationMessage(header, payload);
+            break;
         case OrchestrationMessageType::ChannelSubscription:
             processChannelSubscriptionMessage(header, payload);
             break;
@@ -580,6 +883,7 @@ private:
         default:
             break;
         }
+        metrics.HandlerDuration->RecordSince(handlerStartTime);
     }
 
     /**
@@ -739,6 +1043,65 @@ private:
         sendMessage(responseHeader, std::vector<std::byte>());
     }
 
+    /**
+     * @brief Process Orchestration Protocol Message of type Ping
+     */
+    void processPingMessage(
+        const OrchestrationMessageHeader& header,
+        const std::vector<std::byte>& payload)
+    {
+        // Answered here rather than by a callback, so pings never wait on orchestration logic
+        OrchestrationMessageHeader responseHeader
+        {
+            .MessageDirection = OrchestrationMessageDirectionKind::Response,
+            .MessageFailure = false,
+            .MessageType = OrchestrationMessageType::Ping,
+            .MessageId = header.MessageId,
+            .MessagePayloadLength = static_cast<uint16_t>(payload.size()),
+        };
+        sendMessage(responseHeader, payload);
+    }
+
+    /**
+     * @brief Process Orchestration Protocol Message of type State Replication
+     */
+    void processStateReplicationMessage(
+        const OrchestrationMessageHeader& header,
+        const std::vector<std::byte>& payload)
+    {
+        if (payload.size() < 1)
+        {
+            throw std::range_error("State replication payload is too small.");
+        }
+
+        ConnectionReplicationPayload replicationPayload
+        {
+            .IsSubscribe = (static_cast<uint8_t>(payload.at(0)) == 1),
+            .Events = std::vector<std::byte>((payload.cbegin() + 1), payload.cend()),
+        };
+
+        // Indicate that we received state replication
+        ConnectionResult result
+        {
+            .IsSuccess = false
+        };
+        if (onStateReplication)
+        {
+            result = onStateReplication(std::move(replicationPayload));
+        }
+
+        // Send a response
+        OrchestrationMessageHeader responseHeader
+        {
+            .MessageDirection = OrchestrationMessageDirectionKind::Response,
+            .MessageFailure = !result.IsSuccess,
+            .MessageType = OrchestrationMessageType::StateReplication,
+            .MessageId = header.MessageId,
+            .MessagePayloadLength = 0,
+        };
+        sendMessage(responseHeader, std::vector<std::byte>());
+    }
+
     /**
      * @brief Process Orchestration Protocol Message of type Channel Subscription
      */
@@ -892,7 +1255,9 @@ private:
      */
     void sendMessage(
         const OrchestrationMessageHeader& header,
-        const std::vector<std::byte>& payload)
+        const std::vector<std::byte>& payload,
+        const RelayRoute* relayRoute = nullptr,
+        bool isStartRelay = false)
     {
         std::vector<std::byte> sendBuffer = SerializeMessageHeader(header);
         sendBuffer.reserve(4 + payload.size());
@@ -900,7 +1265,102 @@ private:
         // Append payload
         sendBuffer.insert(sendBuffer.end(), payload.begin(), payload.end());
 
-        // Send it!
-        transport->Write(sendBuffer);
+        std::lock_guard<std::mutex> lock(outboundMutex);
+        switch (writeState)
+        {
+        case ConnectionWriteState::Flowing:
+            // Send it!
+            writeToTransport(header.MessageType, sendBuffer);
+            if (transport->GetPendingWriteSize() >= writeLimits.HighWatermark)
+            {
+                setWriteState(ConnectionWriteState::BackedUp);
+            }
+            break;
+        case ConnectionWriteState::BackedUp:
+            queueMessage(header.MessageType, std::move(sendBuffer), relayRoute, isStartRelay);
+            break;
+        case ConnectionWriteState::Overflowed:
+            // This connection is on its way out
+            break;
+        }
+    }
+
+    /**
+     * @brief
+     *  Holds back a message until the peer catches up. Relay messages for a route that already
+     *  has a start held back are merged into it, since the peer never heard about that start.
+     *  Caller must hold outboundMutex.
+     */
+    void queueMessage(
+        OrchestrationMessageType messageType,
+        std::vector<std::byte>&& bytes,
+        const RelayRoute* relayRoute,
+        bool isStartRelay)
+    {
+        if (relayRoute != nullptr)
+        {
+            auto queuedStartIt = queuedRelayStarts.find(*relayRoute);
+            if (queuedStartIt != queuedRelayStarts.end())
+            {
+                if (isStartRelay)
+                {
+                    // Restarted before the first start went out; only the latest matters
+                    queuedStartIt->second->Bytes = std::move(bytes);
+                    coalescedRelaysCounter().Increment();
+                }
+                else
+                {
+                    // Stopped before it was ever started
+                    queuedMessages.erase(queuedStartIt->second);
+                    queuedRelayStarts.erase(queuedStartIt);
+                    --queuedMessageCount();
+                    coalescedRelaysCounter().Increment(2);
+                }
+                return;
+            }
+        }
+
+        queuedMessages.push_back(QueuedMessage
+            {
+                .MessageType = messageType,
+                .Bytes = std::move(bytes),
+            });
+        ++queuedMessageCount();
+        if ((relayRoute != nullptr) && isStartRelay)
+        {
+            queuedMessages.back().StartedRoute = *relayRoute;
+            queuedRelayStarts.emplace(*relayRoute, std::prev(queuedMessages.end()));
+        }
+
+        if (queuedMessages.size() > writeLimits.MaxQueuedMessages)
+        {
+            spdlog::error(
+                "{} has {} messages waiting to be sent; giving up on it",
+                hostname,
+                queuedMessages.size());
+            setWriteState(ConnectionWriteState::Overflowed);
+        }
+    }
+
+    /**
+     * @brief Hands a serialized message to the transport. Caller must hold outboundMutex.
+     */
+    void writeToTransport(OrchestrationMessageType messageType, const std::vector<std::byte>& bytes)
+    {
+        messageTypeMetrics(messageType).Sent->Increment();
+        bytesSentCounter().Increment(bytes.size());
+        transport->Write(bytes);
+    }
+
+    /**
+     * @brief Caller must hold outboundMutex.
+     */
+    void setWriteState(ConnectionWriteState newWriteState)
+    {
+        writeState = newWriteState;
+        if (onWriteStateChanged)
+        {
+            onWriteStateChanged(newWriteState);
+        }
     }
 };
\ No newline at end of file
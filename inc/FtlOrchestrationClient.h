@@ -9,8 +9,10 @@
 
 #include "FtlConnection.h"
 #include "TlsConnectionTransport.h"
+#include "UnixConnectionTransport.h"
 
 #include <arpa/inet.h>
+#include <cstring>
 #include <netdb.h>
 #include <openssl/ssl.h>
 #include <openssl/err.h>
@@ -19,6 +21,7 @@
 #include <string>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/un.h>
 
 /**
  * @brief
@@ -29,17 +32,42 @@
 class FtlOrchestrationClient
 {
 public:
+    /**
+     * @brief Builds a client TLS context that can be shared between many Connect() calls
+     */
+    static std::shared_ptr<TlsTransportContext> CreateTransportContext(
+        std::vector<std::byte> preSharedKey)
+    {
+        // Load SSL stuff
+        SSL_load_error_strings();
+        SSL_library_init();
+        OpenSSL_add_all_algorithms();
+
+        return std::make_shared<TlsTransportContext>(false /*isServer*/, preSharedKey);
+    }
+
     static std::shared_ptr<FtlConnection> Connect(
         std::string targetHostname,
         std::vector<std::byte> preSharedKey,
         std::string myHostname = std::string(),
         uint16_t targetPort = DEFAULT_PORT)
     {
-        // Load SSL stuff
-        SSL_load_error_strings();
-        SSL_library_init();
-        OpenSSL_add_all_algorithms();
+        return Connect(
+            targetHostname,
+            CreateTransportContext(preSharedKey),
+            myHostname,
+            targetPort);
+    }
 
+    /**
+     * @brief Connects using an existing transport context, skipping per-connection TLS setup
+     */
+    static std::shared_ptr<FtlConnection> Connect(
+        std::string targetHostname,
+        std::shared_ptr<TlsTransportContext> transportContext,
+        std::string myHostname = std::string(),
+        uint16_t targetPort = DEFAULT_PORT)
+    {
         // Look up hostname
         addrinfo addrHints { 0 };
         addrHints.ai_family = AF_INET; // TODO: IPV6 support
@@ -69,10 +97,9 @@ public:
         // Fire up a TlsConnectionTransport to handle TLS on this socket
         std::shared_ptr<TlsConnectionTransport> transport = 
             std::make_shared<TlsConnectionTransport>(
-                false /*isServer*/,
+                transportContext,
                 socketHandle,
-                *(reinterpret_cast<sockaddr_in*>(targetAddr.ai_addr)),
-                preSharedKey);
+                *(reinterpret_cast<sockaddr_in*>(targetAddr.ai_addr)));
 
         // We're done with this by now
         freeaddrinfo(addrLookup);
@@ -83,6 +110,41 @@ public:
         return ftlConnection;
     }
 
+    /**
+     * @brief
+     *  Connects over the orchestration service's Unix domain socket, for nodes running on the
+     *  same host. No pre-shared key is needed; the service checks which user we run as.
+     */
+    static std::shared_ptr<FtlConnection> ConnectUnix(
+        std::string socketPath,
+        std::string myHostname = std::string())
+    {
+        sockaddr_un targetAddr { };
+        targetAddr.sun_family = AF_UNIX;
+        if (socketPath.size() >= sizeof(targetAddr.sun_path))
+        {
+            throw std::invalid_argument("Unix socket path is too long");
+        }
+        strncpy(targetAddr.sun_path, socketPath.c_str(), (sizeof(targetAddr.sun_path) - 1));
+
+        int socketHandle = socket(AF_UNIX, (SOCK_STREAM | SOCK_CLOEXEC), 0);
+        if (socketHandle < 0)
+        {
+            throw std::runtime_error("Could not create Unix socket");
+        }
+        if (connect(
+            socketHandle,
+            reinterpret_cast<const sockaddr*>(&targetAddr),
+            sizeof(targetAddr)) != 0)
+        {
+            close(socketHandle);
+            throw std::runtime_error("Could not connect to Orchestration service on given socket");
+        }
+
+        auto transport = std::make_shared<UnixConnectionTransport>(socketHandle);
+        return std::make_shared<FtlConnection>(transport, myHostname);
+    }
+
 private:
     static constexpr in_port_t DEFAULT_PORT = 8085;
 };
\ No newline at end of file
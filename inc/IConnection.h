@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 #include <functional>
 #include <string>
@@ -79,6 +80,27 @@ struct ConnectionRelayPayload
     std::vector<std::byte> StreamKey;
 };
 
+struct ConnectionReplicationPayload
+{
+    // Set when a standby asks to be sent state, unset on the state itself
+    bool IsSubscribe;
+    // Encoded journal events (see JournalEvent), applied in order
+    std::vector<std::byte> Events;
+};
+
+/**
+ * @brief How well a connection is keeping up with the messages sent to it
+ */
+enum class ConnectionWriteState
+{
+    // Messages go straight out
+    Flowing,
+    // The peer has fallen behind; messages are held back until it catches up
+    BackedUp,
+    // Too many messages are being held back; the connection should be closed
+    Overflowed,
+};
+
 /* Callback types */
 typedef 
     std::function<ConnectionResult(ConnectionIntroPayload)>
@@ -98,6 +120,12 @@ typedef
 typedef
     std::function<ConnectionResult(ConnectionRelayPayload)>
     connection_cb_relay_t;
+typedef
+    std::function<ConnectionResult(ConnectionReplicationPayload)>
+    connection_cb_replication_t;
+typedef
+    std::function<void(ConnectionWriteState)>
+    connection_cb_write_state_t;
 
 /**
  * @brief
@@ -162,6 +190,21 @@ public:
      */
     virtual void SendStreamRelay(const ConnectionRelayPayload& payload) = 0;
 
+    /**
+     * @brief
+     *  Sends a ping, which the other end answers straight away. Used to check that an otherwise
+     *  quiet connection is still alive.
+     */
+    virtual void SendPing() = 0;
+
+    /**
+     * @brief
+     *  Sends a state replication message, used by a standby orchestrator to subscribe to the
+     *  primary's state and by the primary to stream state changes to it
+     * @param payload payload with the subscription or encoded state changes
+     */
+    virtual void SendStateReplication(const ConnectionReplicationPayload& payload) = 0;
+
     /**
      * @brief
      *  Sets the callback that will fire when this connection has been closed.
@@ -211,6 +254,21 @@ public:
      */
     virtual void SetOnStreamRelay(connection_cb_relay_t onStreamRelay) = 0;
 
+    /**
+     * @brief
+     *  Sets the callback that will fire when this connection has received a state replication
+     *  message
+     */
+    virtual void SetOnStateReplication(connection_cb_replication_t onStateReplication) = 0;
+
+    /**
+     * @brief
+     *  Sets the callback that will fire when this connection falls behind on, catches up on or
+     *  overflows with outgoing messages. Fires with the connection's send path locked, so it
+     *  must not send anything on this connection itself.
+     */
+    virtual void SetOnWriteStateChanged(connection_cb_write_state_t onWriteStateChanged) = 0;
+
     /**
      * @brief Retrieve the hostname of the FTL server represented by this connection
      */
@@ -220,4 +278,9 @@ public:
      * @brief Set the hostname of the FTL node represented by this connection
      */
     virtual void SetHostname(std::string hostname) = 0;
+
+    /**
+     * @brief Time at which anything (including a ping response) was last received
+     */
+    virtual std::chrono::steady_clock::time_point GetLastActivityTime() = 0;
 };
\ No newline at end of file
@@ -37,6 +37,19 @@ public:
      */
     virtual void Write(const std::vector<std::byte>& bytes) = 0;
 
+    /**
+     * @brief Number of bytes passed to Write() that haven't made it out to the socket yet
+     */
+    virtual size_t GetPendingWriteSize() = 0;
+
+    /**
+     * @brief
+     *  Sets the callback that fires from the transport's own thread whenever queued writes
+     *  make it out to the socket, with the number of bytes still pending
+     * @param onWriteProgress callback to fire as writes drain
+     */
+    virtual void SetOnWriteProgress(std::function<void(size_t)> onWriteProgress) = 0;
+
     /**
      * @brief Sets the callback that will fire when this connection has been closed.
      * @param onConnectionClosed callback to fire on connection close
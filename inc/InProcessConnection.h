@@ -0,0 +1,375 @@
+/**
+ * @file InProcessConnection.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#pragma once
+
+#include "IConnection.h"
+#include "MpscQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+/**
+ * @brief
+ *  InProcessConnection is one end of a connection between two components in the same process,
+ *  such as an embedded Orchestrator and a simulated FTL node. Payload structs are handed to the
+ *  other end as-is through a lock-free queue, with no serialization or transport in between.
+ *
+ *  Each end delivers incoming messages to its callbacks on its own thread, in the order they
+ *  were sent. Ends are created together with CreatePair.
+ */
+class InProcessConnection : public IConnection,
+    public std::enable_shared_from_this<InProcessConnection>
+{
+public:
+    /* Constructor/Destructor */
+    InProcessConnection(std::string hostname = std::string()) :
+        hostname(hostname)
+    { }
+
+    ~InProcessConnection()
+    {
+        // The delivery thread holds a reference until it exits, so it can't be running here.
+        // Make sure the other end finds out if we're going away without being stopped.
+        if (!isClosed.exchange(true))
+        {
+            if (auto peerConnection = peer.lock())
+            {
+                peerConnection->deliver(CloseMessage { });
+            }
+        }
+    }
+
+    /* Static methods */
+    /**
+     * @brief Creates two connected ends; messages sent on one are received by the other
+     * @param firstHostname hostname of the first end
+     * @param secondHostname hostname of the second end
+     */
+    static std::pair<std::shared_ptr<InProcessConnection>, std::shared_ptr<InProcessConnection>>
+        CreatePair(
+            std::string firstHostname = std::string(),
+            std::string secondHostname = std::string())
+    {
+        auto first = std::make_shared<InProcessConnection>(firstHostname);
+        auto second = std::make_shared<InProcessConnection>(secondHostname);
+        first->peer = second;
+        second->peer = first;
+        return { first, second };
+    }
+
+    /* IConnection */
+    void Start() override
+    {
+        if (isStarted.exchange(true))
+        {
+            return;
+        }
+        deliveryThreadEndedFuture = deliveryThreadEndedPromise.get_future();
+        std::thread deliveryThread(
+            &InProcessConnection::deliveryThreadBody,
+            this,
+            shared_from_this());
+        deliveryThreadId = deliveryThread.get_id();
+        deliveryThread.detach();
+    }
+
+    void Stop() override
+    {
+        if (!isClosed.exchange(true))
+        {
+            if (auto peerConnection = peer.lock())
+            {
+                peerConnection->deliver(CloseMessage { });
+            }
+            // Wakes our own delivery thread so it can exit
+            signalDelivery();
+        }
+        if (isStarted && (std::this_thread::get_id() != deliveryThreadId))
+        {
+            deliveryThreadEndedFuture.wait();
+        }
+    }
+
+    void SendIntro(const ConnectionIntroPayload& payload) override
+    {
+        sendToPeer(payload);
+    }
+
+    void SendOutro(const ConnectionOutroPayload& payload) override
+    {
+        sendToPeer(payload);
+    }
+
+    void SendNodeState(const ConnectionNodeStatePayload& payload) override
+    {
+        sendToPeer(payload);
+    }
+
+    void SendChannelSubscription(const ConnectionSubscriptionPayload& payload) override
+    {
+        sendToPeer(payload);
+    }
+
+    void SendStreamPublish(const ConnectionPublishPayload& payload) override
+    {
+        sendToPeer(payload);
+    }
+
+    void SendStreamRelay(const ConnectionRelayPayload& payload) override
+    {
+        sendToPeer(payload);
+    }
+
+    void SendPing() override
+    {
+        sendToPeer(PingMessage { });
+    }
+
+    void SendStateReplication(const ConnectionReplicationPayload& payload) override
+    {
+        sendToPeer(payload);
+    }
+
+    void SetOnConnectionClosed(std::function<void(void)> onConnectionClosed) override
+    {
+        this->onConnectionClosed = onConnectionClosed;
+    }
+
+    void SetOnIntro(connection_cb_intro_t onIntro) override
+    {
+        this->onIntro = onIntro;
+    }
+
+    void SetOnOutro(connection_cb_outro_t onOutro) override
+    {
+        this->onOutro = onOutro;
+    }
+
+    void SetOnNodeState(connection_cb_nodestate_t onNodeState) override
+    {
+        this->onNodeState = onNodeState;
+    }
+
+    void SetOnChannelSubscription(connection_cb_subscription_t onChannelSubscription) override
+    {
+        this->onChannelSubscription = onChannelSubscription;
+    }
+
+    void SetOnStreamPublish(connection_cb_publishing_t onStreamPublish) override
+    {
+        this->onStreamPublish = onStreamPublish;
+    }
+
+    void SetOnStreamRelay(connection_cb_relay_t onStreamRelay) override
+    {
+        this->onStreamRelay = onStreamRelay;
+    }
+
+    void SetOnStateReplication(connection_cb_replication_t onStateReplication) override
+    {
+        this->onStateReplication = onStateReplication;
+    }
+
+    void SetOnWriteStateChanged(connection_cb_write_state_t) override
+    {
+        // Messages are handed over in memory without a socket to back up on
+    }
+
+    std::string GetHostname() override
+    {
+        return hostname;
+    }
+
+    void SetHostname(std::string hostname) override
+    {
+        this->hostname = hostname;
+    }
+
+    std::chrono::steady_clock::time_point GetLastActivityTime() override
+    {
+        return std::chrono::steady_clock::time_point(
+            std::chrono::steady_clock::duration(lastActivityTicks.load(std::memory_order_relaxed)));
+    }
+
+private:
+    // Tells the receiving end that the sending end has gone away
+    struct CloseMessage { };
+    // Answered by the receiving end with a PongMessage, without involving callbacks
+    struct PingMessage { };
+    struct PongMessage { };
+    using Message = std::variant<
+        ConnectionIntroPayload,
+        ConnectionOutroPayload,
+        ConnectionNodeStatePayload,
+        ConnectionSubscriptionPayload,
+        ConnectionPublishPayload,
+        ConnectionRelayPayload,
+        ConnectionReplicationPayload,
+        PingMessage,
+        PongMessage,
+        CloseMessage>;
+
+    /* Private members */
+    std::weak_ptr<InProcessConnection> peer;
+    MpscQueue<Message> inbound;
+    // Bumped after every push to inbound so a sleeping delivery thread never misses one
+    std::atomic<uint32_t> deliverySignal { 0 };
+    std::atomic<bool> isStarted { false };
+    std::atomic<bool> isClosed { false };
+    std::atomic<std::chrono::steady_clock::rep> lastActivityTicks {
+        std::chrono::steady_clock::now().time_since_epoch().count() };
+    std::promise<void> deliveryThreadEndedPromise;
+    std::future<void> deliveryThreadEndedFuture;
+    std::thread::id deliveryThreadId;
+    std::function<void(void)> onConnectionClosed;
+    connection_cb_intro_t onIntro;
+    connection_cb_outro_t onOutro;
+    connection_cb_nodestate_t onNodeState;
+    connection_cb_subscription_t onChannelSubscription;
+    connection_cb_publishing_t onStreamPublish;
+    connection_cb_relay_t onStreamRelay;
+    connection_cb_replication_t onStateReplication;
+    std::string hostname;
+
+    /* Private methods */
+    template <class TPayload>
+    void sendToPeer(const TPayload& payload)
+    {
+        if (isClosed)
+        {
+            return;
+        }
+        if (auto peerConnection = peer.lock())
+        {
+            peerConnection->deliver(payload);
+        }
+    }
+
+    void deliver(Message message)
+    {
+        inbound.Push(std::move(message));
+        signalDelivery();
+    }
+
+    void signalDelivery()
+    {
+        deliverySignal.fetch_add(1, std::memory_order_release);
+        deliverySignal.notify_one();
+    }
+
+    /**
+     * @brief
+     *  Thread body for handing incoming messages to callbacks until either end closes. Holds a
+     *  reference to this connection so it can't be destructed underneath us.
+     */
+    void deliveryThreadBody(std::shared_ptr<InProcessConnection> self)
+    {
+        bool isRemoteClose = false;
+        while (!isRemoteClose)
+        {
+            // Read the signal before draining; anything pushed after this will change it
+            uint32_t seenSignal = deliverySignal.load(std::memory_order_acquire);
+            while (std::optional<Message> message = inbound.TryPop())
+            {
+                if (isClosed)
+                {
+                    // Stopped locally; anything still queued is dropped
+                    break;
+                }
+                if (std::holds_alternative<CloseMessage>(*message))
+                {
+                    isRemoteClose = !isClosed.exchange(true);
+                    break;
+                }
+                lastActivityTicks.store(
+                    std::chrono::steady_clock::now().time_since_epoch().count(),
+                    std::memory_order_relaxed);
+                dispatch(std::move(*message));
+            }
+            if (isClosed)
+            {
+                break;
+            }
+            deliverySignal.wait(seenSignal, std::memory_order_acquire);
+        }
+
+        spdlog::debug("{} CLOSED: Triggered by {}", hostname, isRemoteClose ? "remote" : "local");
+        if (isRemoteClose && onConnectionClosed)
+        {
+            onConnectionClosed();
+        }
+        deliveryThreadEndedPromise.set_value();
+    }
+
+    void dispatch(Message&& message)
+    {
+        if (auto intro = std::get_if<ConnectionIntroPayload>(&message))
+        {
+            if (onIntro)
+            {
+                onIntro(std::move(*intro));
+            }
+        }
+        else if (auto outro = std::get_if<ConnectionOutroPayload>(&message))
+        {
+            if (onOutro)
+            {
+                onOutro(std::move(*outro));
+            }
+        }
+        else if (auto nodeState = std::get_if<ConnectionNodeStatePayload>(&message))
+        {
+            if (onNodeState)
+            {
+                onNodeState(std::move(*nodeState));
+            }
+        }
+        else if (auto subscription = std::get_if<ConnectionSubscriptionPayload>(&message))
+        {
+            if (onChannelSubscription)
+            {
+                onChannelSubscription(std::move(*subscription));
+            }
+        }
+        else if (auto publish = std::get_if<ConnectionPublishPayload>(&message))
+        {
+            if (onStreamPublish)
+            {
+                onStreamPublish(std::move(*publish));
+            }
+        }
+        else if (auto relay = std::get_if<ConnectionRelayPayload>(&message))
+        {
+            if (onStreamRelay)
+            {
+                onStreamRelay(std::move(*relay));
+            }
+        }
+        else if (auto replication = std::get_if<ConnectionReplicationPayload>(&message))
+        {
+            if (onStateReplication)
+            {
+                onStateReplication(std::move(*replication));
+            }
+        }
+        else if (std::holds_alternative<PingMessage>(message))
+        {
+            sendToPeer(PongMessage { });
+        }
+    }
+};
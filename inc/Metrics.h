@@ -0,0 +1,396 @@
+/**
+ * @file Metrics.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ * @brief Wait-free counters and histograms with Prometheus text exposition
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+/**
+ * @brief
+ *  A monotonically increasing counter. Increments are spread across cache-line aligned shards
+ *  picked per-thread, so threads on different cores never contend on the same line.
+ */
+class MetricCounter
+{
+public:
+    /**
+     * @brief Adds to the counter. Wait-free.
+     */
+    void Increment(uint64_t amount = 1)
+    {
+        shards[shardIndex()].Value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Sums all shards. Concurrent increments may or may not be included.
+     */
+    uint64_t GetValue() const
+    {
+        uint64_t total = 0;
+        for (const auto& shard : shards)
+        {
+            total += shard.Value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+private:
+    static constexpr size_t SHARD_COUNT = 16;
+    struct alignas(64) Shard
+    {
+        std::atomic<uint64_t> Value { 0 };
+    };
+    std::array<Shard, SHARD_COUNT> shards;
+
+    static size_t shardIndex()
+    {
+        static std::atomic<size_t> nextShardIndex { 0 };
+        thread_local size_t threadShardIndex =
+            (nextShardIndex.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT);
+        return threadShardIndex;
+    }
+};
+
+/**
+ * @brief
+ *  A log-linear (HDR-style) histogram of unsigned integer samples. Each power of two is split
+ *  into SUB_BUCKETS linear buckets, giving a bounded relative error with a fixed bucket array.
+ *  Recording a sample is a handful of relaxed atomic adds.
+ */
+class MetricHistogram
+{
+public:
+    /**
+     * @param exportScale
+     *  factor applied to bucket bounds and the sum when exporting, e.g. 1e-9 to record
+     *  nanoseconds and export seconds
+     */
+    MetricHistogram(double exportScale = 1.0) :
+        exportScale(exportScale)
+    { }
+
+    /**
+     * @brief Records a sample. Wait-free.
+     */
+    void Record(uint64_t value)
+    {
+        buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Records the time elapsed since the given point, in nanoseconds
+     */
+    void RecordSince(std::chrono::steady_clock::time_point start)
+    {
+        Record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count()));
+    }
+
+    uint64_t GetCount() const
+    {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetSum() const
+    {
+        return sum.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Estimates the value at the given quantile (0.0 - 1.0) from the bucket counts
+     */
+    uint64_t GetQuantile(double quantile) const
+    {
+        uint64_t total = GetCount();
+        if (total == 0)
+        {
+            return 0;
+        }
+        uint64_t target = static_cast<uint64_t>(quantile * static_cast<double>(total));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i)
+        {
+            seen += buckets[i].load(std::memory_order_relaxed);
+            if (seen > target)
+            {
+                return bucketUpperBound(i);
+            }
+        }
+        return bucketUpperBound(BUCKET_COUNT - 1);
+    }
+
+    /**
+     * @brief Appends Prometheus histogram series for this histogram
+     */
+    void Serialize(std::ostream& out, const std::string& name, const std::string& labels) const
+    {
+        // Only emit buckets that have been hit to keep scrapes small; the cumulative counts
+        // stay valid since empty buckets would just repeat the previous value.
+        std::string labelPrefix = labels.empty() ? "" : (labels + ",");
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i)
+        {
+            uint64_t bucketCount = buckets[i].load(std::memory_order_relaxed);
+            if (bucketCount == 0)
+            {
+                continue;
+            }
+            cumulative += bucketCount;
+            out << name << "_bucket{" << labelPrefix << "le=\""
+                << (static_cast<double>(bucketUpperBound(i)) * exportScale) << "\"} "
+                << cumulative << "\n";
+        }
+        out << name << "_bucket{" << labelPrefix << "le=\"+Inf\"} " << GetCount() << "\n";
+        out << name << "_sum" << braced(labels) << " "
+            << (static_cast<double>(GetSum()) * exportScale) << "\n";
+        out << name << "_count" << braced(labels) << " " << GetCount() << "\n";
+    }
+
+private:
+    static constexpr size_t SUB_BUCKET_BITS = 2;
+    static constexpr size_t SUB_BUCKETS = (1 << SUB_BUCKET_BITS);
+    static constexpr size_t BUCKET_COUNT = ((64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS);
+    const double exportScale;
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets { };
+    std::atomic<uint64_t> count { 0 };
+    std::atomic<uint64_t> sum { 0 };
+
+    static std::string braced(const std::string& labels)
+    {
+        return labels.empty() ? "" : ("{" + labels + "}");
+    }
+
+    static size_t bucketIndex(uint64_t value)
+    {
+        if (value < SUB_BUCKETS)
+        {
+            return static_cast<size_t>(value);
+        }
+        // Octave is determined by the highest set bit, the sub-bucket by the bits below it
+        size_t highestBit = (63 - std::countl_zero(value));
+        size_t octave = (highestBit - SUB_BUCKET_BITS + 1);
+        size_t subBucket = ((value >> (highestBit - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+        return ((octave * SUB_BUCKETS) + subBucket);
+    }
+
+    static uint64_t bucketUpperBound(size_t index)
+    {
+        if (index < SUB_BUCKETS)
+        {
+            return index;
+        }
+        size_t octave = (index / SUB_BUCKETS);
+        uint64_t subBucket = (index % SUB_BUCKETS);
+        size_t shift = (octave - 1);
+        uint64_t lowerBound = ((SUB_BUCKETS + subBucket) << shift);
+        return (lowerBound + ((uint64_t{1} << shift) - 1));
+    }
+};
+
+/**
+ * @brief
+ *  Process-wide collection of named metrics. Registration takes a lock and is expected to
+ *  happen once per call site (hold on to the returned reference); updates never lock.
+ */
+class MetricsRegistry
+{
+public:
+    /**
+     * @brief Keeps a gauge registered for as long as this handle is alive
+     */
+    class GaugeHandle
+    {
+    public:
+        GaugeHandle() = default;
+        GaugeHandle(MetricsRegistry* registry, uint64_t gaugeId) :
+            registry(registry),
+            gaugeId(gaugeId)
+        { }
+        GaugeHandle(const GaugeHandle&) = delete;
+        GaugeHandle& operator=(const GaugeHandle&) = delete;
+        GaugeHandle(GaugeHandle&& other) noexcept
+        {
+            *this = std::move(other);
+        }
+        GaugeHandle& operator=(GaugeHandle&& other) noexcept
+        {
+            reset();
+            registry = other.registry;
+            gaugeId = other.gaugeId;
+            other.registry = nullptr;
+            return *this;
+        }
+        ~GaugeHandle()
+        {
+            reset();
+        }
+
+    private:
+        MetricsRegistry* registry = nullptr;
+        uint64_t gaugeId = 0;
+
+        void reset()
+        {
+            if (registry != nullptr)
+            {
+                registry->removeGauge(gaugeId);
+                registry = nullptr;
+            }
+        }
+    };
+
+    /**
+     * @brief Registry shared by the whole process
+     */
+    static MetricsRegistry& Default()
+    {
+        static MetricsRegistry defaultRegistry;
+        return defaultRegistry;
+    }
+
+    /**
+     * @brief Returns the counter with the given name and labels, creating it if needed
+     * @param labels Prometheus label pairs without braces, e.g. `type="intro"`
+     */
+    MetricCounter& GetCounter(
+        const std::string& name,
+        const std::string& help,
+        const std::string& labels = std::string())
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        auto& family = getFamily(name, help, "counter");
+        auto& counter = family.Counters[labels];
+        if (counter == nullptr)
+        {
+            counter = std::make_unique<MetricCounter>();
+        }
+        return *counter;
+    }
+
+    /**
+     * @brief Returns the histogram with the given name and labels, creating it if needed
+     */
+    MetricHistogram& GetHistogram(
+        const std::string& name,
+        const std::string& help,
+        const std::string& labels = std::string(),
+        double exportScale = 1.0)
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        auto& family = getFamily(name, help, "histogram");
+        auto& histogram = family.Histograms[labels];
+        if (histogram == nullptr)
+        {
+            histogram = std::make_unique<MetricHistogram>(exportScale);
+        }
+        return *histogram;
+    }
+
+    /**
+     * @brief Registers a gauge whose value is read when metrics are serialized
+     * @return GaugeHandle the gauge is unregistered when this handle is destroyed
+     */
+    [[nodiscard]] GaugeHandle AddGauge(
+        const std::string& name,
+        const std::string& help,
+        std::function<double()> readValue,
+        const std::string& labels = std::string())
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        auto& family = getFamily(name, help, "gauge");
+        uint64_t gaugeId = nextGaugeId++;
+        family.Gauges.push_back(Gauge { .Id = gaugeId, .Labels = labels, .ReadValue = readValue });
+        return GaugeHandle(this, gaugeId);
+    }
+
+    /**
+     * @brief Renders every registered metric in the Prometheus text exposition format
+     */
+    std::string Serialize()
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        std::stringstream out;
+        for (const auto& [name, family] : families)
+        {
+            if (family.Counters.empty() && family.Histograms.empty() && family.Gauges.empty())
+            {
+                continue;
+            }
+            out << "# HELP " << name << " " << family.Help << "\n";
+            out << "# TYPE " << name << " " << family.Type << "\n";
+            for (const auto& [labels, counter] : family.Counters)
+            {
+                out << name << (labels.empty() ? "" : ("{" + labels + "}")) << " "
+                    << counter->GetValue() << "\n";
+            }
+            for (const auto& [labels, histogram] : family.Histograms)
+            {
+                histogram->Serialize(out, name, labels);
+            }
+            for (const auto& gauge : family.Gauges)
+            {
+                out << name << (gauge.Labels.empty() ? "" : ("{" + gauge.Labels + "}")) << " "
+                    << gauge.ReadValue() << "\n";
+            }
+        }
+        return out.str();
+    }
+
+private:
+    struct Gauge
+    {
+        uint64_t Id;
+        std::string Labels;
+        std::function<double()> ReadValue;
+    };
+    struct Family
+    {
+        std::string Help;
+        std::string Type;
+        std::map<std::string, std::unique_ptr<MetricCounter>> Counters;
+        std::map<std::string, std::unique_ptr<MetricHistogram>> Histograms;
+        std::list<Gauge> Gauges;
+    };
+    std::mutex registryMutex;
+    std::map<std::string, Family> families;
+    uint64_t nextGaugeId = 0;
+
+    Family& getFamily(const std::string& name, const std::string& help, const std::string& type)
+    {
+        auto& family = families[name];
+        if (family.Type.empty())
+        {
+            family.Help = help;
+            family.Type = type;
+        }
+        return family;
+    }
+
+    void removeGauge(uint64_t gaugeId)
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (auto& [name, family] : families)
+        {
+            family.Gauges.remove_if([gaugeId](const Gauge& gauge) { return gauge.Id == gaugeId; });
+        }
+    }
+};
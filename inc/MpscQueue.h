@@ -0,0 +1,88 @@
+/**
+ * @file MpscQueue.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+/**
+ * @brief
+ *  Unbounded lock-free queue that any number of threads may push to, but only a single thread
+ *  may pop from. Producers never block each other or the consumer; each push is one atomic
+ *  exchange on the queue head.
+ *
+ *  A push that is still in flight on another thread may briefly be invisible to TryPop, so
+ *  consumers that sleep should pair the queue with a signal that producers bump after pushing.
+ */
+template <class T>
+class MpscQueue
+{
+public:
+    /* Constructor/Destructor */
+    MpscQueue() :
+        head(new Node()),
+        tail(head.load(std::memory_order_relaxed))
+    { }
+
+    ~MpscQueue()
+    {
+        while (tail != nullptr)
+        {
+            Node* next = tail->Next.load(std::memory_order_relaxed);
+            delete tail;
+            tail = next;
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /* Public methods */
+    /**
+     * @brief Appends a value to the queue. Safe to call from any thread.
+     */
+    void Push(T value)
+    {
+        Node* node = new Node();
+        node->Value.emplace(std::move(value));
+        Node* previous = head.exchange(node, std::memory_order_acq_rel);
+        previous->Next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * @brief Removes the oldest value, if there is one. Only one thread may call this.
+     */
+    std::optional<T> TryPop()
+    {
+        Node* next = tail->Next.load(std::memory_order_acquire);
+        if (next == nullptr)
+        {
+            return std::nullopt;
+        }
+        // The popped node becomes the new (empty) stub
+        std::optional<T> value(std::move(next->Value));
+        next->Value.reset();
+        delete tail;
+        tail = next;
+        return value;
+    }
+
+private:
+    struct Node
+    {
+        std::atomic<Node*> Next { nullptr };
+        std::optional<T> Value;
+    };
+
+    /* Private members */
+    // Most recently pushed node, swapped by producers
+    std::atomic<Node*> head;
+    // Stub node preceding the oldest value, only touched by the consumer
+    Node* tail;
+};
@@ -23,6 +23,8 @@ enum class OrchestrationMessageType : uint8_t
     Intro               = 0,
     Outro               = 1,
     NodeState           = 2,
+    Ping                = 3,
+    StateReplication    = 4,
     ChannelSubscription = 16,
     StreamPublish       = 17,
     StreamRelay         = 20,
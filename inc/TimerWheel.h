@@ -0,0 +1,381 @@
+/**
+ * @file TimerWheel.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief
+ *  A hierarchical timer wheel for the deadlines connections keep (handshake timeouts,
+ *  keepalives and so on). Scheduling and cancelling are O(1), and callbacks run on a single
+ *  thread owned by the wheel.
+ *
+ *  The thread only wakes when a timer is due or a slot needs cascading down a level, and sleeps
+ *  indefinitely while no timers are pending, so idle connections cost nothing. The thread is
+ *  started on the first Schedule() call.
+ */
+class TimerWheel
+{
+public:
+    typedef uint64_t timer_id_t;
+
+    /* Constructor/Destructor */
+    /**
+     * @param tickDuration granularity of the wheel; timers fire up to one tick late
+     */
+    TimerWheel(std::chrono::milliseconds tickDuration = DEFAULT_TICK_DURATION) :
+        tickDuration(tickDuration),
+        startTime(std::chrono::steady_clock::now())
+    { }
+
+    ~TimerWheel()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            isStopping = true;
+        }
+        wakeConditionVariable.notify_all();
+        if (wheelThread.joinable())
+        {
+            wheelThread.join();
+        }
+    }
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /* Public methods */
+    /**
+     * @brief Runs callback on the wheel thread once delay has elapsed
+     * @return timer_id_t id that can be passed to Cancel()
+     */
+    timer_id_t Schedule(std::chrono::milliseconds delay, std::function<void()> callback)
+    {
+        bool isWakeNeeded = false;
+        timer_id_t timerId;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!wheelThread.joinable())
+            {
+                wheelThread = std::thread(&TimerWheel::wheelThreadBody, this);
+                wheelThreadId = wheelThread.get_id();
+            }
+
+            // Round up so timers never fire early
+            auto fromStart = (std::chrono::steady_clock::now() + delay - startTime);
+            uint64_t expiryTick = static_cast<uint64_t>(
+                (fromStart + tickDuration - std::chrono::nanoseconds(1)) / tickDuration);
+            if (expiryTick <= currentTick)
+            {
+                expiryTick = (currentTick + 1);
+            }
+
+            timerId = nextTimerId++;
+            Timer& timer = timers.emplace(timerId, Timer
+                {
+                    .Id = timerId,
+                    .ExpiryTick = expiryTick,
+                    .Callback = std::move(callback),
+                }).first->second;
+            insertTimer(timer, currentTick);
+            isWakeNeeded = (expiryTick < plannedWakeTick);
+        }
+        if (isWakeNeeded)
+        {
+            wakeConditionVariable.notify_one();
+        }
+        return timerId;
+    }
+
+    /**
+     * @brief
+     *  Cancels a pending timer. If its callback is already running on another thread, waits for
+     *  it to finish, so nothing the callback touches needs to outlive this call.
+     * @return true if the timer was pending and will not fire
+     */
+    bool Cancel(timer_id_t timerId)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto timerIt = timers.find(timerId);
+        if (timerIt != timers.end())
+        {
+            if (!timerIt->second.IsDue)
+            {
+                unlinkTimer(timerIt->second);
+            }
+            timers.erase(timerIt);
+            return true;
+        }
+        if (std::this_thread::get_id() != wheelThreadId)
+        {
+            callbackFinishedConditionVariable.wait(
+                lock,
+                [this, timerId]() { return (runningTimerId != timerId); });
+        }
+        return false;
+    }
+
+    /**
+     * @brief Number of timers that have not yet fired or been cancelled
+     */
+    size_t GetPendingCount()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return timers.size();
+    }
+
+    /* Static members */
+    static constexpr std::chrono::milliseconds DEFAULT_TICK_DURATION =
+        std::chrono::milliseconds(10);
+
+private:
+    /* Private types */
+    struct Timer
+    {
+        timer_id_t Id;
+        uint64_t ExpiryTick;
+        std::function<void()> Callback;
+        // Links within the slot this timer is waiting in
+        Timer* Previous = nullptr;
+        Timer* Next = nullptr;
+        unsigned int Level = 0;
+        unsigned int Slot = 0;
+        // Taken out of the wheel and waiting for its callback to run
+        bool IsDue = false;
+    };
+
+    /* Static members */
+    // Each level has 64 slots, each spanning 64 slots of the level below. With 10ms ticks,
+    // the levels cover 640ms, 41s, 44m and 46h.
+    static constexpr unsigned int LEVEL_BITS = 6;
+    static constexpr unsigned int SLOT_COUNT = (1 << LEVEL_BITS);
+    static constexpr unsigned int LEVEL_COUNT = 4;
+    static constexpr uint64_t NO_WAKE = UINT64_MAX;
+
+    /* Private members */
+    const std::chrono::steady_clock::duration tickDuration;
+    const std::chrono::steady_clock::time_point startTime;
+    std::mutex mutex;
+    std::condition_variable wakeConditionVariable;
+    std::condition_variable callbackFinishedConditionVariable;
+    // Timers by id. Elements never move, so slots can link them together directly.
+    std::unordered_map<timer_id_t, Timer> timers;
+    std::array<std::array<Timer*, SLOT_COUNT>, LEVEL_COUNT> slots { };
+    // Bit per slot, set when the slot holds timers
+    std::array<uint64_t, LEVEL_COUNT> occupiedSlots { };
+    // Last tick the wheel has been advanced to
+    uint64_t currentTick = 0;
+    uint64_t plannedWakeTick = NO_WAKE;
+    timer_id_t nextTimerId = 1;
+    timer_id_t runningTimerId = 0;
+    bool isStopping = false;
+    std::thread wheelThread;
+    std::thread::id wheelThreadId;
+
+    /* Private methods */
+    /**
+     * @brief Files a timer into the slot it should wait in, relative to referenceTick
+     */
+    void insertTimer(Timer& timer, uint64_t referenceTick)
+    {
+        uint64_t expiryTick = timer.ExpiryTick;
+        uint64_t delta = (expiryTick > referenceTick) ? (expiryTick - referenceTick) : 0;
+        // Anything beyond the last level waits at its far edge and is re-filed when cascaded
+        uint64_t wheelSpan = (uint64_t{1} << (LEVEL_BITS * LEVEL_COUNT));
+        if (delta >= wheelSpan)
+        {
+            expiryTick = (referenceTick + wheelSpan - 1);
+            delta = (wheelSpan - 1);
+        }
+        unsigned int level = 0;
+        while ((level < (LEVEL_COUNT - 1)) && (delta >= (uint64_t{1} << (LEVEL_BITS * (level + 1)))))
+        {
+            ++level;
+        }
+        unsigned int slot = ((expiryTick >> (LEVEL_BITS * level)) & (SLOT_COUNT - 1));
+
+        timer.Level = level;
+        timer.Slot = slot;
+        timer.Previous = nullptr;
+        timer.Next = slots[level][slot];
+        if (timer.Next != nullptr)
+        {
+            timer.Next->Previous = &timer;
+        }
+        slots[level][slot] = &timer;
+        occupiedSlots[level] |= (uint64_t{1} << slot);
+    }
+
+    void unlinkTimer(Timer& timer)
+    {
+        if (timer.Previous != nullptr)
+        {
+            timer.Previous->Next = timer.Next;
+        }
+        else
+        {
+            slots[timer.Level][timer.Slot] = timer.Next;
+        }
+        if (timer.Next != nullptr)
+        {
+            timer.Next->Previous = timer.Previous;
+        }
+        if (slots[timer.Level][timer.Slot] == nullptr)
+        {
+            occupiedSlots[timer.Level] &= ~(uint64_t{1} << timer.Slot);
+        }
+    }
+
+    /**
+     * @brief Removes every timer from a slot, returning them as a list
+     */
+    Timer* takeSlot(unsigned int level, unsigned int slot)
+    {
+        Timer* head = slots[level][slot];
+        slots[level][slot] = nullptr;
+        occupiedSlots[level] &= ~(uint64_t{1} << slot);
+        return head;
+    }
+
+    /**
+     * @brief
+     *  The next tick at which an occupied slot either expires (level 0) or cascades to the
+     *  level below, if any timers are pending
+     */
+    std::optional<uint64_t> nextEventTick() const
+    {
+        std::optional<uint64_t> nextTick;
+        for (unsigned int level = 0; level < LEVEL_COUNT; ++level)
+        {
+            uint64_t occupied = occupiedSlots[level];
+            unsigned int shift = (LEVEL_BITS * level);
+            uint64_t firstBlock = ((currentTick >> shift) + 1);
+            while (occupied != 0)
+            {
+                uint64_t slot = static_cast<uint64_t>(std::countr_zero(occupied));
+                occupied &= (occupied - 1);
+                uint64_t block = (firstBlock + ((slot - firstBlock) & (SLOT_COUNT - 1)));
+                uint64_t tick = (block << shift);
+                if (!nextTick || (tick < nextTick.value()))
+                {
+                    nextTick = tick;
+                }
+            }
+        }
+        return nextTick;
+    }
+
+    /**
+     * @brief
+     *  Advances the wheel to tick, which must be the next event tick. Cascades any slots that
+     *  start at this tick, then collects the timers that are now due.
+     */
+    void advanceTo(uint64_t tick, std::vector<timer_id_t>& dueTimers)
+    {
+        currentTick = tick;
+        // Higher levels first, so timers cascading through several levels land in time
+        for (unsigned int level = (LEVEL_COUNT - 1); level > 0; --level)
+        {
+            unsigned int shift = (LEVEL_BITS * level);
+            if ((tick & ((uint64_t{1} << shift) - 1)) != 0)
+            {
+                continue;
+            }
+            Timer* timer = takeSlot(level, ((tick >> shift) & (SLOT_COUNT - 1)));
+            while (timer != nullptr)
+            {
+                Timer* next = timer->Next;
+                insertTimer(*timer, tick);
+                timer = next;
+            }
+        }
+
+        Timer* timer = takeSlot(0, (tick & (SLOT_COUNT - 1)));
+        while (timer != nullptr)
+        {
+            Timer* next = timer->Next;
+            if (timer->ExpiryTick <= tick)
+            {
+                timer->IsDue = true;
+                dueTimers.push_back(timer->Id);
+            }
+            else
+            {
+                insertTimer(*timer, tick);
+            }
+            timer = next;
+        }
+    }
+
+    void wheelThreadBody()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        std::vector<timer_id_t> dueTimers;
+        while (!isStopping)
+        {
+            uint64_t nowTick = static_cast<uint64_t>(
+                (std::chrono::steady_clock::now() - startTime) / tickDuration);
+            std::optional<uint64_t> nextTick = nextEventTick();
+            while (nextTick && (nextTick.value() <= nowTick))
+            {
+                advanceTo(nextTick.value(), dueTimers);
+                nextTick = nextEventTick();
+            }
+            // Nothing happens in between, so we can skip straight to now
+            currentTick = std::max(currentTick, nowTick);
+
+            for (timer_id_t timerId : dueTimers)
+            {
+                // Skip timers cancelled while earlier callbacks were running
+                auto timerIt = timers.find(timerId);
+                if (timerIt == timers.end())
+                {
+                    continue;
+                }
+                std::function<void()> callback = std::move(timerIt->second.Callback);
+                timers.erase(timerIt);
+                runningTimerId = timerId;
+                lock.unlock();
+                callback();
+                lock.lock();
+                runningTimerId = 0;
+                callbackFinishedConditionVariable.notify_all();
+            }
+            if (!dueTimers.empty())
+            {
+                // Callbacks take time and may have scheduled more timers; look again
+                dueTimers.clear();
+                continue;
+            }
+
+            if (nextTick)
+            {
+                plannedWakeTick = nextTick.value();
+                wakeConditionVariable.wait_until(
+                    lock,
+                    (startTime + (tickDuration * plannedWakeTick)));
+            }
+            else
+            {
+                plannedWakeTick = NO_WAKE;
+                wakeConditionVariable.wait(lock);
+            }
+        }
+    }
+};
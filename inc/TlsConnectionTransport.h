@@ -9,8 +9,11 @@
 
 #include "IConnectionTransport.h"
 
-#include "OpenSslPtr.h"
 #include "FtlTypes.h"
+#include "Metrics.h"
+#include "OpenSslPtr.h"
+#include "TimerWheel.h"
+#include "TlsTransportContext.h"
 
 #include <arpa/inet.h>
 #include <atomic>
@@ -18,13 +21,15 @@
 #include <fcntl.h>
 #include <filesystem>
 #include <functional>
+#include <future>
+#include <memory>
 #include <mutex>
 #include <openssl/err.h>
 #include <openssl/ssl.h>
 #include <poll.h>
 #include <string>
 #include <spdlog/spdlog.h>
-#include <spdlog/fmt/bin_to_hex.h>
+#include <sys/eventfd.h>
 #include <thread>
 #include <unistd.h>
 #include <vector>
@@ -40,24 +45,38 @@ public:
     /* Constructor/Destructor */
     /**
      * @brief Construct a new TlsConnectionTransport object
-     * @param isServer true if this is a server connection, false if this is a client connection
+     * @param context
+     *  shared TLS state (server or client role and pre-shared key) for this connection
      * @param socketHandle the handle to the socket connection for this connection
      * @param targetAddress the address that this connection is communicating with
-     * @param preSharedKey pre-shared key for TLS PSK encryption
      */
     TlsConnectionTransport(
-        bool isServer,
+        std::shared_ptr<TlsTransportContext> context,
         int socketHandle,
-        sockaddr_in targetAddress,
-        std::vector<std::byte> preSharedKey
+        sockaddr_in targetAddress
     ) : 
-        isServer(isServer),
+        context(context),
+        isServer(context->IsServer()),
         socketHandle(socketHandle),
-        targetAddress(targetAddress),
-        preSharedKey(preSharedKey)
+        targetAddress(targetAddress)
     { }
 
 
+    ~TlsConnectionTransport()
+    {
+        // Once started, the connection thread closes the socket on its way out
+        if (!isStarted)
+        {
+            close(socketHandle);
+        }
+        // Closed here rather than on the connection thread so Write() and Stop() never race
+        // with the handle being reused
+        if (wakeEventHandle >= 0)
+        {
+            close(wakeEventHandle);
+        }
+    }
+
     /* IConnectionTransport */
     void StartAsync() override
     {
@@ -69,105 +88,91 @@ public:
             throw std::runtime_error("Could not set socket to non-blocking mode.");
         }
 
-        SslCtxPtr sslContext(SSL_CTX_new(isServer ? TLS_server_method() : TLS_client_method()));
-
-        // Disable old protocols
-        SSL_CTX_set_min_proto_version(sslContext.get(), TLS1_3_VERSION);
-        SSL_CTX_set_max_proto_version(sslContext.get(), TLS1_3_VERSION);
-
-        // Restrict to secure PSK ciphers
-        if (!SSL_CTX_set_ciphersuites(sslContext.get(), "TLS_AES_128_GCM_SHA256"))
-        {
-            char sslErrStr[256];
-            unsigned long sslErr = ERR_get_error();
-            ERR_error_string_n(sslErr, sslErrStr, sizeof(sslErrStr));
-            throw std::runtime_error(sslErrStr);
-        }
-
-        // Set up callback to locate pre-shared key
-        if (isServer)
-        {
-            SSL_CTX_set_psk_find_session_callback(
-                sslContext.get(),
-                &TlsConnectionTransport::sslPskFindSessionCallback);
-        }
-        else
-        {
-            SSL_CTX_set_psk_use_session_callback(
-                sslContext.get(),
-                &TlsConnectionTransport::sslPskUseSessionCallback);
-        }
-
-        // Create new SSL instance from context
-        ssl = SslPtr(SSL_new(sslContext.get()));
-
-        // Add self-reference to the SSL instance so we can get back from callback functions
-        SSL_set_ex_data(ssl.get(), 0, this);
+        // Create new SSL instance from the shared context
+        ssl = context->NewSsl();
 
         // Bind SSL to our socket file descriptor and attempt to accept/connect
         SSL_set_fd(ssl.get(), socketHandle);
 
-        // Open pipe used for writing to SSL
-        if (pipe2(writePipeFds, O_NONBLOCK) != 0)
+        // Open eventfd used to wake the connection thread for writes, stops and timeouts
+        wakeEventHandle = eventfd(0, (EFD_NONBLOCK | EFD_CLOEXEC));
+        if (wakeEventHandle < 0)
         {
-            throw std::runtime_error("Could not open SSL write pipe!");
+            throw std::runtime_error("Could not open connection wake eventfd!");
         }
 
         // Spin up a new thread to handle I/O
         std::promise<bool> sslConnectedPromise;
         std::future<bool> sslConnectedFuture = sslConnectedPromise.get_future();
         connectionThreadEndedFuture = connectionThreadEndedPromise.get_future();
+        isStarted = true;
         connectionThread = std::thread(
             &TlsConnectionTransport::connectionThreadBody,
             this,
             std::move(sslConnectedPromise));
+        connectionThreadId = connectionThread.get_id();
         connectionThread.detach();
 
-        // Wait for SSL to finish connecting
-        sslConnectedFuture.get();
+        // Servers hear about the handshake through the handshake complete callback, so a slow
+        // client can't hold up whoever is accepting connections. Clients wait for SSL to finish
+        // connecting so they can start talking as soon as we return.
+        if (!isServer)
+        {
+            sslConnectedFuture.get();
+        }
     }
 
     void Stop() override
     {
-        spdlog::debug("{} Stop() called", socketHandle);
-        if (!isStopping && !isStopped)
+        if (!isStarted)
         {
-            isStopping = true;
-            SSL_shutdown(ssl.get());
-            shutdown(socketHandle, SHUT_RDWR);
-            close(socketHandle);
-            spdlog::debug("{} CLOSED: Triggered by local, waiting for thread end...", socketHandle);
-            connectionThreadEndedFuture.wait(); // Wait until our connection thread end has ended
-            spdlog::debug("{} CLOSED: Triggered by local, thread ended.", socketHandle);
+            return;
         }
-        else if (isStopping && !isStopped)
+        if (!isStopping.exchange(true))
         {
-            spdlog::debug(
-                "{} Requested to stop but we're already stopping... waiting until we're closed",
-                socketHandle);
-            connectionThreadEndedFuture.wait(); // Wait until our connection thread end has ended
+            spdlog::debug("{} Stop() called", socketHandle);
+            signalWake();
+        }
+        // The connection thread can't wait on itself; it exits once the current callback returns
+        if (std::this_thread::get_id() != connectionThreadId)
+        {
+            connectionThreadEndedFuture.wait();
             spdlog::debug("{} Thread ended.", socketHandle);
         }
     }
 
     void Write(const std::vector<std::byte>& bytes) override
     {
-        if (!isStopping && !isStopped)
+        if (isStopping || isClosed)
+        {
+            return;
+        }
+        bool isWakeNeeded;
         {
             std::lock_guard<std::mutex> lock(writeMutex);
-            spdlog::debug("{} ATTEMPT WRITE {} bytes", socketHandle, bytes.size());
-            int writeResult = write(writePipeFds[1], bytes.data(), bytes.size());
-            if (static_cast<size_t>(writeResult) != bytes.size())
-            {
-                spdlog::error(
-                    "Write returned {} result, expected {} bytes.",
-                    writeResult,
-                    bytes.size());
-                closeConnection();
-            }
+            // Only the first write since the connection thread last took the buffer needs to
+            // wake it; later ones ride along
+            isWakeNeeded = pendingWrites.empty();
+            pendingWrites.insert(pendingWrites.end(), bytes.begin(), bytes.end());
+            pendingWriteSize += bytes.size();
+        }
+        spdlog::debug("{} QUEUED WRITE {} bytes", socketHandle, bytes.size());
+        if (isWakeNeeded)
+        {
+            signalWake();
         }
     }
 
+    size_t GetPendingWriteSize() override
+    {
+        return pendingWriteSize;
+    }
+
+    void SetOnWriteProgress(std::function<void(size_t)> onWriteProgress) override
+    {
+        this->onWriteProgress = onWriteProgress;
+    }
+
     void SetOnBytesReceived(
         std::function<void(const std::vector<std::byte>&)> onBytesReceived) override
     {
@@ -179,63 +184,72 @@ public:
         this->onConnectionClosed = onConnectionClosed;
     }
 
+    /* Public methods */
+    /**
+     * @brief
+     *  Sets the callback that will fire from the connection thread once TLS negotiation has
+     *  either succeeded or failed (including timing out or being stopped). Must be set before
+     *  StartAsync().
+     * @param onHandshakeComplete callback to fire, with true if the handshake succeeded
+     */
+    void SetOnHandshakeComplete(std::function<void(bool)> onHandshakeComplete)
+    {
+        this->onHandshakeComplete = onHandshakeComplete;
+    }
+
+    sockaddr_in GetTargetAddress() const
+    {
+        return targetAddress;
+    }
+
+    /**
+     * @brief Whether outgoing records are encrypted by the kernel (kTLS) for this connection.
+     *  Only meaningful once the handshake has completed.
+     */
+    bool IsKernelTlsSend() const
+    {
+        return isKernelTlsSend;
+    }
+
+    /**
+     * @brief Whether incoming records are decrypted by the kernel (kTLS) for this connection.
+     *  Only meaningful once the handshake has completed.
+     */
+    bool IsKernelTlsReceive() const
+    {
+        return isKernelTlsReceive;
+    }
+
 private:
     /* Static members */
     static constexpr int BUFFER_SIZE = 512;
-    static constexpr std::chrono::milliseconds CONNECT_TIMEOUT = 
-        std::chrono::milliseconds(2500);
     /* Private members */
+    const std::shared_ptr<TlsTransportContext> context;
     const bool isServer;
     const int socketHandle;
     sockaddr_in targetAddress;
-    const std::vector<std::byte> preSharedKey;
-    std::atomic<bool> isStopping { false }; // Indicates when SSL has been signaled to shut down
-    std::atomic<bool> isStopped { false }; // Indicates when the socket has been closed
+    bool isStarted = false;
+    std::atomic<bool> isStopping { false }; // Indicates we've been asked to (or begun to) close
+    std::atomic<bool> isClosed { false }; // Indicates when the socket has been closed
+    std::atomic<bool> isHandshakeTimedOut { false };
+    std::atomic<bool> isKernelTlsSend { false };
+    std::atomic<bool> isKernelTlsReceive { false };
+    bool isHandshakeComplete = false;
+    TimerWheel::timer_id_t handshakeTimerId = 0;
     SslPtr ssl;
-    SSL_psk_find_session_cb_func sslPskCallbackFunc;
     std::function<void(const std::vector<std::byte>&)> onBytesReceived;
     std::function<void(void)> onConnectionClosed;
+    std::function<void(bool)> onHandshakeComplete;
+    std::function<void(size_t)> onWriteProgress;
     std::promise<void> connectionThreadEndedPromise;
     std::future<void> connectionThreadEndedFuture;
     std::thread connectionThread;
+    std::thread::id connectionThreadId;
+    int wakeEventHandle = -1;
     std::mutex writeMutex;
-    int writePipeFds[2]; // Pipe used to write to the SSL socket
-
-    /* Private static methods */
-    /**
-     * @brief
-     *  This is a static callback method for SSL. It will pull a reference to the
-     *  TlsConnectionTransport instance out of SSL object's data storage, and use that to
-     *  call the sslPskFindSession member function.
-     */
-    static int sslPskFindSessionCallback(
-        SSL* ssl,
-        const unsigned char *identity,
-        size_t identity_len,
-        SSL_SESSION **sess)
-    {
-        TlsConnectionTransport* that = 
-            reinterpret_cast<TlsConnectionTransport*>(SSL_get_ex_data(ssl, 0));
-        return that->sslPskFindSession(ssl, identity, identity_len, sess);
-    }
-
-    /**
-     * @brief
-     *  This is a static callback method for SSL. It will pull a reference to the
-     *  TlsConnectionTransport instance out of SSL object's data storage, and use that to
-     *  call the sslPskUseSession member function.
-     */
-    static int sslPskUseSessionCallback(
-        SSL* ssl,
-        const EVP_MD* md,
-        const unsigned char** id,
-        size_t* idlen,
-        SSL_SESSION** sess)
-    {
-        TlsConnectionTransport* that = 
-            reinterpret_cast<TlsConnectionTransport*>(SSL_get_ex_data(ssl, 0));
-        return that->sslPskUseSession(ssl, md, id, idlen, sess);
-    }
+    std::vector<std::byte> pendingWrites; // Plaintext waiting for the connection thread
+    // Plaintext written but not yet accepted by SSL_write, including a partially written buffer
+    std::atomic<size_t> pendingWriteSize { 0 };
 
     /**
      * @brief Thread body for processing SSL socket input/output
@@ -245,85 +259,61 @@ private:
         // Indicate when we've exited this thread
         connectionThreadEndedPromise.set_value_at_thread_exit();
 
-        // Keep track of how long it takes to connect, so we can time out
-        std::chrono::time_point<std::chrono::steady_clock> connectStartTime = 
-            std::chrono::steady_clock::now();
-
         // First, we need to connect.
-        int connectResult = isServer ? SSL_accept(ssl.get()) : SSL_connect(ssl.get());
-        while (connectResult == -1)
+        if (!negotiate(sslConnectedPromise))
         {
-            // Have we taken too long?
-            auto elapsedTime = (std::chrono::steady_clock::now() - connectStartTime);
-            if (elapsedTime > CONNECT_TIMEOUT)
-            {
-                // Whoops, took too long to connect.
-                spdlog::debug("{} SSL negotiation timed out");
-                sslConnectedPromise.set_value(false);
-                closeConnection();
-                return;
-            }
+            closeConnection();
+            return;
+        }
 
-            // We're not done connecting yet - figure out what we're waiting on
-            int connectError = SSL_get_error(ssl.get(), connectResult);
-            if (connectError == SSL_ERROR_WANT_READ)
+        // We're connected. Now wait for input/output, sleeping until there's something to do.
+        char readBuf[BUFFER_SIZE];
+        // Plaintext handed to SSL_write; after a partial write it has to be retried unchanged
+        std::vector<std::byte> outgoing;
+        short outgoingEvents = 0;
+        bool isWakeSignalled = false;
+        while (true)
+        {
+            if (isWakeSignalled)
             {
-                // OpenSSL wants to read, but the socket can't yet, so wait for it.
-                pollfd readPollFd
-                {
-                    .fd = socketHandle,
-                    .events = POLLIN,
-                    .revents = 0,
-                };
-                poll(&readPollFd, 1, 100 /*ms*/);
+                drainWake();
             }
-            else if (connectError == SSL_ERROR_WANT_WRITE)
+            if (isStopping)
             {
-                // OpenSSL wants to write, but the socket can't yet, so wait for it.
-                pollfd writePollFd
-                {
-                    .fd = socketHandle,
-                    .events = POLLOUT,
-                    .revents = 0,
-                };
-                poll(&writePollFd, 1, 100 /*ms*/);
+                closeConnection();
+                return;
             }
-            else
+
+            // Writes may have queued up while we were waiting (or negotiating)
+            if (!flushWrites(outgoing, outgoingEvents))
             {
-                // Unexpected error - close this connection.
-                sslConnectedPromise.set_value(false);
                 closeConnection();
                 return;
             }
-            
-            // Try again
-            connectResult = isServer ? SSL_accept(ssl.get()) : SSL_connect(ssl.get());
-        }
 
-        spdlog::debug("{} SSL CONNECTED", socketHandle);
-        sslConnectedPromise.set_value(true);
-
-        // We're connected. Now wait for input/output.
-        char readBuf[BUFFER_SIZE];
-        while (true)
-        {
             pollfd pollFds[]
             {
-                // OpenSSL socket read
+                // OpenSSL socket read, and write if SSL_write is waiting on the socket
                 {
                     .fd = socketHandle,
-                    .events = POLLIN,
+                    .events = static_cast<short>(POLLIN | outgoingEvents),
                     .revents = 0,
                 },
-                // Pending writes
+                // Pending writes, stops
                 {
-                    .fd = writePipeFds[0],
+                    .fd = wakeEventHandle,
                     .events = POLLIN,
                     .revents = 0,
                 },
             };
 
-            poll(pollFds, 2, 200 /*ms*/);
+            if ((poll(pollFds, 2, -1 /*no timeout*/) < 0) && (errno != EINTR))
+            {
+                spdlog::error("{} poll failed with error {}", socketHandle, errno);
+                closeConnection();
+                return;
+            }
+            isWakeSignalled = ((pollFds[1].revents & POLLIN) > 0);
 
             // Did the socket get closed?
             if (((pollFds[0].revents & POLLERR) > 0) || 
@@ -386,205 +376,261 @@ private:
                     }
                 }
             }
-
-            // Data available for writing?
-            if (pollFds[1].revents & POLLIN)
-            {
-                int readResult;
-                std::byte writeBuffer[BUFFER_SIZE];
-                {
-                    std::lock_guard<std::mutex> lock(writeMutex);
-                    readResult = read(writePipeFds[0], writeBuffer, sizeof(writeBuffer));
-                }
-                if (readResult < 0)
-                {
-                    int readError = errno;
-                    spdlog::error(
-                        "Read from write pipe failed with error {}",
-                        readError);
-                    closeConnection();
-                    return;
-                }
-                else if (readResult > 0)
-                {
-                    int sslWriteResult = SSL_write(ssl.get(), writeBuffer, readResult);
-                    int writeError = SSL_get_error(ssl.get(), sslWriteResult);
-                    if ((writeError == SSL_ERROR_NONE) ||
-                        (writeError == SSL_ERROR_WANT_READ) ||
-                        (writeError == SSL_ERROR_WANT_WRITE))
-                    {
-                        // Success!
-                        spdlog::debug(
-                            "{} WROTE {} / {} bytes",
-                            socketHandle,
-                            sslWriteResult,
-                            readResult);
-                    }
-                    else if (writeError == SSL_ERROR_ZERO_RETURN)
-                    {
-                        // Connection was closed
-                        closeConnection();
-                        return;
-                    }
-                    else
-                    {
-                        // Some other unknown error...
-                        closeConnection();
-                        return;
-                    }
-                }
-            }
         }
     }
 
     /* Private methods */
     /**
-     * @brief Closes the socket and fires connection closed callback
+     * @brief Performs TLS negotiation, waiting on the socket between steps
+     * @return true if the handshake succeeded
      */
-    void closeConnection()
+    bool negotiate(std::promise<bool>& sslConnectedPromise)
     {
-        // Avoid closing the socket twice (in case we were the ones who closed it)
-        if (!isStopping)
+        // Keep track of how long it takes to connect; the timer wakes us if it takes too long
+        std::chrono::time_point<std::chrono::steady_clock> connectStartTime = 
+            std::chrono::steady_clock::now();
+        handshakeTimerId = context->GetTimerWheel().Schedule(
+            context->GetHandshakeTimeout(),
+            [this]()
+            {
+                isHandshakeTimedOut = true;
+                signalWake();
+            });
+
+        int connectResult = isServer ? SSL_accept(ssl.get()) : SSL_connect(ssl.get());
+        while (connectResult != 1)
         {
-            isStopping = true;
-            shutdown(socketHandle, SHUT_RDWR);
-            close(socketHandle);
-            spdlog::debug("{} CLOSED: Triggered by remote\n", socketHandle);
-            if (onConnectionClosed)
+            // We're not done connecting yet - figure out what we're waiting on
+            int connectError = SSL_get_error(ssl.get(), connectResult);
+            short socketEvents;
+            if (connectError == SSL_ERROR_WANT_READ)
+            {
+                // OpenSSL wants to read, but the socket can't yet, so wait for it.
+                socketEvents = POLLIN;
+            }
+            else if (connectError == SSL_ERROR_WANT_WRITE)
             {
-                spdlog::debug("{} transport running onConnectionClosed callback...", socketHandle);
-                onConnectionClosed();
+                // OpenSSL wants to write, but the socket can't yet, so wait for it.
+                socketEvents = POLLOUT;
             }
+            else
+            {
+                // Unexpected error - close this connection.
+                finishHandshake(sslConnectedPromise, false);
+                return false;
+            }
+
+            pollfd pollFds[]
+            {
+                {
+                    .fd = socketHandle,
+                    .events = socketEvents,
+                    .revents = 0,
+                },
+                {
+                    .fd = wakeEventHandle,
+                    .events = POLLIN,
+                    .revents = 0,
+                },
+            };
+            if ((poll(pollFds, 2, -1 /*no timeout*/) < 0) && (errno != EINTR))
+            {
+                finishHandshake(sslConnectedPromise, false);
+                return false;
+            }
+            if (pollFds[1].revents & POLLIN)
+            {
+                // Writes stay queued until we're connected
+                drainWake();
+            }
+            if (isHandshakeTimedOut)
+            {
+                // Whoops, took too long to connect.
+                spdlog::debug("{} SSL negotiation timed out", socketHandle);
+                finishHandshake(sslConnectedPromise, false);
+                return false;
+            }
+            if (isStopping)
+            {
+                finishHandshake(sslConnectedPromise, false);
+                return false;
+            }
+
+            // Try again
+            connectResult = isServer ? SSL_accept(ssl.get()) : SSL_connect(ssl.get());
         }
 
-        if (!isStopped)
+        static MetricHistogram& handshakeDuration = MetricsRegistry::Default().GetHistogram(
+            "ftl_orchestrator_tls_handshake_duration_seconds",
+            "Time taken to complete TLS negotiation on a new connection",
+            std::string(),
+            1e-9);
+        handshakeDuration.RecordSince(connectStartTime);
+        spdlog::debug("{} SSL CONNECTED", socketHandle);
+        isHandshakeComplete = true;
+        if (context->IsKernelTlsEnabled())
         {
-            // Once we reach this point, we know the socket has finished closing.
-            // Close our write pipes
-            spdlog::debug("{} CLOSED WRITE PIPES", socketHandle);
-            close(writePipeFds[0]);
-            close(writePipeFds[1]);
-            isStopped = true;
+            recordKernelTlsState();
         }
+        finishHandshake(sslConnectedPromise, true);
+        return true;
     }
 
     /**
-     * @brief
-     *  This function handles a callback by SSL server connections to provide the pre-shared key
+     * @brief Reports the outcome of TLS negotiation to StartAsync() and the handshake callback
      */
-    int sslPskFindSession(
-        SSL *ssl,
-        const unsigned char *identity,
-        size_t identity_len,
-        SSL_SESSION **sess)
+    void finishHandshake(std::promise<bool>& sslConnectedPromise, bool isSuccess)
     {
-        spdlog::debug(
-            "sslPskFindSession: Using key {}",
-            spdlog::to_hex(preSharedKey.begin(), preSharedKey.end()));
-
-        // Find the cipher we'll be using
-        // identified by IANA mapping: https://testssl.sh/openssl-iana.mapping.html
-        const unsigned char tls13_aes128gcmsha256_id[] = { 0x13, 0x01 };
-        const SSL_CIPHER* cipher = SSL_CIPHER_find(ssl, tls13_aes128gcmsha256_id);
-        if (cipher == nullptr)
+        // Waits out the timeout callback if it's running, since it touches this transport
+        context->GetTimerWheel().Cancel(handshakeTimerId);
+        sslConnectedPromise.set_value(isSuccess);
+        if (onHandshakeComplete)
         {
-            spdlog::error("OpenSSL could not find cipher suite!");
-            return 0;
+            onHandshakeComplete(isSuccess);
         }
+    }
 
-        // Create an SSL session and set some parameters on it
-        SslSessionPtr temporarySslSession(SSL_SESSION_new());
-        if (temporarySslSession == nullptr)
+    /**
+     * @brief
+     *  Hands queued plaintext to OpenSSL until everything is written or the socket is full
+     * @param outgoing plaintext being written, kept between calls if the socket fills up
+     * @param outgoingEvents set to the poll events the pending write is waiting on
+     * @return false if the connection should be closed
+     */
+    bool flushWrites(std::vector<std::byte>& outgoing, short& outgoingEvents)
+    {
+        outgoingEvents = 0;
+        while (true)
         {
-            spdlog::error("Could not create new SSL session!");
-            return 0;
-        }
+            if (outgoing.empty())
+            {
+                std::lock_guard<std::mutex> lock(writeMutex);
+                outgoing.swap(pendingWrites);
+            }
+            if (outgoing.empty())
+            {
+                return true;
+            }
 
-        if (!SSL_SESSION_set1_master_key(
-            temporarySslSession.get(),
-            reinterpret_cast<const unsigned char*>(preSharedKey.data()),
-            preSharedKey.size()))
-        {
-            spdlog::error("Could not set key on new SSL session!");
-            return 0;
+            int sslWriteResult = SSL_write(ssl.get(), outgoing.data(), outgoing.size());
+            int writeError = SSL_get_error(ssl.get(), sslWriteResult);
+            if (writeError == SSL_ERROR_NONE)
+            {
+                // Success!
+                spdlog::debug("{} WROTE {} bytes", socketHandle, sslWriteResult);
+                size_t remainingSize = (pendingWriteSize -= outgoing.size());
+                outgoing.clear();
+                if (onWriteProgress)
+                {
+                    // May Write() more, which the next pass of this loop picks up
+                    onWriteProgress(remainingSize);
+                }
+            }
+            else if (writeError == SSL_ERROR_WANT_WRITE)
+            {
+                // The socket is full; try again once it drains
+                outgoingEvents = POLLOUT;
+                return true;
+            }
+            else if (writeError == SSL_ERROR_WANT_READ)
+            {
+                // Try again once the peer has sent what OpenSSL is waiting for
+                return true;
+            }
+            else
+            {
+                // Connection was closed, or some other unknown error...
+                return false;
+            }
         }
+    }
 
-        if (!SSL_SESSION_set_cipher(temporarySslSession.get(), cipher))
+    void signalWake()
+    {
+        uint64_t value = 1;
+        if (write(wakeEventHandle, &value, sizeof(value)) < 0)
         {
-            spdlog::error("Could not set cipher on new SSL session!");
-            return 0;
+            spdlog::error("{} Failed to signal connection wake eventfd", socketHandle);
         }
+    }
 
-        if (!SSL_SESSION_set_protocol_version(temporarySslSession.get(), TLS1_3_VERSION))
-        {
-            spdlog::error("Could not set version on new SSL session!");
-            return 0;
-        }
-        
-        // Release ownership since we are no longer responsible for this session
-        *sess = temporarySslSession.release();
-        return 1;
+    void drainWake()
+    {
+        uint64_t value;
+        // EAGAIN just means another wake already drained it
+        [[maybe_unused]] ssize_t readResult = read(wakeEventHandle, &value, sizeof(value));
     }
 
     /**
-     * @brief 
-     *  This function handles a callback by SSL client connections to provide the pre-shared key
+     * @brief Notes which directions OpenSSL handed off to kernel TLS after the handshake
      */
-    int sslPskUseSession(
-        SSL* ssl,
-        const EVP_MD* md,
-        const unsigned char** id,
-        size_t* idlen,
-        SSL_SESSION** sess)
+    void recordKernelTlsState()
     {
-        spdlog::debug(
-            "sslPskUseSession: Using key {}",
-            spdlog::to_hex(preSharedKey.begin(), preSharedKey.end()));
-
-        // Find the cipher we'll be using
-        // identified by IANA mapping: https://testssl.sh/openssl-iana.mapping.html
-        const unsigned char tls13_aes128gcmsha256_id[] = { 0x13, 0x01 };
-        const SSL_CIPHER* cipher = SSL_CIPHER_find(ssl, tls13_aes128gcmsha256_id);
-        if (cipher == nullptr)
+        isKernelTlsSend = (BIO_get_ktls_send(SSL_get_wbio(ssl.get())) == 1);
+        isKernelTlsReceive = (BIO_get_ktls_recv(SSL_get_rbio(ssl.get())) == 1);
+
+        static MetricCounter& kernelTlsSendReceive = MetricsRegistry::Default().GetCounter(
+            "ftl_orchestrator_tls_ktls_connections_total",
+            "Connections by which record layer directions were offloaded to kernel TLS",
+            "mode=\"send_receive\"");
+        static MetricCounter& kernelTlsSendOnly = MetricsRegistry::Default().GetCounter(
+            "ftl_orchestrator_tls_ktls_connections_total",
+            "Connections by which record layer directions were offloaded to kernel TLS",
+            "mode=\"send_only\"");
+        static MetricCounter& kernelTlsReceiveOnly = MetricsRegistry::Default().GetCounter(
+            "ftl_orchestrator_tls_ktls_connections_total",
+            "Connections by which record layer directions were offloaded to kernel TLS",
+            "mode=\"receive_only\"");
+        static MetricCounter& kernelTlsUserspace = MetricsRegistry::Default().GetCounter(
+            "ftl_orchestrator_tls_ktls_connections_total",
+            "Connections by which record layer directions were offloaded to kernel TLS",
+            "mode=\"userspace\"");
+        if (isKernelTlsSend && isKernelTlsReceive)
         {
-            spdlog::error("OpenSSL could not find cipher suite!");
-            return 0;
+            kernelTlsSendReceive.Increment();
         }
-
-        // Create an SSL session and set some parameters on it
-        SslSessionPtr temporarySslSession(SSL_SESSION_new());
-        if (temporarySslSession == nullptr)
+        else if (isKernelTlsSend)
         {
-            spdlog::error("Could not create new SSL session!");
-            return 0;
+            kernelTlsSendOnly.Increment();
         }
-
-        if (!SSL_SESSION_set1_master_key(
-            temporarySslSession.get(),
-            reinterpret_cast<const unsigned char*>(preSharedKey.data()),
-            preSharedKey.size()))
+        else if (isKernelTlsReceive)
         {
-            spdlog::error("Could not set key on new SSL session!");
-            return 0;
+            kernelTlsReceiveOnly.Increment();
         }
-
-        if (!SSL_SESSION_set_cipher(temporarySslSession.get(), cipher))
+        else
         {
-            spdlog::error("Could not set cipher on new SSL session!");
-            return 0;
+            kernelTlsUserspace.Increment();
         }
+        spdlog::debug(
+            "{} kTLS offload: send {}, receive {}",
+            socketHandle,
+            isKernelTlsSend ? "kernel" : "userspace",
+            isKernelTlsReceive ? "kernel" : "userspace");
+    }
 
-        if (!SSL_SESSION_set_protocol_version(temporarySslSession.get(), TLS1_3_VERSION))
+    /**
+     * @brief
+     *  Closes the socket. Fires the connection closed callback unless we were asked to stop.
+     *  Connection thread only.
+     */
+    void closeConnection()
+    {
+        bool isRemoteClose = !isStopping.exchange(true);
+        if (!isRemoteClose && isHandshakeComplete)
         {
-            spdlog::error("Could not set version on new SSL session!");
-            return 0;
+            SSL_shutdown(ssl.get());
+        }
+        shutdown(socketHandle, SHUT_RDWR);
+        close(socketHandle);
+        isClosed = true;
+        spdlog::debug(
+            "{} CLOSED: Triggered by {}",
+            socketHandle,
+            isRemoteClose ? "remote" : "local");
+        if (isRemoteClose && onConnectionClosed)
+        {
+            spdlog::debug("{} transport running onConnectionClosed callback...", socketHandle);
+            onConnectionClosed();
         }
-
-        // Release ownership since we are no longer responsible for this session
-        *sess = temporarySslSession.release();
-        *id = reinterpret_cast<const unsigned char*>("orchestrator");
-        *idlen = 12;
-
-        return 1;
     }
 };
\ No newline at end of file
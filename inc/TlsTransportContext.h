@@ -0,0 +1,264 @@
+/**
+ * @file TlsTransportContext.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#pragma once
+
+#include "OpenSslPtr.h"
+#include "TimerWheel.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief
+ *  TlsTransportContext holds the TLS state that is identical for every connection using the same
+ *  pre-shared key: a configured SSL_CTX and a prebuilt PSK session. Building these once and
+ *  sharing them between TlsConnectionTransports keeps cipher suite parsing and session setup
+ *  out of the per-handshake path. Connections also share a TimerWheel for their deadlines, so
+ *  none of them need to wake up periodically to check the time.
+ */
+class TlsTransportContext
+{
+public:
+    /* Constructor/Destructor */
+    /**
+     * @brief Construct a new TlsTransportContext object
+     * @param isServer true if connections using this context accept, false if they connect
+     * @param preSharedKey pre-shared key for TLS PSK encryption
+     * @param handshakeTimeout how long a connection may take to complete TLS negotiation
+     * @param enableKernelTls
+     *  ask OpenSSL to hand the record layer to the kernel (kTLS) once a handshake completes.
+     *  Connections fall back to userspace encryption when the kernel can't take them.
+     */
+    TlsTransportContext(
+        bool isServer,
+        std::vector<std::byte> preSharedKey,
+        std::chrono::milliseconds handshakeTimeout = DEFAULT_HANDSHAKE_TIMEOUT,
+        bool enableKernelTls = false
+    ) :
+        isServer(isServer),
+        handshakeTimeout(handshakeTimeout),
+        isKernelTlsEnabled(enableKernelTls)
+    {
+        sslContext = SslCtxPtr(SSL_CTX_new(isServer ? TLS_server_method() : TLS_client_method()));
+        if (sslContext == nullptr)
+        {
+            throw std::runtime_error("Could not create SSL context!");
+        }
+
+        // Disable old protocols
+        SSL_CTX_set_min_proto_version(sslContext.get(), TLS1_3_VERSION);
+        SSL_CTX_set_max_proto_version(sslContext.get(), TLS1_3_VERSION);
+
+        // Restrict to secure PSK ciphers
+        if (!SSL_CTX_set_ciphersuites(sslContext.get(), "TLS_AES_128_GCM_SHA256"))
+        {
+            char sslErrStr[256];
+            unsigned long sslErr = ERR_get_error();
+            ERR_error_string_n(sslErr, sslErrStr, sizeof(sslErrStr));
+            throw std::runtime_error(sslErrStr);
+        }
+
+        if (isKernelTlsEnabled)
+        {
+            enableKernelTlsOffload();
+        }
+
+        // Set up callback to locate pre-shared key. Callbacks find their way back to us through
+        // the SSL_CTX's ex data, since every SSL created from it shares this context.
+        SSL_CTX_set_ex_data(sslContext.get(), 0, this);
+        if (isServer)
+        {
+            SSL_CTX_set_psk_find_session_callback(
+                sslContext.get(),
+                &TlsTransportContext::sslPskFindSessionCallback);
+        }
+        else
+        {
+            SSL_CTX_set_psk_use_session_callback(
+                sslContext.get(),
+                &TlsTransportContext::sslPskUseSessionCallback);
+        }
+
+        pskSession = buildPskSession(preSharedKey);
+    }
+
+    TlsTransportContext(const TlsTransportContext&) = delete;
+    TlsTransportContext& operator=(const TlsTransportContext&) = delete;
+
+    /* Public methods */
+    bool IsServer() const
+    {
+        return isServer;
+    }
+
+    std::chrono::milliseconds GetHandshakeTimeout() const
+    {
+        return handshakeTimeout;
+    }
+
+    bool IsKernelTlsEnabled() const
+    {
+        return isKernelTlsEnabled;
+    }
+
+    /**
+     * @brief Timers for connections using this context, such as handshake timeouts
+     */
+    TimerWheel& GetTimerWheel()
+    {
+        return timerWheel;
+    }
+
+    /**
+     * @brief Creates a new SSL instance for a single connection
+     */
+    SslPtr NewSsl() const
+    {
+        SslPtr ssl(SSL_new(sslContext.get()));
+        if (ssl == nullptr)
+        {
+            throw std::runtime_error("Could not create SSL instance!");
+        }
+        return ssl;
+    }
+
+    /* Static members */
+    static constexpr std::chrono::milliseconds DEFAULT_HANDSHAKE_TIMEOUT = 
+        std::chrono::milliseconds(2500);
+
+private:
+    /* Private members */
+    const bool isServer;
+    const std::chrono::milliseconds handshakeTimeout;
+    bool isKernelTlsEnabled;
+    SslCtxPtr sslContext;
+    SslSessionPtr pskSession;
+    TimerWheel timerWheel;
+
+    /* Private static methods */
+    /**
+     * @brief
+     *  This is a static callback method for SSL server connections to provide the pre-shared key.
+     *  OpenSSL duplicates external PSK sessions handed to it on the server side, so the template
+     *  can be shared by reference.
+     */
+    static int sslPskFindSessionCallback(
+        SSL* ssl,
+        const unsigned char* identity,
+        size_t identity_len,
+        SSL_SESSION** sess)
+    {
+        TlsTransportContext* that = reinterpret_cast<TlsTransportContext*>(
+            SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), 0));
+        if (!SSL_SESSION_up_ref(that->pskSession.get()))
+        {
+            spdlog::error("Could not reference PSK session!");
+            return 0;
+        }
+        *sess = that->pskSession.get();
+        return 1;
+    }
+
+    /**
+     * @brief
+     *  This is a static callback method for SSL client connections to provide the pre-shared key.
+     *  The client adopts this session as its own once the handshake completes, so each
+     *  connection gets a copy of the template.
+     */
+    static int sslPskUseSessionCallback(
+        SSL* ssl,
+        const EVP_MD* md,
+        const unsigned char** id,
+        size_t* idlen,
+        SSL_SESSION** sess)
+    {
+        TlsTransportContext* that = reinterpret_cast<TlsTransportContext*>(
+            SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), 0));
+        SSL_SESSION* sessionCopy = SSL_SESSION_dup(that->pskSession.get());
+        if (sessionCopy == nullptr)
+        {
+            spdlog::error("Could not copy PSK session!");
+            return 0;
+        }
+        *sess = sessionCopy;
+        *id = reinterpret_cast<const unsigned char*>("orchestrator");
+        *idlen = 12;
+        return 1;
+    }
+
+    /* Private methods */
+    /**
+     * @brief Turns on kTLS for connections created from this context, if OpenSSL supports it
+     */
+    void enableKernelTlsOffload()
+    {
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+        SSL_CTX_set_options(sslContext.get(), SSL_OP_ENABLE_KTLS);
+        // OpenSSL quietly falls back to userspace when the kernel can't take a connection; the
+        // most common reason is the tls module not being loaded, so call that out up front
+        if (!std::filesystem::exists("/sys/module/tls"))
+        {
+            spdlog::warn(
+                "Kernel TLS requested, but the tls kernel module does not appear to be loaded. "
+                "Connections will use userspace encryption until it is (modprobe tls).");
+        }
+#else
+        spdlog::warn("Kernel TLS requested, but OpenSSL was built without kTLS support.");
+        isKernelTlsEnabled = false;
+#endif
+    }
+
+    /**
+     * @brief Builds the session template describing our pre-shared key
+     */
+    SslSessionPtr buildPskSession(const std::vector<std::byte>& preSharedKey)
+    {
+        // Find the cipher we'll be using
+        // identified by IANA mapping: https://testssl.sh/openssl-iana.mapping.html
+        const unsigned char tls13_aes128gcmsha256_id[] = { 0x13, 0x01 };
+        SslPtr lookupSsl = NewSsl();
+        const SSL_CIPHER* cipher = SSL_CIPHER_find(lookupSsl.get(), tls13_aes128gcmsha256_id);
+        if (cipher == nullptr)
+        {
+            throw std::runtime_error("OpenSSL could not find cipher suite!");
+        }
+
+        // Create an SSL session and set some parameters on it
+        SslSessionPtr session(SSL_SESSION_new());
+        if (session == nullptr)
+        {
+            throw std::runtime_error("Could not create new SSL session!");
+        }
+
+        if (!SSL_SESSION_set1_master_key(
+            session.get(),
+            reinterpret_cast<const unsigned char*>(preSharedKey.data()),
+            preSharedKey.size()))
+        {
+            throw std::runtime_error("Could not set key on new SSL session!");
+        }
+
+        if (!SSL_SESSION_set_cipher(session.get(), cipher))
+        {
+            throw std::runtime_error("Could not set cipher on new SSL session!");
+        }
+
+        if (!SSL_SESSION_set_protocol_version(session.get(), TLS1_3_VERSION))
+        {
+            throw std::runtime_error("Could not set version on new SSL session!");
+        }
+
+        return session;
+    }
+};
@@ -0,0 +1,189 @@
+/**
+ * @file UnixConnectionTransport.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#pragma once
+
+#include "IConnectionTransport.h"
+
+#include <atomic>
+#include <future>
+#include <functional>
+#include <mutex>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * @brief
+ *  UnixConnectionTransport represents a plaintext connection to a single FTL instance over an
+ *  AF_UNIX stream socket. Both ends are on the same host, so there is no encryption; peers are
+ *  authenticated by their credentials when accepted (see UnixConnectionManager).
+ */
+class UnixConnectionTransport : public IConnectionTransport
+{
+public:
+    /* Constructor/Destructor */
+    /**
+     * @brief Construct a new UnixConnectionTransport object
+     * @param socketHandle the handle to the connected socket, owned by this transport
+     * @param peerUid user id of the process on the other end, if known
+     */
+    UnixConnectionTransport(int socketHandle, uid_t peerUid = 0) :
+        socketHandle(socketHandle),
+        peerUid(peerUid)
+    { }
+
+    ~UnixConnectionTransport()
+    {
+        // Closed here rather than on the connection thread so Stop() and Write() never race
+        // with the handle being reused
+        close(socketHandle);
+    }
+
+    /* IConnectionTransport */
+    void StartAsync() override
+    {
+        isStarted = true;
+        connectionThreadEndedFuture = connectionThreadEndedPromise.get_future();
+        connectionThread = std::thread(&UnixConnectionTransport::connectionThreadBody, this);
+        connectionThreadId = connectionThread.get_id();
+        connectionThread.detach();
+    }
+
+    void Stop() override
+    {
+        if (!isStarted)
+        {
+            return;
+        }
+        if (!isStopping.exchange(true))
+        {
+            // Wakes the connection thread
+            shutdown(socketHandle, SHUT_RDWR);
+        }
+        if (std::this_thread::get_id() != connectionThreadId)
+        {
+            connectionThreadEndedFuture.wait();
+        }
+    }
+
+    void Write(const std::vector<std::byte>& bytes) override
+    {
+        if (isStopping)
+        {
+            return;
+        }
+
+        // Writes go straight to the socket; the kernel buffer absorbs bursts
+        std::lock_guard<std::mutex> lock(writeMutex);
+        size_t written = 0;
+        while (written < bytes.size())
+        {
+            ssize_t writeResult = send(
+                socketHandle,
+                (bytes.data() + written),
+                (bytes.size() - written),
+                MSG_NOSIGNAL);
+            if (writeResult < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                spdlog::debug("{} Unix socket write failed: {}", socketHandle, errno);
+                shutdown(socketHandle, SHUT_RDWR);
+                return;
+            }
+            written += static_cast<size_t>(writeResult);
+        }
+    }
+
+    size_t GetPendingWriteSize() override
+    {
+        // Write() doesn't return until the kernel has taken everything
+        return 0;
+    }
+
+    void SetOnWriteProgress(std::function<void(size_t)>) override
+    { }
+
+    void SetOnBytesReceived(
+        std::function<void(const std::vector<std::byte>&)> onBytesReceived) override
+    {
+        this->onBytesReceived = onBytesReceived;
+    }
+
+    void SetOnConnectionClosed(std::function<void(void)> onConnectionClosed) override
+    {
+        this->onConnectionClosed = onConnectionClosed;
+    }
+
+    /* Public methods */
+    uid_t GetPeerUid() const
+    {
+        return peerUid;
+    }
+
+private:
+    /* Static members */
+    static constexpr int BUFFER_SIZE = 16384;
+    /* Private members */
+    const int socketHandle;
+    const uid_t peerUid;
+    bool isStarted = false;
+    std::atomic<bool> isStopping { false };
+    std::function<void(const std::vector<std::byte>&)> onBytesReceived;
+    std::function<void(void)> onConnectionClosed;
+    std::promise<void> connectionThreadEndedPromise;
+    std::future<void> connectionThreadEndedFuture;
+    std::thread connectionThread;
+    std::thread::id connectionThreadId;
+    std::mutex writeMutex;
+
+    /**
+     * @brief Thread body for reading from the socket until either end closes it
+     */
+    void connectionThreadBody()
+    {
+        connectionThreadEndedPromise.set_value_at_thread_exit();
+
+        std::byte readBuf[BUFFER_SIZE];
+        while (true)
+        {
+            ssize_t bytesRead = recv(socketHandle, readBuf, sizeof(readBuf), 0);
+            if (bytesRead > 0)
+            {
+                if (onBytesReceived)
+                {
+                    onBytesReceived(std::vector<std::byte>(readBuf, (readBuf + bytesRead)));
+                }
+                continue;
+            }
+            if ((bytesRead < 0) && (errno == EINTR))
+            {
+                continue;
+            }
+            break;
+        }
+
+        // Only closes we didn't ask for are reported
+        bool isRemoteClose = !isStopping.exchange(true);
+        shutdown(socketHandle, SHUT_RDWR);
+        spdlog::debug(
+            "{} CLOSED: Triggered by {}",
+            socketHandle,
+            isRemoteClose ? "remote" : "local");
+        if (isRemoteClose && onConnectionClosed)
+        {
+            onConnectionClosed();
+        }
+    }
+};
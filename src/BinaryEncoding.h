@@ -0,0 +1,168 @@
+/**
+ * @file BinaryEncoding.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @brief Helpers for the orchestrator's binary formats (snapshots, the event journal and state
+ *  replication)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Appends big-endian integers and length-prefixed strings and bytes to a buffer
+ */
+class BinaryWriter
+{
+public:
+    template <class TInteger>
+    void Write(TInteger value)
+    {
+        for (int shift = ((sizeof(TInteger) - 1) * 8); shift >= 0; shift -= 8)
+        {
+            buffer.push_back(static_cast<std::byte>((value >> shift) & 0xff));
+        }
+    }
+
+    void Write(const std::string& value)
+    {
+        writeLength(value.size());
+        for (char character : value)
+        {
+            buffer.push_back(static_cast<std::byte>(character));
+        }
+    }
+
+    void Write(const std::vector<std::byte>& value)
+    {
+        writeLength(value.size());
+        buffer.insert(buffer.end(), value.begin(), value.end());
+    }
+
+    /**
+     * @brief Writes seven bits per byte, so small values take a single byte
+     */
+    void WriteVarint(uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            buffer.push_back(static_cast<std::byte>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        buffer.push_back(static_cast<std::byte>(value));
+    }
+
+    std::vector<std::byte>& GetBuffer()
+    {
+        return buffer;
+    }
+
+    /**
+     * @brief FNV-1a, enough to catch a torn or truncated write
+     */
+    static uint64_t Checksum(const std::byte* bytes, size_t length)
+    {
+        uint64_t hash = 0xcbf29ce484222325;
+        for (size_t i = 0; i < length; ++i)
+        {
+            hash ^= static_cast<uint64_t>(bytes[i]);
+            hash *= 0x100000001b3;
+        }
+        return hash;
+    }
+
+private:
+    std::vector<std::byte> buffer;
+
+    void writeLength(size_t length)
+    {
+        if (length > std::numeric_limits<uint16_t>::max())
+        {
+            throw std::runtime_error("Field is too long to be encoded");
+        }
+        Write(static_cast<uint16_t>(length));
+    }
+};
+
+/**
+ * @brief Reads what BinaryWriter wrote, throwing if the buffer runs out
+ */
+class BinaryReader
+{
+public:
+    BinaryReader(const std::byte* bytes, size_t length) :
+        bytes(bytes),
+        length(length)
+    { }
+
+    template <class TInteger>
+    TInteger Read()
+    {
+        require(sizeof(TInteger));
+        TInteger value = 0;
+        for (size_t i = 0; i < sizeof(TInteger); ++i)
+        {
+            value = static_cast<TInteger>(
+                (value << 8) | static_cast<TInteger>(bytes[offset++]));
+        }
+        return value;
+    }
+
+    uint64_t ReadVarint()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            uint8_t byte = Read<uint8_t>();
+            value |= (static_cast<uint64_t>(byte & 0x7f) << shift);
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+        throw std::runtime_error("Varint is too long");
+    }
+
+    std::string ReadString()
+    {
+        size_t stringLength = Read<uint16_t>();
+        require(stringLength);
+        std::string value(reinterpret_cast<const char*>(bytes + offset), stringLength);
+        offset += stringLength;
+        return value;
+    }
+
+    std::vector<std::byte> ReadBytes()
+    {
+        size_t bytesLength = Read<uint16_t>();
+        require(bytesLength);
+        std::vector<std::byte> value(bytes + offset, bytes + offset + bytesLength);
+        offset += bytesLength;
+        return value;
+    }
+
+    bool IsAtEnd() const
+    {
+        return (offset == length);
+    }
+
+private:
+    const std::byte* bytes;
+    const size_t length;
+    size_t offset = 0;
+
+    void require(size_t count)
+    {
+        if ((length - offset) < count)
+        {
+            throw std::runtime_error("Unexpected end of data");
+        }
+    }
+};
@@ -0,0 +1,114 @@
+/**
+ * @file CompositeConnectionManager.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include "CompositeConnectionManager.h"
+
+#include "FtlConnection.h"
+
+#include <exception>
+#include <future>
+
+#pragma region Constructor/Destructor
+template <class T>
+CompositeConnectionManager<T>::CompositeConnectionManager(
+    std::vector<std::unique_ptr<IConnectionManager<T>>> connectionManagers
+) :
+    connectionManagers(std::move(connectionManagers))
+{ }
+#pragma endregion
+
+#pragma region IConnectionManager
+template <class T>
+void CompositeConnectionManager<T>::Init()
+{
+    for (const auto& connectionManager : connectionManagers)
+    {
+        connectionManager->Init();
+    }
+}
+
+template <class T>
+void CompositeConnectionManager<T>::Listen(std::promise<void>&& readyPromise)
+{
+    std::vector<std::future<void>> readyFutures;
+    std::vector<std::future<void>> listeners;
+    for (const auto& connectionManager : connectionManagers)
+    {
+        std::promise<void> managerReadyPromise;
+        readyFutures.push_back(managerReadyPromise.get_future());
+        listeners.push_back(std::async(
+            std::launch::async,
+            [this, &connectionManager, managerReadyPromise = std::move(managerReadyPromise)]()
+                mutable
+            {
+                try
+                {
+                    connectionManager->Listen(std::move(managerReadyPromise));
+                }
+                catch (...)
+                {
+                    // Bring the other listeners down with us rather than wait on them forever
+                    StopListening();
+                    throw;
+                }
+            }));
+    }
+
+    // We're ready once everyone is (or has given up trying)
+    for (auto& readyFuture : readyFutures)
+    {
+        readyFuture.wait();
+    }
+    readyPromise.set_value();
+
+    // Report the first failure once every listener has stopped
+    std::exception_ptr firstError;
+    for (auto& listener : listeners)
+    {
+        try
+        {
+            listener.get();
+        }
+        catch (...)
+        {
+            if (!firstError)
+            {
+                firstError = std::current_exception();
+            }
+        }
+    }
+    if (firstError)
+    {
+        std::rethrow_exception(firstError);
+    }
+}
+
+template <class T>
+void CompositeConnectionManager<T>::StopListening()
+{
+    for (const auto& connectionManager : connectionManagers)
+    {
+        connectionManager->StopListening();
+    }
+}
+
+template <class T>
+void CompositeConnectionManager<T>::SetOnNewConnection(
+    std::function<void(std::shared_ptr<T>)> onNewConnection)
+{
+    for (const auto& connectionManager : connectionManagers)
+    {
+        connectionManager->SetOnNewConnection(onNewConnection);
+    }
+}
+#pragma endregion
+
+#pragma region Template instantiations
+// Yeah, this is weird, but necessary.
+// See https://stackoverflow.com/questions/495021/why-can-templates-only-be-implemented-in-the-header-file
+template class CompositeConnectionManager<FtlConnection>;
+#pragma endregion
@@ -0,0 +1,39 @@
+/**
+ * @file CompositeConnectionManager.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#pragma once
+
+#include "IConnectionManager.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief
+ *  Runs several connection managers as one, so the orchestrator can accept connections over
+ *  more than one transport (e.g. TLS for remote nodes alongside a Unix socket for co-located
+ *  ones). Each manager listens on its own thread.
+ */
+template <class TConnection>
+class CompositeConnectionManager : public IConnectionManager<TConnection>
+{
+public:
+    /* Constructor/Destructor */
+    CompositeConnectionManager(
+        std::vector<std::unique_ptr<IConnectionManager<TConnection>>> connectionManagers);
+
+    /* IConnectionManager */
+    void Init() override;
+    void Listen(std::promise<void>&& readyPromise = std::promise<void>()) override;
+    void StopListening() override;
+    void SetOnNewConnection(
+        std::function<void(std::shared_ptr<TConnection>)> onNewConnection) override;
+
+private:
+    const std::vector<std::unique_ptr<IConnectionManager<TConnection>>> connectionManagers;
+};
@@ -8,6 +8,7 @@
 #include "Configuration.h"
 
 #include <sstream>
+#include <stdexcept>
 
 #pragma region Public methods
 void Configuration::Load()
@@ -31,12 +32,246 @@ void Configuration::Load()
             "Using default Pre-Shared Key. Consider setting your own key using "
             "the environment variable FTL_ORCHESTRATOR_PSK!");
     }
+
+    // FTL_ORCHESTRATOR_LOG_LEVEL -> LogLevel
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_LOG_LEVEL"))
+    {
+        logLevel = spdlog::level::from_str(std::string(varVal));
+    }
+
+    // FTL_ORCHESTRATOR_LOG_QUEUE_SIZE -> LogQueueSize
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_LOG_QUEUE_SIZE"))
+    {
+        logQueueSize = std::stoul(std::string(varVal));
+    }
+
+    // FTL_ORCHESTRATOR_LOG_OVERFLOW -> LogDropOnOverflow
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_LOG_OVERFLOW"))
+    {
+        logDropOnOverflow = (std::string(varVal) != "block");
+    }
+
+    // FTL_ORCHESTRATOR_METRICS_PORT -> MetricsPort
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_METRICS_PORT"))
+    {
+        metricsPort = static_cast<uint16_t>(std::stoul(std::string(varVal)));
+    }
+
+    // FTL_ORCHESTRATOR_MAX_PENDING_HANDSHAKES -> MaxPendingHandshakes
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_MAX_PENDING_HANDSHAKES"))
+    {
+        maxPendingHandshakes = std::stoul(std::string(varVal));
+    }
+
+    // FTL_ORCHESTRATOR_MAX_PENDING_HANDSHAKES_PER_IP -> MaxPendingHandshakesPerAddress
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_MAX_PENDING_HANDSHAKES_PER_IP"))
+    {
+        maxPendingHandshakesPerAddress = std::stoul(std::string(varVal));
+    }
+
+    // FTL_ORCHESTRATOR_HANDSHAKE_TIMEOUT_MS -> HandshakeTimeout
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_HANDSHAKE_TIMEOUT_MS"))
+    {
+        handshakeTimeout = std::chrono::milliseconds(std::stoul(std::string(varVal)));
+    }
+
+    // FTL_ORCHESTRATOR_ACCEPTOR_THREADS -> AcceptorThreadCount
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_ACCEPTOR_THREADS"))
+    {
+        acceptorThreadCount = std::stoul(std::string(varVal));
+    }
+
+    // FTL_ORCHESTRATOR_LISTEN_BACKLOG -> ListenBacklog
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_LISTEN_BACKLOG"))
+    {
+        listenBacklog = std::stoi(std::string(varVal));
+    }
+
+    // FTL_ORCHESTRATOR_KTLS -> KernelTlsEnabled
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_KTLS"))
+    {
+        std::string value(varVal);
+        kernelTlsEnabled = ((value == "1") || (value == "true"));
+    }
+
+    // FTL_ORCHESTRATOR_TRANSPORT -> IoUringTransportEnabled
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_TRANSPORT"))
+    {
+        ioUringTransportEnabled = (std::string(varVal) == "io_uring");
+    }
+
+    // FTL_ORCHESTRATOR_UNIX_SOCKET -> UnixSocketPath
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_UNIX_SOCKET"))
+    {
+        unixSocketPath = std::string(varVal);
+    }
+
+    // FTL_ORCHESTRATOR_UNIX_SOCKET_ALLOWED_UIDS -> UnixSocketAllowedUids
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_UNIX_SOCKET_ALLOWED_UIDS"))
+    {
+        std::stringstream uidStream(varVal);
+        std::string uid;
+        while (std::getline(uidStream, uid, ','))
+        {
+            if (!uid.empty())
+            {
+                unixSocketAllowedUids.insert(static_cast<uid_t>(std::stoul(uid)));
+            }
+        }
+    }
+
+    // FTL_ORCHESTRATOR_HEARTBEAT_INTERVAL_MS -> HeartbeatInterval
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_HEARTBEAT_INTERVAL_MS"))
+    {
+        heartbeatInterval = std::chrono::milliseconds(std::stoul(std::string(varVal)));
+    }
+
+    // FTL_ORCHESTRATOR_HEARTBEAT_MISS_THRESHOLD -> HeartbeatMissThreshold
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_HEARTBEAT_MISS_THRESHOLD"))
+    {
+        heartbeatMissThreshold = std::stoul(std::string(varVal));
+    }
+
+    // FTL_ORCHESTRATOR_TCP_KEEPALIVE_SECONDS -> TcpKeepAliveInterval
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_TCP_KEEPALIVE_SECONDS"))
+    {
+        tcpKeepAliveInterval = std::chrono::seconds(std::stoul(std::string(varVal)));
+    }
+
+    // FTL_ORCHESTRATOR_TCP_USER_TIMEOUT_MS -> TcpUserTimeout
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_TCP_USER_TIMEOUT_MS"))
+    {
+        tcpUserTimeout = std::chrono::milliseconds(std::stoul(std::string(varVal)));
+    }
+
+    // FTL_ORCHESTRATOR_RELAY_BATCH_WINDOW_MS -> RelayBatchWindow
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_RELAY_BATCH_WINDOW_MS"))
+    {
+        relayBatchWindow = std::chrono::milliseconds(std::stoul(std::string(varVal)));
+    }
+
+    // FTL_ORCHESTRATOR_ROUTE_LINGER_MS -> RouteLinger
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_ROUTE_LINGER_MS"))
+    {
+        routeLinger = std::chrono::milliseconds(std::stoul(std::string(varVal)));
+    }
+
+    // FTL_ORCHESTRATOR_CHANNEL_ROUTE_LINGER_MS -> ChannelRouteLinger
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_CHANNEL_ROUTE_LINGER_MS"))
+    {
+        std::stringstream lingerStream(varVal);
+        std::string channelLinger;
+        while (std::getline(lingerStream, channelLinger, ','))
+        {
+            size_t separatorPos = channelLinger.find(':');
+            if (separatorPos == std::string::npos)
+            {
+                throw std::invalid_argument(
+                    "FTL_ORCHESTRATOR_CHANNEL_ROUTE_LINGER_MS entries must be <channel>:<ms>");
+            }
+            uint32_t channelId =
+                static_cast<uint32_t>(std::stoul(channelLinger.substr(0, separatorPos)));
+            channelRouteLinger[channelId] =
+                std::chrono::milliseconds(std::stoul(channelLinger.substr(separatorPos + 1)));
+        }
+    }
+
+    // FTL_ORCHESTRATOR_SNAPSHOT_PATH -> SnapshotPath
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_SNAPSHOT_PATH"))
+    {
+        snapshotPath = std::string(varVal);
+    }
+
+    // FTL_ORCHESTRATOR_SNAPSHOT_INTERVAL_MS -> SnapshotInterval
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_SNAPSHOT_INTERVAL_MS"))
+    {
+        snapshotInterval = std::chrono::milliseconds(std::stoul(std::string(varVal)));
+    }
+
+    // FTL_ORCHESTRATOR_SNAPSHOT_RECONCILE_TIMEOUT_MS -> SnapshotReconcileTimeout
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_SNAPSHOT_RECONCILE_TIMEOUT_MS"))
+    {
+        snapshotReconcileTimeout = std::chrono::milliseconds(std::stoul(std::string(varVal)));
+    }
+
+    // FTL_ORCHESTRATOR_JOURNAL_PATH -> JournalPath
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_JOURNAL_PATH"))
+    {
+        journalPath = std::string(varVal);
+    }
+
+    // FTL_ORCHESTRATOR_JOURNAL_FSYNC -> JournalFsyncPolicy
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_JOURNAL_FSYNC"))
+    {
+        std::string policy(varVal);
+        if (policy == "none")
+        {
+            journalFsyncPolicy = JournalFsyncPolicy::None;
+        }
+        else if (policy == "commit")
+        {
+            journalFsyncPolicy = JournalFsyncPolicy::EveryCommit;
+        }
+        else if (policy == "interval")
+        {
+            journalFsyncPolicy = JournalFsyncPolicy::Interval;
+        }
+        else
+        {
+            throw std::invalid_argument(
+                "FTL_ORCHESTRATOR_JOURNAL_FSYNC must be one of none, commit or interval");
+        }
+    }
+
+    // FTL_ORCHESTRATOR_JOURNAL_FSYNC_INTERVAL_MS -> JournalFsyncInterval
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_JOURNAL_FSYNC_INTERVAL_MS"))
+    {
+        journalFsyncInterval = std::chrono::milliseconds(std::stoul(std::string(varVal)));
+    }
+
+    // FTL_ORCHESTRATOR_CAPTURE_PATH -> CapturePath
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_CAPTURE_PATH"))
+    {
+        capturePath = std::string(varVal);
+    }
+
+    // FTL_ORCHESTRATOR_STANDBY_OF -> StandbyPrimaryHostname, StandbyPrimaryPort
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_STANDBY_OF"))
+    {
+        std::string primary(varVal);
+        size_t separator = primary.rfind(':');
+        standbyPrimaryHostname = primary.substr(0, separator);
+        if (separator != std::string::npos)
+        {
+            standbyPrimaryPort = static_cast<uint16_t>(std::stoul(primary.substr(separator + 1)));
+        }
+    }
 }
 
 std::vector<std::byte> Configuration::GetPreSharedKey()
 {
     return preSharedKey;
 }
+
+spdlog::level::level_enum Configuration::GetLogLevel()
+{
+    return logLevel;
+}
+
+size_t Configuration::GetLogQueueSize()
+{
+    return logQueueSize;
+}
+
+bool Configuration::GetLogDropOnOverflow()
+{
+    return logDropOnOverflow;
+}
+
+uint16_t Configuration::GetMetricsPort()
+{
+    return metricsPort;
+}
 #pragma endregion
 
 #pragma region Private methods
@@ -58,4 +293,129 @@ std::vector<std::byte> Configuration::hexStringToByteArray(std::string hexString
 
     return retVal;
 }
-#pragma endregion
\ No newline at end of file
+#pragma endregion
+
+size_t Configuration::GetMaxPendingHandshakes()
+{
+    return maxPendingHandshakes;
+}
+
+size_t Configuration::GetMaxPendingHandshakesPerAddress()
+{
+    return maxPendingHandshakesPerAddress;
+}
+
+std::chrono::milliseconds Configuration::GetHandshakeTimeout()
+{
+    return handshakeTimeout;
+}
+
+size_t Configuration::GetAcceptorThreadCount()
+{
+    return acceptorThreadCount;
+}
+
+int Configuration::GetListenBacklog()
+{
+    return listenBacklog;
+}
+
+bool Configuration::GetKernelTlsEnabled()
+{
+    return kernelTlsEnabled;
+}
+
+bool Configuration::GetIoUringTransportEnabled()
+{
+    return ioUringTransportEnabled;
+}
+
+std::string Configuration::GetUnixSocketPath()
+{
+    return unixSocketPath;
+}
+
+std::set<uid_t> Configuration::GetUnixSocketAllowedUids()
+{
+    return unixSocketAllowedUids;
+}
+
+std::chrono::milliseconds Configuration::GetHeartbeatInterval()
+{
+    return heartbeatInterval;
+}
+
+uint32_t Configuration::GetHeartbeatMissThreshold()
+{
+    return heartbeatMissThreshold;
+}
+
+std::chrono::seconds Configuration::GetTcpKeepAliveInterval()
+{
+    return tcpKeepAliveInterval;
+}
+
+std::chrono::milliseconds Configuration::GetTcpUserTimeout()
+{
+    return tcpUserTimeout;
+}
+
+std::chrono::milliseconds Configuration::GetRelayBatchWindow()
+{
+    return relayBatchWindow;
+}
+
+std::chrono::milliseconds Configuration::GetRouteLinger()
+{
+    return routeLinger;
+}
+
+std::map<uint32_t, std::chrono::milliseconds> Configuration::GetChannelRouteLinger()
+{
+    return channelRouteLinger;
+}
+
+std::string Configuration::GetSnapshotPath()
+{
+    return snapshotPath;
+}
+
+std::chrono::milliseconds Configuration::GetSnapshotInterval()
+{
+    return snapshotInterval;
+}
+
+std::chrono::milliseconds Configuration::GetSnapshotReconcileTimeout()
+{
+    return snapshotReconcileTimeout;
+}
+
+std::string Configuration::GetJournalPath()
+{
+    return journalPath;
+}
+
+JournalFsyncPolicy Configuration::GetJournalFsyncPolicy()
+{
+    return journalFsyncPolicy;
+}
+
+std::chrono::milliseconds Configuration::GetJournalFsyncInterval()
+{
+    return journalFsyncInterval;
+}
+
+std::string Configuration::GetCapturePath()
+{
+    return capturePath;
+}
+
+std::string Configuration::GetStandbyPrimaryHostname()
+{
+    return standbyPrimaryHostname;
+}
+
+uint16_t Configuration::GetStandbyPrimaryPort()
+{
+    return standbyPrimaryPort;
+}
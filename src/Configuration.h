@@ -7,8 +7,15 @@
 
 #pragma once
 
+#include "EventJournal.h"
+
+#include <chrono>
 #include <cstdint>
+#include <map>
+#include <set>
+#include <spdlog/common.h>
 #include <string>
+#include <sys/types.h>
 #include <vector>
 
 class Configuration
@@ -19,10 +26,68 @@ public:
 
     /* Configuration values */
     std::vector<std::byte> GetPreSharedKey();
+    spdlog::level::level_enum GetLogLevel();
+    size_t GetLogQueueSize();
+    bool GetLogDropOnOverflow();
+    uint16_t GetMetricsPort();
+    size_t GetMaxPendingHandshakes();
+    size_t GetMaxPendingHandshakesPerAddress();
+    std::chrono::milliseconds GetHandshakeTimeout();
+    size_t GetAcceptorThreadCount();
+    int GetListenBacklog();
+    bool GetKernelTlsEnabled();
+    bool GetIoUringTransportEnabled();
+    std::string GetUnixSocketPath();
+    std::set<uid_t> GetUnixSocketAllowedUids();
+    std::chrono::milliseconds GetHeartbeatInterval();
+    uint32_t GetHeartbeatMissThreshold();
+    std::chrono::seconds GetTcpKeepAliveInterval();
+    std::chrono::milliseconds GetTcpUserTimeout();
+    std::chrono::milliseconds GetRelayBatchWindow();
+    std::chrono::milliseconds GetRouteLinger();
+    std::map<uint32_t, std::chrono::milliseconds> GetChannelRouteLinger();
+    std::string GetSnapshotPath();
+    std::chrono::milliseconds GetSnapshotInterval();
+    std::chrono::milliseconds GetSnapshotReconcileTimeout();
+    std::string GetJournalPath();
+    JournalFsyncPolicy GetJournalFsyncPolicy();
+    std::chrono::milliseconds GetJournalFsyncInterval();
+    std::string GetCapturePath();
+    std::string GetStandbyPrimaryHostname();
+    uint16_t GetStandbyPrimaryPort();
 
 private:
     /* Backing stores */
     std::vector<std::byte> preSharedKey;
+    spdlog::level::level_enum logLevel = spdlog::level::info;
+    size_t logQueueSize = 8192;
+    bool logDropOnOverflow = true;
+    uint16_t metricsPort = 0;
+    size_t maxPendingHandshakes = 1024;
+    size_t maxPendingHandshakesPerAddress = 64;
+    std::chrono::milliseconds handshakeTimeout = std::chrono::milliseconds(2500);
+    size_t acceptorThreadCount = 1;
+    int listenBacklog = 1024;
+    bool kernelTlsEnabled = false;
+    bool ioUringTransportEnabled = false;
+    std::string unixSocketPath;
+    std::set<uid_t> unixSocketAllowedUids;
+    std::chrono::milliseconds heartbeatInterval = std::chrono::milliseconds(0);
+    uint32_t heartbeatMissThreshold = 3;
+    std::chrono::seconds tcpKeepAliveInterval = std::chrono::seconds(0);
+    std::chrono::milliseconds tcpUserTimeout = std::chrono::milliseconds(0);
+    std::chrono::milliseconds relayBatchWindow = std::chrono::milliseconds(0);
+    std::chrono::milliseconds routeLinger = std::chrono::milliseconds(0);
+    std::map<uint32_t, std::chrono::milliseconds> channelRouteLinger;
+    std::string snapshotPath;
+    std::chrono::milliseconds snapshotInterval = std::chrono::milliseconds(0);
+    std::chrono::milliseconds snapshotReconcileTimeout = std::chrono::seconds(30);
+    std::string journalPath;
+    JournalFsyncPolicy journalFsyncPolicy = JournalFsyncPolicy::EveryCommit;
+    std::chrono::milliseconds journalFsyncInterval = std::chrono::milliseconds(1000);
+    std::string capturePath;
+    std::string standbyPrimaryHostname;
+    uint16_t standbyPrimaryPort = 8085;
 
     /* Private methods */
     std::vector<std::byte> hexStringToByteArray(std::string hexString);
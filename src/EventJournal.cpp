@@ -0,0 +1,693 @@
+/**
+ * @file EventJournal.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include "EventJournal.h"
+
+#include "BinaryEncoding.h"
+#include "Util.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <spdlog/spdlog.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+
+#pragma region Helpers
+namespace
+{
+    // "FTLOJRNL"
+    constexpr std::array<std::byte, 8> JOURNAL_MAGIC {
+        std::byte('F'), std::byte('T'), std::byte('L'), std::byte('O'),
+        std::byte('J'), std::byte('R'), std::byte('N'), std::byte('L'),
+    };
+    constexpr uint16_t JOURNAL_FORMAT_VERSION = 1;
+    constexpr size_t SEGMENT_HEADER_LENGTH = (8 + 2);
+    // Body length, body checksum
+    constexpr size_t RECORD_HEADER_LENGTH = (4 + 8);
+    // Wide enough for any sequence number, so segment names sort in sequence order
+    constexpr size_t SEGMENT_SEQUENCE_DIGITS = 20;
+
+    std::vector<std::byte> readFile(const std::string& path)
+    {
+        int fileHandle = open(path.c_str(), (O_RDONLY | O_CLOEXEC));
+        if (fileHandle < 0)
+        {
+            int error = errno;
+            std::stringstream errStr;
+            errStr << "Could not open journal segment " << path << ": " <<
+                Util::ErrnoToString(error);
+            throw std::runtime_error(errStr.str());
+        }
+        std::vector<std::byte> bytes;
+        std::array<std::byte, 65536> buffer;
+        while (true)
+        {
+            ssize_t result = read(fileHandle, buffer.data(), buffer.size());
+            if (result < 0)
+            {
+                int error = errno;
+                if (error == EINTR)
+                {
+                    continue;
+                }
+                close(fileHandle);
+                std::stringstream errStr;
+                errStr << "Could not read journal segment " << path << ": " <<
+                    Util::ErrnoToString(error);
+                throw std::runtime_error(errStr.str());
+            }
+            if (result == 0)
+            {
+                break;
+            }
+            bytes.insert(bytes.end(), buffer.begin(), (buffer.begin() + result));
+        }
+        close(fileHandle);
+        return bytes;
+    }
+}
+#pragma endregion Helpers
+
+#pragma region JournalEvent
+std::vector<JournalEvent> JournalEvent::FromSnapshot(const StateSnapshot& snapshot)
+{
+    std::vector<JournalEvent> events;
+    events.reserve(snapshot.Nodes.size() + snapshot.Streams.size() +
+        snapshot.Subscriptions.size() + snapshot.Routes.size());
+    for (const auto& node : snapshot.Nodes)
+    {
+        events.push_back(JournalEvent
+            {
+                .Type = JournalEventType::Intro,
+                .Hostname = node.Hostname,
+                .Node = node,
+            });
+    }
+    for (const auto& stream : snapshot.Streams)
+    {
+        events.push_back(JournalEvent
+            {
+                .Type = JournalEventType::Publish,
+                .Hostname = stream.IngestHostname,
+                .ChannelId = stream.ChannelId,
+                .StreamId = stream.StreamId,
+            });
+    }
+    for (const auto& subscription : snapshot.Subscriptions)
+    {
+        events.push_back(JournalEvent
+            {
+                .Type = JournalEventType::Subscribe,
+                .Hostname = subscription.EdgeHostname,
+                .ChannelId = subscription.ChannelId,
+                .StreamKey = subscription.StreamKey,
+            });
+    }
+    for (const auto& route : snapshot.Routes)
+    {
+        events.push_back(JournalEvent
+            {
+                .Type = JournalEventType::RouteOpen,
+                .Hostname = route.IngestHostname,
+                .ChannelId = route.ChannelId,
+                .StreamId = route.StreamId,
+                .TargetHostname = route.TargetHostname,
+            });
+    }
+    return events;
+}
+
+JournalEvent JournalEvent::ReadFrom(BinaryReader& reader)
+{
+    JournalEvent event;
+    event.Sequence = reader.Read<uint64_t>();
+    event.Type = static_cast<JournalEventType>(reader.Read<uint8_t>());
+    event.Hostname = reader.ReadString();
+    event.ChannelId = reader.Read<uint32_t>();
+    event.StreamId = reader.Read<uint32_t>();
+    event.TargetHostname = reader.ReadString();
+    event.StreamKey = reader.ReadBytes();
+    if (event.Type == JournalEventType::Intro)
+    {
+        event.Node.Hostname = event.Hostname;
+        event.Node.VersionMajor = reader.Read<uint8_t>();
+        event.Node.VersionMinor = reader.Read<uint8_t>();
+        event.Node.VersionRevision = reader.Read<uint8_t>();
+        event.Node.RelayLayer = reader.Read<uint8_t>();
+        event.Node.RegionCode = reader.ReadString();
+        event.Node.CurrentLoad = reader.Read<uint32_t>();
+        event.Node.MaximumLoad = reader.Read<uint32_t>();
+    }
+    return event;
+}
+
+void JournalEvent::WriteTo(BinaryWriter& writer) const
+{
+    writer.Write(Sequence);
+    writer.Write(static_cast<uint8_t>(Type));
+    writer.Write(Hostname);
+    writer.Write(ChannelId);
+    writer.Write(StreamId);
+    writer.Write(TargetHostname);
+    writer.Write(StreamKey);
+    if (Type == JournalEventType::Intro)
+    {
+        writer.Write(Node.VersionMajor);
+        writer.Write(Node.VersionMinor);
+        writer.Write(Node.VersionRevision);
+        writer.Write(Node.RelayLayer);
+        writer.Write(Node.RegionCode);
+        writer.Write(Node.CurrentLoad);
+        writer.Write(Node.MaximumLoad);
+    }
+}
+
+void JournalEvent::ApplyTo(StateSnapshot& snapshot) const
+{
+    switch (Type)
+    {
+    case JournalEventType::Intro:
+    {
+        std::erase_if(snapshot.Nodes,
+            [this](const SnapshotNode& node) { return (node.Hostname == Hostname); });
+        snapshot.Nodes.push_back(Node);
+        snapshot.Nodes.back().Hostname = Hostname;
+        break;
+    }
+    case JournalEventType::ConnectionClosed:
+    {
+        // Routes to the node are journaled as they're closed; routes from it just go away with
+        // its streams
+        std::erase_if(snapshot.Nodes,
+            [this](const SnapshotNode& node) { return (node.Hostname == Hostname); });
+        std::erase_if(snapshot.Streams,
+            [this](const SnapshotStream& stream) { return (stream.IngestHostname == Hostname); });
+        std::erase_if(snapshot.Subscriptions,
+            [this](const SnapshotSubscription& subscription)
+            {
+                return (subscription.EdgeHostname == Hostname);
+            });
+        std::erase_if(snapshot.Routes,
+            [this](const SnapshotRoute& route) { return (route.IngestHostname == Hostname); });
+        break;
+    }
+    case JournalEventType::Publish:
+    {
+        // A channel is only live on one ingest at a time
+        std::erase_if(snapshot.Streams,
+            [this](const SnapshotStream& stream) { return (stream.ChannelId == ChannelId); });
+        snapshot.Streams.push_back(SnapshotStream
+            {
+                .IngestHostname = Hostname,
+                .ChannelId = ChannelId,
+                .StreamId = StreamId,
+            });
+        break;
+    }
+    case JournalEventType::Unpublish:
+    {
+        std::erase_if(snapshot.Streams,
+            [this](const SnapshotStream& stream)
+            {
+                return ((stream.IngestHostname == Hostname) && (stream.ChannelId == ChannelId) &&
+                    (stream.StreamId == StreamId));
+            });
+        break;
+    }
+    case JournalEventType::Subscribe:
+    case JournalEventType::Unsubscribe:
+    {
+        std::erase_if(snapshot.Subscriptions,
+            [this](const SnapshotSubscription& subscription)
+            {
+                return ((subscription.EdgeHostname == Hostname) &&
+                    (subscription.ChannelId == ChannelId));
+            });
+        if (Type == JournalEventType::Subscribe)
+        {
+            snapshot.Subscriptions.push_back(SnapshotSubscription
+                {
+                    .EdgeHostname = Hostname,
+                    .ChannelId = ChannelId,
+                    .StreamKey = StreamKey,
+                });
+        }
+        break;
+    }
+    case JournalEventType::RouteOpen:
+    case JournalEventType::RouteClose:
+    {
+        SnapshotRoute route
+        {
+            .ChannelId = ChannelId,
+            .StreamId = StreamId,
+            .IngestHostname = Hostname,
+            .TargetHostname = TargetHostname,
+        };
+        std::erase(snapshot.Routes, route);
+        if (Type == JournalEventType::RouteOpen)
+        {
+            snapshot.Routes.push_back(std::move(route));
+        }
+        break;
+    }
+    default:
+        spdlog::warn(
+            "EventJournal: Skipping event {} of unknown type {}",
+            Sequence,
+            static_cast<uint8_t>(Type));
+        break;
+    }
+}
+#pragma endregion JournalEvent
+
+#pragma region Constructor/Destructor
+EventJournal::EventJournal(
+    std::string basePath,
+    JournalFsyncPolicy fsyncPolicy,
+    std::chrono::milliseconds fsyncInterval,
+    uint64_t nextSequence) :
+    basePath(basePath),
+    fsyncPolicy(fsyncPolicy),
+    fsyncInterval(fsyncInterval),
+    nextSequence(nextSequence),
+    committedSequence(nextSequence - 1),
+    lastSyncTime(std::chrono::steady_clock::now()),
+    journaledEvents(MetricsRegistry::Default().GetCounter(
+        "ftl_orchestrator_journal_events_total",
+        "Events written to the journal")),
+    writeFailures(MetricsRegistry::Default().GetCounter(
+        "ftl_orchestrator_journal_write_failures_total",
+        "Journal commits that could not be written; the events in them are lost")),
+    commitBatchSize(MetricsRegistry::Default().GetHistogram(
+        "ftl_orchestrator_journal_commit_batch_size",
+        "Events written to the journal together in a single commit"))
+{
+    writerThread = std::thread(&EventJournal::writerThreadBody, this);
+}
+
+EventJournal::~EventJournal()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isStopping = true;
+    }
+    writeConditionVariable.notify_all();
+    writerThread.join();
+}
+#pragma endregion Constructor/Destructor
+
+#pragma region Static methods
+std::vector<JournalEvent> EventJournal::ReadEvents(
+    const std::string& basePath,
+    uint64_t afterSequence)
+{
+    std::vector<JournalEvent> events;
+    uint64_t lastSequence = afterSequence;
+    for (const auto& [firstSequence, path] : listSegments(basePath))
+    {
+        std::vector<std::byte> bytes = readFile(path);
+        if ((bytes.size() < SEGMENT_HEADER_LENGTH) ||
+            (std::memcmp(bytes.data(), JOURNAL_MAGIC.data(), JOURNAL_MAGIC.size()) != 0))
+        {
+            // Created, but we crashed before the header made it out
+            spdlog::warn("EventJournal: Skipping {}, it isn't a journal segment", path);
+            continue;
+        }
+        BinaryReader header((bytes.data() + JOURNAL_MAGIC.size()), sizeof(uint16_t));
+        uint16_t formatVersion = header.Read<uint16_t>();
+        if (formatVersion != JOURNAL_FORMAT_VERSION)
+        {
+            std::stringstream errStr;
+            errStr << "Unsupported journal format version " << formatVersion << " in " << path;
+            throw std::runtime_error(errStr.str());
+        }
+
+        size_t offset = SEGMENT_HEADER_LENGTH;
+        while (offset < bytes.size())
+        {
+            try
+            {
+                BinaryReader recordHeader((bytes.data() + offset), (bytes.size() - offset));
+                uint32_t bodyLength = recordHeader.Read<uint32_t>();
+                uint64_t bodyChecksum = recordHeader.Read<uint64_t>();
+                const std::byte* body = (bytes.data() + offset + RECORD_HEADER_LENGTH);
+                if (((bytes.size() - offset - RECORD_HEADER_LENGTH) < bodyLength) ||
+                    (BinaryWriter::Checksum(body, bodyLength) != bodyChecksum))
+                {
+                    throw std::runtime_error("Record is torn");
+                }
+                BinaryReader reader(body, bodyLength);
+                JournalEvent event = JournalEvent::ReadFrom(reader);
+                if (!reader.IsAtEnd())
+                {
+                    throw std::runtime_error("Record has trailing data");
+                }
+                offset += (RECORD_HEADER_LENGTH + bodyLength);
+                if (event.Sequence > lastSequence)
+                {
+                    lastSequence = event.Sequence;
+                    events.push_back(std::move(event));
+                }
+            }
+            catch (const std::exception& e)
+            {
+                // Nothing after a torn write in this segment can be trusted
+                spdlog::warn(
+                    "EventJournal: Ignoring the rest of {} from offset {}: {}",
+                    path,
+                    offset,
+                    e.what());
+                break;
+            }
+        }
+    }
+    return events;
+}
+#pragma endregion Static methods
+
+#pragma region Public methods
+uint64_t EventJournal::Append(JournalEvent event)
+{
+    uint64_t sequence;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        sequence = nextSequence++;
+        event.Sequence = sequence;
+        pendingEvents.push_back(std::move(event));
+    }
+    writeConditionVariable.notify_one();
+    return sequence;
+}
+
+void EventJournal::Flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    uint64_t flushSequence = (nextSequence - 1);
+    committedConditionVariable.wait(
+        lock,
+        [this, flushSequence]() { return (committedSequence >= flushSequence); });
+}
+
+uint64_t EventJournal::Rotate()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    uint64_t rotateSequence = (nextSequence - 1);
+    uint64_t rotation = ++rotationsRequested;
+    writeConditionVariable.notify_one();
+    committedConditionVariable.wait(
+        lock,
+        [this, rotation]() { return (rotationsCompleted >= rotation); });
+    return rotateSequence;
+}
+
+void EventJournal::RemoveSegmentsThrough(uint64_t sequence)
+{
+    // Segments are only closed by Rotate(), and anything appended after it starts a new one, so
+    // every segment starting at or before the rotated sequence ends there too
+    for (const auto& [firstSequence, path] : listSegments(basePath))
+    {
+        if (firstSequence > sequence)
+        {
+            break;
+        }
+        if (unlink(path.c_str()) < 0)
+        {
+            int error = errno;
+            spdlog::warn(
+                "EventJournal: Could not remove {}: {}",
+                path,
+                Util::ErrnoToString(error));
+        }
+    }
+}
+#pragma endregion Public methods
+
+#pragma region Private methods
+void EventJournal::writerThreadBody()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        auto isWorkReady = [this]()
+        {
+            return (isStopping || !pendingEvents.empty() ||
+                (rotationsRequested > rotationsCompleted));
+        };
+        if ((fsyncPolicy == JournalFsyncPolicy::Interval) && isSyncNeeded)
+        {
+            writeConditionVariable.wait_until(lock, (lastSyncTime + fsyncInterval), isWorkReady);
+        }
+        else
+        {
+            writeConditionVariable.wait(lock, isWorkReady);
+        }
+
+        // Everything queued while the last commit was in flight goes out together
+        std::vector<JournalEvent> events;
+        events.swap(pendingEvents);
+        uint64_t rotation = rotationsRequested;
+        bool isClosing = (isStopping || (rotationsRequested > rotationsCompleted));
+        lock.unlock();
+
+        if (!events.empty())
+        {
+            try
+            {
+                commit(events);
+            }
+            catch (const std::exception& e)
+            {
+                spdlog::error(
+                    "EventJournal: Could not write events {} to {}: {}",
+                    events.front().Sequence,
+                    events.back().Sequence,
+                    e.what());
+                writeFailures.Increment();
+                // Start over in a new segment rather than appending after a partial write
+                closeSegment();
+            }
+        }
+        if ((fsyncPolicy == JournalFsyncPolicy::Interval) && isSyncNeeded &&
+            ((std::chrono::steady_clock::now() - lastSyncTime) >= fsyncInterval))
+        {
+            try
+            {
+                sync();
+            }
+            catch (const std::exception& e)
+            {
+                spdlog::error("EventJournal: {}", e.what());
+                writeFailures.Increment();
+            }
+        }
+        if (isClosing)
+        {
+            closeSegment();
+        }
+
+        lock.lock();
+        if (!events.empty())
+        {
+            committedSequence = events.back().Sequence;
+        }
+        rotationsCompleted = rotation;
+        committedConditionVariable.notify_all();
+        if (isStopping && pendingEvents.empty())
+        {
+            break;
+        }
+    }
+}
+
+void EventJournal::commit(const std::vector<JournalEvent>& events)
+{
+    BinaryWriter batch;
+    for (const auto& event : events)
+    {
+        BinaryWriter body;
+        event.WriteTo(body);
+        const std::vector<std::byte>& bodyBytes = body.GetBuffer();
+        batch.Write(static_cast<uint32_t>(bodyBytes.size()));
+        batch.Write(BinaryWriter::Checksum(bodyBytes.data(), bodyBytes.size()));
+        batch.GetBuffer().insert(batch.GetBuffer().end(), bodyBytes.begin(), bodyBytes.end());
+    }
+    const std::vector<std::byte>& bytes = batch.GetBuffer();
+
+    if (segmentHandle < 0)
+    {
+        openSegment(events.front().Sequence);
+    }
+    size_t written = 0;
+    while (written < bytes.size())
+    {
+        ssize_t result = write(segmentHandle, (bytes.data() + written), (bytes.size() - written));
+        if (result < 0)
+        {
+            int error = errno;
+            if (error == EINTR)
+            {
+                continue;
+            }
+            std::stringstream errStr;
+            errStr << "Could not write " << segmentPath(segmentFirstSequence) << ": " <<
+                Util::ErrnoToString(error);
+            throw std::runtime_error(errStr.str());
+        }
+        written += static_cast<size_t>(result);
+    }
+    isSyncNeeded = true;
+    if (fsyncPolicy == JournalFsyncPolicy::EveryCommit)
+    {
+        sync();
+    }
+
+    journaledEvents.Increment(events.size());
+    commitBatchSize.Record(events.size());
+}
+
+void EventJournal::openSegment(uint64_t firstSequence)
+{
+    std::string path = segmentPath(firstSequence);
+    segmentHandle = open(
+        path.c_str(),
+        (O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC),
+        (S_IRUSR | S_IWUSR | S_IRGRP));
+    if (segmentHandle < 0)
+    {
+        int error = errno;
+        std::stringstream errStr;
+        errStr << "Could not create " << path << ": " << Util::ErrnoToString(error);
+        throw std::runtime_error(errStr.str());
+    }
+    segmentFirstSequence = firstSequence;
+
+    BinaryWriter header;
+    header.GetBuffer().assign(JOURNAL_MAGIC.begin(), JOURNAL_MAGIC.end());
+    header.Write(JOURNAL_FORMAT_VERSION);
+    if (write(segmentHandle, header.GetBuffer().data(), header.GetBuffer().size()) !=
+        static_cast<ssize_t>(header.GetBuffer().size()))
+    {
+        int error = errno;
+        closeSegment();
+        std::stringstream errStr;
+        errStr << "Could not write header to " << path << ": " << Util::ErrnoToString(error);
+        throw std::runtime_error(errStr.str());
+    }
+
+    if (fsyncPolicy != JournalFsyncPolicy::None)
+    {
+        // Make the new file itself durable
+        std::string directory = std::filesystem::path(path).parent_path().string();
+        int directoryHandle = open(
+            (directory.empty() ? "." : directory.c_str()),
+            (O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+        if (directoryHandle >= 0)
+        {
+            fsync(directoryHandle);
+            close(directoryHandle);
+        }
+    }
+}
+
+void EventJournal::closeSegment()
+{
+    if (segmentHandle < 0)
+    {
+        return;
+    }
+    if (isSyncNeeded && (fsyncPolicy != JournalFsyncPolicy::None))
+    {
+        try
+        {
+            sync();
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error("EventJournal: {}", e.what());
+            writeFailures.Increment();
+        }
+    }
+    close(segmentHandle);
+    segmentHandle = -1;
+    isSyncNeeded = false;
+}
+
+void EventJournal::sync()
+{
+    lastSyncTime = std::chrono::steady_clock::now();
+    if (!isSyncNeeded || (segmentHandle < 0))
+    {
+        return;
+    }
+    isSyncNeeded = false;
+    if (fdatasync(segmentHandle) < 0)
+    {
+        int error = errno;
+        std::stringstream errStr;
+        errStr << "Could not sync " << segmentPath(segmentFirstSequence) << ": " <<
+            Util::ErrnoToString(error);
+        throw std::runtime_error(errStr.str());
+    }
+}
+
+std::string EventJournal::segmentPath(uint64_t firstSequence) const
+{
+    std::string sequence = std::to_string(firstSequence);
+    return (basePath + "." +
+        std::string((SEGMENT_SEQUENCE_DIGITS - sequence.size()), '0') + sequence);
+}
+
+std::vector<std::pair<uint64_t, std::string>> EventJournal::listSegments(
+    const std::string& basePath)
+{
+    std::filesystem::path base(basePath);
+    std::filesystem::path directory = base.parent_path();
+    if (directory.empty())
+    {
+        directory = ".";
+    }
+    std::string prefix = (base.filename().string() + ".");
+
+    std::vector<std::pair<uint64_t, std::string>> segments;
+    std::error_code error;
+    std::filesystem::directory_iterator entries(directory, error);
+    if (error)
+    {
+        if (error == std::errc::no_such_file_or_directory)
+        {
+            return segments;
+        }
+        throw std::runtime_error(
+            "Could not list journal segments in " + directory.string() + ": " + error.message());
+    }
+    for (const auto& entry : entries)
+    {
+        std::string filename = entry.path().filename().string();
+        if ((filename.size() != (prefix.size() + SEGMENT_SEQUENCE_DIGITS)) ||
+            !filename.starts_with(prefix))
+        {
+            continue;
+        }
+        std::string sequence = filename.substr(prefix.size());
+        if (!std::all_of(sequence.begin(), sequence.end(), ::isdigit))
+        {
+            continue;
+        }
+        segments.emplace_back(std::stoull(sequence), entry.path().string());
+    }
+    std::sort(segments.begin(), segments.end());
+    return segments;
+}
+#pragma endregion Private methods
@@ -0,0 +1,186 @@
+/**
+ * @file EventJournal.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#pragma once
+
+#include "BinaryEncoding.h"
+#include "FtlTypes.h"
+#include "Metrics.h"
+#include "StateSnapshot.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class JournalEventType : uint8_t
+{
+    Intro = 1,
+    ConnectionClosed = 2,
+    Publish = 3,
+    Unpublish = 4,
+    Subscribe = 5,
+    Unsubscribe = 6,
+    RouteOpen = 7,
+    RouteClose = 8,
+};
+
+/**
+ * @brief When journal writes are flushed to disk
+ */
+enum class JournalFsyncPolicy
+{
+    // Left to the kernel; a crash of the machine (not just the process) can lose recent events
+    None,
+    // Every group commit is synced before the next one starts
+    EveryCommit,
+    // Synced at most once per interval, bounding how much a machine crash can lose
+    Interval,
+};
+
+/**
+ * @brief A change the orchestrator made to its state, keyed by hostname like snapshots are
+ */
+struct JournalEvent
+{
+    // Assigned by EventJournal::Append
+    uint64_t Sequence = 0;
+    JournalEventType Type;
+    // The node the event came from; the ingest, for routes
+    std::string Hostname;
+    ftl_channel_id_t ChannelId = 0;
+    ftl_stream_id_t StreamId = 0;
+    // The edge a route leads to
+    std::string TargetHostname;
+    std::vector<std::byte> StreamKey;
+    // What the node told us about itself, for intros
+    SnapshotNode Node;
+
+    bool operator==(const JournalEvent&) const = default;
+
+    /**
+     * @brief Events that build up the given state from nothing
+     */
+    static std::vector<JournalEvent> FromSnapshot(const StateSnapshot& snapshot);
+
+    /**
+     * @brief Reads an event written by WriteTo
+     * @throws std::runtime_error if the reader runs out of bytes
+     */
+    static JournalEvent ReadFrom(BinaryReader& reader);
+
+    void WriteTo(BinaryWriter& writer) const;
+
+    /**
+     * @brief Applies this event to a snapshot. Applying an event twice has the same effect as
+     *  applying it once, so replay can start from a snapshot that already includes some of it.
+     */
+    void ApplyTo(StateSnapshot& snapshot) const;
+};
+
+/**
+ * @brief
+ *  An append-only journal of the orchestrator's state changes, so everything since the last
+ *  snapshot can be replayed after a crash.
+ *
+ *  Append() only queues the event; a writer thread owned by the journal picks up everything
+ *  queued since its last write and commits it with a single write() (and, depending on the
+ *  policy, a single fdatasync()), so callers never wait on the disk.
+ *
+ *  The journal is split into segment files named after the first sequence number they hold.
+ *  Rotate() starts a new segment, so segments wholly covered by a snapshot can be removed.
+ */
+class EventJournal
+{
+public:
+    /* Constructor/Destructor */
+    /**
+     * @param basePath segments are written to <basePath>.<first sequence number>
+     * @param nextSequence sequence number given to the first event appended
+     */
+    EventJournal(
+        std::string basePath,
+        JournalFsyncPolicy fsyncPolicy = JournalFsyncPolicy::EveryCommit,
+        std::chrono::milliseconds fsyncInterval = std::chrono::milliseconds(1000),
+        uint64_t nextSequence = 1);
+    ~EventJournal();
+
+    EventJournal(const EventJournal&) = delete;
+    EventJournal& operator=(const EventJournal&) = delete;
+
+    /* Static methods */
+    /**
+     * @brief Reads every intact event after the given sequence number from the journal's
+     *  segments, in order. A torn or corrupt record ends its segment.
+     * @throws std::runtime_error if the segments can't be listed or opened
+     */
+    static std::vector<JournalEvent> ReadEvents(
+        const std::string& basePath,
+        uint64_t afterSequence = 0);
+
+    /* Public methods */
+    /**
+     * @brief Queues an event to be written
+     * @return uint64_t the sequence number given to the event
+     */
+    uint64_t Append(JournalEvent event);
+
+    /**
+     * @brief Waits until every event appended so far has been committed
+     */
+    void Flush();
+
+    /**
+     * @brief Commits every event appended so far and closes the current segment
+     * @return uint64_t sequence number of the last event in the closed segment
+     */
+    uint64_t Rotate();
+
+    /**
+     * @brief Removes closed segments holding nothing after the given sequence number
+     */
+    void RemoveSegmentsThrough(uint64_t sequence);
+
+private:
+    /* Private members */
+    const std::string basePath;
+    const JournalFsyncPolicy fsyncPolicy;
+    const std::chrono::milliseconds fsyncInterval;
+    std::mutex mutex;
+    std::condition_variable writeConditionVariable;
+    std::condition_variable committedConditionVariable;
+    std::vector<JournalEvent> pendingEvents;
+    uint64_t nextSequence;
+    // Last sequence number written (and synced, if the policy asks for it)
+    uint64_t committedSequence;
+    // Rotations asked for and carried out
+    uint64_t rotationsRequested = 0;
+    uint64_t rotationsCompleted = 0;
+    bool isStopping = false;
+    // Only touched by the writer thread
+    int segmentHandle = -1;
+    uint64_t segmentFirstSequence = 0;
+    bool isSyncNeeded = false;
+    std::chrono::steady_clock::time_point lastSyncTime;
+    MetricCounter& journaledEvents;
+    MetricCounter& writeFailures;
+    MetricHistogram& commitBatchSize;
+    std::thread writerThread;
+
+    /* Private methods */
+    void writerThreadBody();
+    void commit(const std::vector<JournalEvent>& events);
+    void openSegment(uint64_t firstSequence);
+    void closeSegment();
+    void sync();
+    std::string segmentPath(uint64_t firstSequence) const;
+    static std::vector<std::pair<uint64_t, std::string>> listSegments(const std::string& basePath);
+};
@@ -0,0 +1,67 @@
+/**
+ * @file InProcessConnectionManager.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include "InProcessConnectionManager.h"
+
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+#pragma region IConnectionManager
+void InProcessConnectionManager::Init()
+{ }
+
+void InProcessConnectionManager::Listen(std::promise<void>&& readyPromise)
+{
+    std::unique_lock<std::mutex> lock(listenMutex);
+    isListening = true;
+    spdlog::info("InProcessConnectionManager: Listening...");
+    readyPromise.set_value();
+
+    listenConditionVariable.wait(lock, [this]() { return isStopping; });
+    isListening = false;
+    spdlog::info("InProcessConnectionManager: Shutting down listener...");
+}
+
+void InProcessConnectionManager::StopListening()
+{
+    {
+        std::lock_guard<std::mutex> lock(listenMutex);
+        isStopping = true;
+    }
+    listenConditionVariable.notify_all();
+}
+
+void InProcessConnectionManager::SetOnNewConnection(
+    std::function<void(std::shared_ptr<InProcessConnection>)> onNewConnection)
+{
+    this->onNewConnection = onNewConnection;
+}
+#pragma endregion
+
+#pragma region Public methods
+std::shared_ptr<InProcessConnection> InProcessConnectionManager::Connect(std::string hostname)
+{
+    {
+        std::lock_guard<std::mutex> lock(listenMutex);
+        if (!isListening)
+        {
+            throw std::runtime_error("InProcessConnectionManager is not listening");
+        }
+    }
+
+    auto [orchestratorEnd, nodeEnd] = InProcessConnection::CreatePair(std::string(), hostname);
+    if (onNewConnection)
+    {
+        onNewConnection(orchestratorEnd);
+    }
+    else
+    {
+        spdlog::warn("Accepted a new connection, but nobody was listening. :(");
+    }
+    return nodeEnd;
+}
+#pragma endregion
@@ -0,0 +1,51 @@
+/**
+ * @file InProcessConnectionManager.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#pragma once
+
+#include "IConnectionManager.h"
+#include "InProcessConnection.h"
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ * @brief
+ *  Hands InProcessConnections to an Orchestrator embedded in the same process, e.g. in a test
+ *  harness or a single-box deployment. Nodes "connect" by calling Connect() rather than over a
+ *  socket.
+ */
+class InProcessConnectionManager : public IConnectionManager<InProcessConnection>
+{
+public:
+    /* IConnectionManager */
+    void Init() override;
+    void Listen(std::promise<void>&& readyPromise = std::promise<void>()) override;
+    void StopListening() override;
+    void SetOnNewConnection(
+        std::function<void(std::shared_ptr<InProcessConnection>)> onNewConnection) override;
+
+    /* Public methods */
+    /**
+     * @brief Opens a new connection to the orchestrator
+     * @param hostname hostname of the connecting node
+     * @return std::shared_ptr<InProcessConnection> the node's end of the connection, which the
+     *  caller must Start() once its callbacks are set, and Stop() when done
+     */
+    std::shared_ptr<InProcessConnection> Connect(std::string hostname = std::string());
+
+private:
+    /* Private members */
+    std::mutex listenMutex;
+    std::condition_variable listenConditionVariable;
+    bool isListening = false;
+    bool isStopping = false;
+    std::function<void(std::shared_ptr<InProcessConnection>)> onNewConnection;
+};
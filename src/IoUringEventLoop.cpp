@@ -0,0 +1,795 @@
+/**
+ * @file IoUringEventLoop.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include "IoUringEventLoop.h"
+
+#include "Util.h"
+
+#include <algorithm>
+#include <cstring>
+#include <spdlog/spdlog.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+#pragma region Constructor/Destructor
+IoUringEventLoop::IoUringEventLoop(unsigned int queueDepth) :
+    queueDepth(queueDepth),
+    submitBatchSize(MetricsRegistry::Default().GetHistogram(
+        "ftl_orchestrator_io_uring_submit_batch_size",
+        "Submission queue entries handed to the kernel per io_uring_enter call"))
+{
+    try
+    {
+        setUpRing();
+        setUpBufferRing();
+        wakeEventHandle = eventfd(0, EFD_CLOEXEC);
+        if (wakeEventHandle < 0)
+        {
+            int error = errno;
+            std::stringstream errStr;
+            errStr << "Unable to create io_uring wake eventfd! Error "
+                << error << ": " << Util::ErrnoToString(error);
+            throw std::runtime_error(errStr.str());
+        }
+    }
+    catch (...)
+    {
+        tearDown();
+        throw;
+    }
+}
+
+IoUringEventLoop::~IoUringEventLoop()
+{
+    Stop();
+    tearDown();
+}
+#pragma endregion
+
+#pragma region Static methods
+bool IoUringEventLoop::IsSupported()
+{
+    // Multishot receive arrived in Linux 6.0; older kernels accept the ring but reject the
+    // receives, so check the version before trying to set anything up
+    utsname systemName;
+    if (uname(&systemName) != 0)
+    {
+        return false;
+    }
+    int majorVersion = 0;
+    int minorVersion = 0;
+    if (sscanf(systemName.release, "%d.%d", &majorVersion, &minorVersion) != 2)
+    {
+        return false;
+    }
+    if (majorVersion < 6)
+    {
+        return false;
+    }
+
+    try
+    {
+        IoUringEventLoop probe(8);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::debug("io_uring probe failed: {}", e.what());
+        return false;
+    }
+}
+#pragma endregion
+
+#pragma region Public methods
+void IoUringEventLoop::Start()
+{
+    {
+        std::lock_guard<std::mutex> lock(postedTasksMutex);
+        isRunning = true;
+    }
+    armWake();
+    loopThread = std::thread(&IoUringEventLoop::loopThreadBody, this);
+    loopThreadId = loopThread.get_id();
+}
+
+void IoUringEventLoop::Stop()
+{
+    if (!loopThread.joinable())
+    {
+        return;
+    }
+    if (IsLoopThread())
+    {
+        throw std::runtime_error("IoUringEventLoop cannot be stopped from its own thread!");
+    }
+    Post([this]() { isStopRequested = true; });
+    loopThread.join();
+}
+
+bool IoUringEventLoop::Post(std::function<void()> task)
+{
+    bool isWakeNeeded = false;
+    {
+        std::lock_guard<std::mutex> lock(postedTasksMutex);
+        if (!isRunning)
+        {
+            return false;
+        }
+        postedTasks.push_back(std::move(task));
+        if (!isWakePending && !IsLoopThread())
+        {
+            isWakePending = true;
+            isWakeNeeded = true;
+        }
+    }
+    if (isWakeNeeded)
+    {
+        uint64_t wakeValue = 1;
+        if (write(wakeEventHandle, &wakeValue, sizeof(wakeValue)) < 0)
+        {
+            spdlog::error("IoUringEventLoop: Failed to signal wake eventfd");
+        }
+    }
+    return true;
+}
+
+bool IoUringEventLoop::IsLoopThread() const
+{
+    return (std::this_thread::get_id() == loopThreadId);
+}
+
+IoUringEventLoop::socket_id_t IoUringEventLoop::AddSocket(
+    int socketHandle,
+    std::shared_ptr<IoUringSocketHandler> handler)
+{
+    socket_id_t socketId = nextSocketId++;
+    auto [it, inserted] = sockets.emplace(
+        socketId,
+        SocketState
+        {
+            .SocketHandle = socketHandle,
+            .Handler = handler,
+        });
+    armReceive(socketId, it->second);
+    return socketId;
+}
+
+void IoUringEventLoop::Send(socket_id_t socketId, std::vector<std::byte> bytes)
+{
+    auto it = sockets.find(socketId);
+    if ((it == sockets.end()) || it->second.IsClosing || bytes.empty())
+    {
+        return;
+    }
+    it->second.SendQueue.push_back(std::move(bytes));
+    startNextSend(socketId, it->second);
+}
+
+void IoUringEventLoop::CloseSocket(socket_id_t socketId)
+{
+    auto it = sockets.find(socketId);
+    if ((it == sockets.end()) || it->second.IsClosing)
+    {
+        return;
+    }
+    SocketState& socket = it->second;
+    socket.IsClosing = true;
+    // Let queued sends (e.g. a TLS close_notify) drain first; handleSend shuts down after
+    if (!socket.IsSendInFlight)
+    {
+        shutDownSocket(socket);
+    }
+    // The caller may be a handler still using this socket's state, so never finish closing
+    // synchronously
+    Post([this, socketId]() { finishClosingIfIdle(socketId); });
+}
+#pragma endregion
+
+#pragma region Private methods
+void IoUringEventLoop::setUpRing()
+{
+    io_uring_params params { };
+    params.flags = (IORING_SETUP_CQSIZE | IORING_SETUP_COOP_TASKRUN);
+    params.cq_entries = (queueDepth * 4);
+    ringHandle = syscall(__NR_io_uring_setup, queueDepth, &params);
+    if ((ringHandle < 0) && (errno == EINVAL))
+    {
+        // Cooperative task running needs 5.19+
+        params = io_uring_params { };
+        params.flags = IORING_SETUP_CQSIZE;
+        params.cq_entries = (queueDepth * 4);
+        ringHandle = syscall(__NR_io_uring_setup, queueDepth, &params);
+    }
+    if (ringHandle < 0)
+    {
+        int error = errno;
+        std::stringstream errStr;
+        errStr << "Unable to set up io_uring! Error "
+            << error << ": " << Util::ErrnoToString(error);
+        throw std::runtime_error(errStr.str());
+    }
+    if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0)
+    {
+        throw std::runtime_error("io_uring is missing IORING_FEAT_SINGLE_MMAP");
+    }
+
+    // Submission and completion rings share one mapping
+    submissionRingSize = (params.sq_off.array + (params.sq_entries * sizeof(unsigned int)));
+    completionRingSize = (params.cq_off.cqes + (params.cq_entries * sizeof(io_uring_cqe)));
+    submissionRingSize = std::max(submissionRingSize, completionRingSize);
+    submissionRingMemory = mmap(
+        nullptr,
+        submissionRingSize,
+        (PROT_READ | PROT_WRITE),
+        (MAP_SHARED | MAP_POPULATE),
+        ringHandle,
+        IORING_OFF_SQ_RING);
+    if (submissionRingMemory == MAP_FAILED)
+    {
+        submissionRingMemory = nullptr;
+        throw std::runtime_error("Unable to map io_uring submission ring");
+    }
+    completionRingMemory = submissionRingMemory;
+    completionRingSize = 0; // Unmapped with the submission ring
+
+    submissionEntriesSize = (params.sq_entries * sizeof(io_uring_sqe));
+    void* entriesMemory = mmap(
+        nullptr,
+        submissionEntriesSize,
+        (PROT_READ | PROT_WRITE),
+        (MAP_SHARED | MAP_POPULATE),
+        ringHandle,
+        IORING_OFF_SQES);
+    if (entriesMemory == MAP_FAILED)
+    {
+        throw std::runtime_error("Unable to map io_uring submission entries");
+    }
+    submissionEntries = reinterpret_cast<io_uring_sqe*>(entriesMemory);
+
+    auto* submissionBase = reinterpret_cast<uint8_t*>(submissionRingMemory);
+    submissionHead = reinterpret_cast<unsigned int*>(submissionBase + params.sq_off.head);
+    submissionTail = reinterpret_cast<unsigned int*>(submissionBase + params.sq_off.tail);
+    submissionMask = *reinterpret_cast<unsigned int*>(submissionBase + params.sq_off.ring_mask);
+    submissionArray = reinterpret_cast<unsigned int*>(submissionBase + params.sq_off.array);
+    submissionEntryCount = params.sq_entries;
+
+    auto* completionBase = reinterpret_cast<uint8_t*>(completionRingMemory);
+    completionHead = reinterpret_cast<unsigned int*>(completionBase + params.cq_off.head);
+    completionTail = reinterpret_cast<unsigned int*>(completionBase + params.cq_off.tail);
+    completionMask = *reinterpret_cast<unsigned int*>(completionBase + params.cq_off.ring_mask);
+    completionEntries = reinterpret_cast<io_uring_cqe*>(completionBase + params.cq_off.cqes);
+}
+
+void IoUringEventLoop::setUpBufferRing()
+{
+    bufferMemory.resize(BUFFER_COUNT * BUFFER_SIZE);
+
+    // The buffer ring has to be page aligned, so give it its own anonymous mapping
+    bufferRingSize = (BUFFER_COUNT * sizeof(io_uring_buf));
+    void* ringMemory = mmap(
+        nullptr,
+        bufferRingSize,
+        (PROT_READ | PROT_WRITE),
+        (MAP_PRIVATE | MAP_ANONYMOUS),
+        -1,
+        0);
+    if (ringMemory == MAP_FAILED)
+    {
+        throw std::runtime_error("Unable to allocate io_uring buffer ring");
+    }
+    bufferRing = reinterpret_cast<io_uring_buf_ring*>(ringMemory);
+
+    io_uring_buf_reg registration { };
+    registration.ring_addr = reinterpret_cast<uint64_t>(bufferRing);
+    registration.ring_entries = BUFFER_COUNT;
+    registration.bgid = BUFFER_GROUP_ID;
+    if (syscall(__NR_io_uring_register, ringHandle, IORING_REGISTER_PBUF_RING, &registration, 1) == 0)
+    {
+        isBufferRingEnabled = true;
+        for (unsigned int i = 0; i < BUFFER_COUNT; ++i)
+        {
+            recycleBuffer(static_cast<uint16_t>(i));
+        }
+
+        // Some kernels accept the registration but never hand out buffers from the ring
+        if (probeBufferRing())
+        {
+            return;
+        }
+        spdlog::debug("io_uring buffer ring unusable, providing buffers by submission instead");
+        io_uring_buf_reg unregistration { };
+        unregistration.bgid = BUFFER_GROUP_ID;
+        syscall(__NR_io_uring_register, ringHandle, IORING_UNREGISTER_PBUF_RING, &unregistration, 1);
+        isBufferRingEnabled = false;
+    }
+    munmap(bufferRing, bufferRingSize);
+    bufferRing = nullptr;
+
+    // Provide the whole pool in one submission; it goes to the kernel with the first batch
+    io_uring_sqe* entry = getSubmissionEntry();
+    entry->opcode = IORING_OP_PROVIDE_BUFFERS;
+    entry->fd = BUFFER_COUNT;
+    entry->addr = reinterpret_cast<uint64_t>(bufferMemory.data());
+    entry->len = BUFFER_SIZE;
+    entry->off = 0;
+    entry->buf_group = BUFFER_GROUP_ID;
+    entry->user_data = userData(0, OperationType::ProvideBuffers);
+}
+
+bool IoUringEventLoop::probeBufferRing()
+{
+    int socketHandles[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, socketHandles) != 0)
+    {
+        return false;
+    }
+    const char probeByte = 0;
+    bool isUsable = false;
+    if (write(socketHandles[1], &probeByte, sizeof(probeByte)) == sizeof(probeByte))
+    {
+        io_uring_sqe* entry = getSubmissionEntry();
+        entry->opcode = IORING_OP_RECV;
+        entry->fd = socketHandles[0];
+        entry->flags = IOSQE_BUFFER_SELECT;
+        entry->buf_group = BUFFER_GROUP_ID;
+        entry->user_data = userData(0, OperationType::Receive);
+        int submitted = syscall(
+            __NR_io_uring_enter,
+            ringHandle,
+            pendingSubmissions,
+            1,
+            IORING_ENTER_GETEVENTS,
+            nullptr,
+            0);
+        if (submitted > 0)
+        {
+            pendingSubmissions -= std::min<unsigned int>(submitted, pendingSubmissions);
+            unsigned int head = *completionHead;
+            if (head != __atomic_load_n(completionTail, __ATOMIC_ACQUIRE))
+            {
+                io_uring_cqe completion = completionEntries[head & completionMask];
+                __atomic_store_n(completionHead, (head + 1), __ATOMIC_RELEASE);
+                if ((completion.res == sizeof(probeByte)) &&
+                    ((completion.flags & IORING_CQE_F_BUFFER) != 0))
+                {
+                    isUsable = true;
+                    recycleBuffer(
+                        static_cast<uint16_t>(completion.flags >> IORING_CQE_BUFFER_SHIFT));
+                }
+            }
+        }
+    }
+    close(socketHandles[0]);
+    close(socketHandles[1]);
+    return isUsable;
+}
+
+void IoUringEventLoop::tearDown()
+{
+    if (wakeEventHandle >= 0)
+    {
+        close(wakeEventHandle);
+        wakeEventHandle = -1;
+    }
+    if (bufferRing != nullptr)
+    {
+        munmap(bufferRing, bufferRingSize);
+        bufferRing = nullptr;
+    }
+    if (submissionEntries != nullptr)
+    {
+        munmap(submissionEntries, submissionEntriesSize);
+        submissionEntries = nullptr;
+    }
+    if (submissionRingMemory != nullptr)
+    {
+        munmap(submissionRingMemory, submissionRingSize);
+        submissionRingMemory = nullptr;
+        completionRingMemory = nullptr;
+    }
+    if (ringHandle >= 0)
+    {
+        close(ringHandle);
+        ringHandle = -1;
+    }
+}
+
+void IoUringEventLoop::loopThreadBody()
+{
+    while (!isStopRequested)
+    {
+        runPostedTasks();
+        if (isStopRequested)
+        {
+            break;
+        }
+        submitAndWait();
+        processCompletions();
+    }
+
+    // Refuse new work, finish anything already queued, then close whatever is left so
+    // owners waiting on a close hear about it
+    {
+        std::lock_guard<std::mutex> lock(postedTasksMutex);
+        isRunning = false;
+    }
+    runPostedTasks();
+    std::vector<socket_id_t> socketIds;
+    for (const auto& [socketId, socket] : sockets)
+    {
+        socketIds.push_back(socketId);
+    }
+    for (const auto& socketId : socketIds)
+    {
+        auto it = sockets.find(socketId);
+        if (it == sockets.end())
+        {
+            continue;
+        }
+        auto handler = it->second.Handler;
+        shutdown(it->second.SocketHandle, SHUT_RDWR);
+        close(it->second.SocketHandle);
+        sockets.erase(it);
+        handler->OnSocketClosed(true /*isRemoteClose*/);
+    }
+}
+
+void IoUringEventLoop::runPostedTasks()
+{
+    // Tasks may post more tasks; keep going until the queue is drained so they don't wait
+    // behind the next io_uring_enter
+    while (true)
+    {
+        std::vector<std::function<void()>> tasks;
+        {
+            std::lock_guard<std::mutex> lock(postedTasksMutex);
+            tasks.swap(postedTasks);
+            isWakePending = false;
+        }
+        if (tasks.empty())
+        {
+            return;
+        }
+        for (auto& task : tasks)
+        {
+            task();
+        }
+    }
+}
+
+io_uring_sqe* IoUringEventLoop::getSubmissionEntry()
+{
+    unsigned int tail = *submissionTail;
+    unsigned int head = __atomic_load_n(submissionHead, __ATOMIC_ACQUIRE);
+    if ((tail - head) >= submissionEntryCount)
+    {
+        // Full - hand what we have to the kernel without waiting, then try again
+        int submitted = syscall(__NR_io_uring_enter, ringHandle, pendingSubmissions, 0, 0, nullptr, 0);
+        if (submitted > 0)
+        {
+            pendingSubmissions -= std::min<unsigned int>(submitted, pendingSubmissions);
+        }
+        head = __atomic_load_n(submissionHead, __ATOMIC_ACQUIRE);
+        if ((tail - head) >= submissionEntryCount)
+        {
+            throw std::runtime_error("io_uring submission queue is full");
+        }
+    }
+    unsigned int index = (tail & submissionMask);
+    io_uring_sqe* entry = &submissionEntries[index];
+    memset(entry, 0, sizeof(*entry));
+    submissionArray[index] = index;
+    __atomic_store_n(submissionTail, (tail + 1), __ATOMIC_RELEASE);
+    ++pendingSubmissions;
+    return entry;
+}
+
+void IoUringEventLoop::submitAndWait()
+{
+    // Everything queued since the last iteration goes to the kernel in this one call
+    unsigned int toSubmit = pendingSubmissions;
+    int result = syscall(
+        __NR_io_uring_enter,
+        ringHandle,
+        toSubmit,
+        1,
+        IORING_ENTER_GETEVENTS,
+        nullptr,
+        0);
+    if (result < 0)
+    {
+        int error = errno;
+        if ((error != EINTR) && (error != EAGAIN) && (error != EBUSY))
+        {
+            spdlog::error(
+                "IoUringEventLoop: io_uring_enter failed: {}",
+                Util::ErrnoToString(error));
+        }
+        return;
+    }
+    if (toSubmit > 0)
+    {
+        submitBatchSize.Record(result);
+    }
+    pendingSubmissions -= std::min<unsigned int>(result, pendingSubmissions);
+}
+
+void IoUringEventLoop::processCompletions()
+{
+    unsigned int head = *completionHead;
+    unsigned int tail = __atomic_load_n(completionTail, __ATOMIC_ACQUIRE);
+    while (head != tail)
+    {
+        io_uring_cqe completion = completionEntries[head & completionMask];
+        ++head;
+        // Release the slot before handling, since handling may take a while
+        __atomic_store_n(completionHead, head, __ATOMIC_RELEASE);
+        handleCompletion(completion);
+    }
+}
+
+void IoUringEventLoop::handleCompletion(const io_uring_cqe& completion)
+{
+    auto operation = static_cast<OperationType>(completion.user_data & 0x7);
+    socket_id_t socketId = (completion.user_data >> 3);
+    switch (operation)
+    {
+    case OperationType::Receive:
+        handleReceive(socketId, completion);
+        break;
+    case OperationType::Send:
+        handleSend(socketId, completion);
+        break;
+    case OperationType::Wake:
+        // Posted tasks run at the top of the next iteration
+        armWake();
+        break;
+    case OperationType::ProvideBuffers:
+        if (completion.res < 0)
+        {
+            spdlog::error(
+                "IoUringEventLoop: Failed to provide receive buffers: {}",
+                Util::ErrnoToString(-completion.res));
+        }
+        break;
+    default:
+        spdlog::error("IoUringEventLoop: Unknown completion {}", completion.user_data);
+        break;
+    }
+}
+
+void IoUringEventLoop::handleReceive(socket_id_t socketId, const io_uring_cqe& completion)
+{
+    bool hasBuffer = ((completion.flags & IORING_CQE_F_BUFFER) != 0);
+    uint16_t bufferId = static_cast<uint16_t>(completion.flags >> IORING_CQE_BUFFER_SHIFT);
+    auto it = sockets.find(socketId);
+    if (it == sockets.end())
+    {
+        if (hasBuffer)
+        {
+            recycleBuffer(bufferId);
+        }
+        return;
+    }
+    if ((completion.flags & IORING_CQE_F_MORE) == 0)
+    {
+        it->second.IsReceiveArmed = false;
+    }
+
+    if ((completion.res > 0) && hasBuffer)
+    {
+        if (!it->second.IsClosing)
+        {
+            // Keep the handler alive even if it closes its own socket
+            auto handler = it->second.Handler;
+            handler->OnSocketReceived(
+                (bufferMemory.data() + (bufferId * BUFFER_SIZE)),
+                static_cast<size_t>(completion.res));
+        }
+        recycleBuffer(bufferId);
+        it = sockets.find(socketId);
+        if ((it != sockets.end()) && !it->second.IsReceiveArmed && !it->second.IsClosing)
+        {
+            // The kernel ended the multishot receive (e.g. buffers ran low); start another
+            armReceive(socketId, it->second);
+        }
+    }
+    else if (completion.res == -ENOBUFS)
+    {
+        // Every provided buffer is in use. They're returned as soon as each receive is handled,
+        // so simply re-arm.
+        if (!it->second.IsClosing && !it->second.IsReceiveArmed)
+        {
+            armReceive(socketId, it->second);
+        }
+    }
+    else
+    {
+        // End of stream or error - the peer is gone
+        if (hasBuffer)
+        {
+            recycleBuffer(bufferId);
+        }
+        SocketState& socket = it->second;
+        if (!socket.IsClosing)
+        {
+            socket.IsClosing = true;
+            socket.IsRemoteClose = true;
+        }
+        socket.SendQueue.clear();
+        socket.SendOffset = 0;
+        shutDownSocket(socket);
+    }
+    finishClosingIfIdle(socketId);
+}
+
+void IoUringEventLoop::handleSend(socket_id_t socketId, const io_uring_cqe& completion)
+{
+    auto it = sockets.find(socketId);
+    if (it == sockets.end())
+    {
+        return;
+    }
+    SocketState& socket = it->second;
+    socket.IsSendInFlight = false;
+    // Told about the send once we're done with this socket's state, as it may send more
+    std::shared_ptr<IoUringSocketHandler> sentHandler;
+    if (completion.res < 0)
+    {
+        if (!socket.IsClosing)
+        {
+            socket.IsClosing = true;
+            socket.IsRemoteClose = true;
+        }
+        socket.SendQueue.clear();
+        socket.SendOffset = 0;
+        shutDownSocket(socket);
+    }
+    else
+    {
+        if (!socket.IsClosing)
+        {
+            sentHandler = socket.Handler;
+        }
+        socket.SendOffset += static_cast<size_t>(completion.res);
+        if (!socket.SendQueue.empty() && (socket.SendOffset >= socket.SendQueue.front().size()))
+        {
+            socket.SendQueue.pop_front();
+            socket.SendOffset = 0;
+        }
+        if (!socket.SendQueue.empty())
+        {
+            startNextSend(socketId, socket);
+        }
+        else if (socket.IsClosing)
+        {
+            shutDownSocket(socket);
+        }
+    }
+    finishClosingIfIdle(socketId);
+    if (sentHandler)
+    {
+        sentHandler->OnSocketSent(static_cast<size_t>(completion.res));
+    }
+}
+
+void IoUringEventLoop::armReceive(socket_id_t socketId, SocketState& socket)
+{
+    io_uring_sqe* entry = getSubmissionEntry();
+    entry->opcode = IORING_OP_RECV;
+    entry->fd = socket.SocketHandle;
+    entry->ioprio = IORING_RECV_MULTISHOT;
+    entry->flags = IOSQE_BUFFER_SELECT;
+    entry->buf_group = BUFFER_GROUP_ID;
+    entry->user_data = userData(socketId, OperationType::Receive);
+    socket.IsReceiveArmed = true;
+}
+
+void IoUringEventLoop::armWake()
+{
+    io_uring_sqe* entry = getSubmissionEntry();
+    entry->opcode = IORING_OP_READ;
+    entry->fd = wakeEventHandle;
+    entry->addr = reinterpret_cast<uint64_t>(&wakeEventValue);
+    entry->len = sizeof(wakeEventValue);
+    entry->user_data = userData(0, OperationType::Wake);
+}
+
+void IoUringEventLoop::startNextSend(socket_id_t socketId, SocketState& socket)
+{
+    if (socket.IsSendInFlight || socket.SendQueue.empty())
+    {
+        return;
+    }
+
+    // Fold small queued chunks into one send
+    if ((socket.SendOffset == 0) && (socket.SendQueue.size() > 1))
+    {
+        auto& front = socket.SendQueue.front();
+        while ((socket.SendQueue.size() > 1) &&
+            ((front.size() + socket.SendQueue.at(1).size()) <= MAX_SEND_SIZE))
+        {
+            auto& next = socket.SendQueue.at(1);
+            front.insert(front.end(), next.begin(), next.end());
+            socket.SendQueue.erase(socket.SendQueue.begin() + 1);
+        }
+    }
+
+    const auto& front = socket.SendQueue.front();
+    io_uring_sqe* entry = getSubmissionEntry();
+    entry->opcode = IORING_OP_SEND;
+    entry->fd = socket.SocketHandle;
+    entry->addr = reinterpret_cast<uint64_t>(front.data() + socket.SendOffset);
+    entry->len = static_cast<uint32_t>(front.size() - socket.SendOffset);
+    entry->msg_flags = MSG_NOSIGNAL;
+    entry->user_data = userData(socketId, OperationType::Send);
+    socket.IsSendInFlight = true;
+}
+
+void IoUringEventLoop::shutDownSocket(SocketState& socket)
+{
+    // Wakes the multishot receive with an end of stream so it completes
+    if (!socket.IsShutDown)
+    {
+        shutdown(socket.SocketHandle, SHUT_RDWR);
+        socket.IsShutDown = true;
+    }
+}
+
+void IoUringEventLoop::finishClosingIfIdle(socket_id_t socketId)
+{
+    auto it = sockets.find(socketId);
+    if ((it == sockets.end()) ||
+        !it->second.IsClosing ||
+        it->second.IsReceiveArmed ||
+        it->second.IsSendInFlight)
+    {
+        return;
+    }
+    auto handler = it->second.Handler;
+    bool isRemoteClose = it->second.IsRemoteClose;
+    close(it->second.SocketHandle);
+    sockets.erase(it);
+    handler->OnSocketClosed(isRemoteClose);
+}
+
+void IoUringEventLoop::recycleBuffer(uint16_t bufferId)
+{
+    std::byte* buffer = (bufferMemory.data() + (bufferId * BUFFER_SIZE));
+    if (isBufferRingEnabled)
+    {
+        io_uring_buf& ringEntry = bufferRing->bufs[bufferRingTail & (BUFFER_COUNT - 1)];
+        ringEntry.addr = reinterpret_cast<uint64_t>(buffer);
+        ringEntry.len = BUFFER_SIZE;
+        ringEntry.bid = bufferId;
+        ++bufferRingTail;
+        __atomic_store_n(&bufferRing->tail, bufferRingTail, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        io_uring_sqe* entry = getSubmissionEntry();
+        entry->opcode = IORING_OP_PROVIDE_BUFFERS;
+        entry->fd = 1;
+        entry->addr = reinterpret_cast<uint64_t>(buffer);
+        entry->len = BUFFER_SIZE;
+        entry->off = bufferId;
+        entry->buf_group = BUFFER_GROUP_ID;
+        entry->user_data = userData(0, OperationType::ProvideBuffers);
+    }
+}
+
+uint64_t IoUringEventLoop::userData(socket_id_t socketId, OperationType operation)
+{
+    return ((socketId << 3) | static_cast<uint64_t>(operation));
+}
+#pragma endregion
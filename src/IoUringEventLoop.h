@@ -0,0 +1,211 @@
+/**
+ * @file IoUringEventLoop.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#pragma once
+
+#include "Metrics.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <linux/io_uring.h>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Receives events for a socket registered with an IoUringEventLoop. All methods are
+ *  called on the event loop thread.
+ */
+class IoUringSocketHandler
+{
+public:
+    virtual ~IoUringSocketHandler() = default;
+
+    /**
+     * @brief Bytes were received on the socket. The data is only valid during this call.
+     */
+    virtual void OnSocketReceived(const std::byte* data, size_t length) = 0;
+
+    /**
+     * @brief Bytes passed to Send() were written to the socket
+     */
+    virtual void OnSocketSent(size_t length) = 0;
+
+    /**
+     * @brief The socket has been closed (by either end) and will receive no further events
+     * @param isRemoteClose true if the peer closed the connection or an I/O error occurred,
+     *  false if CloseSocket() was called
+     */
+    virtual void OnSocketClosed(bool isRemoteClose) = 0;
+};
+
+/**
+ * @brief
+ *  IoUringEventLoop drives many sockets from a single thread using io_uring. Each socket has a
+ *  multishot receive armed against a pool of buffers provided to the kernel up front, and every
+ *  submission queued while handling one batch of completions (sends, re-arms, buffer returns,
+ *  closes) goes to the kernel in a single io_uring_enter call.
+ */
+class IoUringEventLoop
+{
+public:
+    typedef uint64_t socket_id_t;
+
+    /* Constructor/Destructor */
+    /**
+     * @param queueDepth submission queue entries; the completion queue is sized at 4x this
+     */
+    IoUringEventLoop(unsigned int queueDepth = DEFAULT_QUEUE_DEPTH);
+    ~IoUringEventLoop();
+    IoUringEventLoop(const IoUringEventLoop&) = delete;
+    IoUringEventLoop& operator=(const IoUringEventLoop&) = delete;
+
+    /* Static methods */
+    /**
+     * @brief Checks whether this kernel supports everything the event loop needs
+     *  (io_uring, provided buffer rings and multishot receive)
+     */
+    static bool IsSupported();
+
+    /* Public methods */
+    /**
+     * @brief Starts the event loop thread
+     */
+    void Start();
+
+    /**
+     * @brief Closes any remaining sockets and stops the event loop thread
+     */
+    void Stop();
+
+    /**
+     * @brief Queues a task to run on the event loop thread. Thread-safe.
+     * @return bool false if the event loop is not running and the task was dropped
+     */
+    bool Post(std::function<void()> task);
+
+    /**
+     * @brief Whether the calling thread is the event loop thread
+     */
+    bool IsLoopThread() const;
+
+    /**
+     * @brief Begins receiving on a connected socket. Loop thread only.
+     *  The loop owns the socket handle from this point and closes it when done.
+     */
+    socket_id_t AddSocket(int socketHandle, std::shared_ptr<IoUringSocketHandler> handler);
+
+    /**
+     * @brief Queues bytes to be sent, in order, on the given socket. Loop thread only.
+     */
+    void Send(socket_id_t socketId, std::vector<std::byte> bytes);
+
+    /**
+     * @brief Closes the socket once queued sends have been written. Loop thread only.
+     */
+    void CloseSocket(socket_id_t socketId);
+
+private:
+    /* Private types */
+    enum class OperationType : uint64_t
+    {
+        Receive = 1,
+        Send = 2,
+        Wake = 3,
+        ProvideBuffers = 4,
+    };
+
+    struct SocketState
+    {
+        int SocketHandle;
+        std::shared_ptr<IoUringSocketHandler> Handler;
+        std::deque<std::vector<std::byte>> SendQueue;
+        // Bytes of the front of SendQueue already written
+        size_t SendOffset = 0;
+        bool IsSendInFlight = false;
+        bool IsReceiveArmed = false;
+        bool IsClosing = false;
+        bool IsRemoteClose = false;
+        bool IsShutDown = false;
+    };
+
+    /* Static members */
+    static constexpr unsigned int DEFAULT_QUEUE_DEPTH = 1024;
+    static constexpr uint16_t BUFFER_GROUP_ID = 0;
+    static constexpr unsigned int BUFFER_COUNT = 1024; // Must be a power of two
+    static constexpr size_t BUFFER_SIZE = 4096;
+    // Largest single send we'll assemble by coalescing queued chunks
+    static constexpr size_t MAX_SEND_SIZE = 65536;
+
+    /* Private members */
+    const unsigned int queueDepth;
+    int ringHandle = -1;
+    // Submission queue
+    void* submissionRingMemory = nullptr;
+    size_t submissionRingSize = 0;
+    unsigned int* submissionHead = nullptr;
+    unsigned int* submissionTail = nullptr;
+    unsigned int submissionMask = 0;
+    unsigned int submissionEntryCount = 0;
+    unsigned int* submissionArray = nullptr;
+    io_uring_sqe* submissionEntries = nullptr;
+    size_t submissionEntriesSize = 0;
+    unsigned int pendingSubmissions = 0;
+    // Completion queue
+    void* completionRingMemory = nullptr;
+    size_t completionRingSize = 0;
+    unsigned int* completionHead = nullptr;
+    unsigned int* completionTail = nullptr;
+    unsigned int completionMask = 0;
+    io_uring_cqe* completionEntries = nullptr;
+    // Provided receive buffers. Handed to the kernel through a shared buffer ring where that
+    // works, otherwise with IORING_OP_PROVIDE_BUFFERS submissions.
+    bool isBufferRingEnabled = false;
+    io_uring_buf_ring* bufferRing = nullptr;
+    size_t bufferRingSize = 0;
+    std::vector<std::byte> bufferMemory;
+    uint16_t bufferRingTail = 0;
+    // Cross-thread wakeups
+    int wakeEventHandle = -1;
+    uint64_t wakeEventValue = 0;
+    std::mutex postedTasksMutex;
+    std::vector<std::function<void()>> postedTasks;
+    bool isWakePending = false;
+    // Loop state
+    std::atomic<bool> isRunning { false };
+    bool isStopRequested = false;
+    std::thread loopThread;
+    std::thread::id loopThreadId;
+    socket_id_t nextSocketId = 1;
+    std::unordered_map<socket_id_t, SocketState> sockets;
+    MetricHistogram& submitBatchSize;
+
+    /* Private methods */
+    void setUpRing();
+    void setUpBufferRing();
+    bool probeBufferRing();
+    void tearDown();
+    void loopThreadBody();
+    void runPostedTasks();
+    io_uring_sqe* getSubmissionEntry();
+    void submitAndWait();
+    void processCompletions();
+    void handleCompletion(const io_uring_cqe& completion);
+    void handleReceive(socket_id_t socketId, const io_uring_cqe& completion);
+    void handleSend(socket_id_t socketId, const io_uring_cqe& completion);
+    void armReceive(socket_id_t socketId, SocketState& socket);
+    void armWake();
+    void startNextSend(socket_id_t socketId, SocketState& socket);
+    void shutDownSocket(SocketState& socket);
+    void finishClosingIfIdle(socket_id_t socketId);
+    void recycleBuffer(uint16_t bufferId);
+    static uint64_t userData(socket_id_t socketId, OperationType operation);
+};
@@ -0,0 +1,396 @@
+/**
+ * @file IoUringTlsConnectionTransport.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include "IoUringTlsConnectionTransport.h"
+
+#include "Metrics.h"
+
+#include <openssl/bio.h>
+#include <openssl/ssl.h>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <unistd.h>
+
+#pragma region Constructor/Destructor
+IoUringTlsConnectionTransport::IoUringTlsConnectionTransport(
+    std::shared_ptr<IoUringEventLoop> eventLoop,
+    std::shared_ptr<TlsTransportContext> context,
+    int socketHandle,
+    sockaddr_in targetAddress
+) :
+    eventLoop(eventLoop),
+    context(context),
+    isServer(context->IsServer()),
+    socketHandle(socketHandle),
+    targetAddress(targetAddress),
+    closedFuture(closedPromise.get_future().share())
+{ }
+
+IoUringTlsConnectionTransport::~IoUringTlsConnectionTransport()
+{
+    // Once started, the event loop owns the socket handle
+    if (!isStarted)
+    {
+        close(socketHandle);
+    }
+}
+#pragma endregion
+
+#pragma region IConnectionTransport
+void IoUringTlsConnectionTransport::StartAsync()
+{
+    // OpenSSL talks to memory BIOs; the event loop moves ciphertext between them and the socket
+    ssl = context->NewSsl();
+    readBio = BIO_new(BIO_s_mem());
+    writeBio = BIO_new(BIO_s_mem());
+    if ((readBio == nullptr) || (writeBio == nullptr))
+    {
+        BIO_free(readBio);
+        BIO_free(writeBio);
+        throw std::runtime_error("Could not create SSL memory BIOs!");
+    }
+    SSL_set_bio(ssl.get(), readBio, writeBio);
+    if (isServer)
+    {
+        SSL_set_accept_state(ssl.get());
+    }
+    else
+    {
+        SSL_set_connect_state(ssl.get());
+    }
+
+    std::future<bool> handshakeFuture = handshakePromise.get_future();
+    handshakeStartTime = std::chrono::steady_clock::now();
+    // Cancelled once the handshake finishes either way, which always happens before we can be
+    // destructed, so the timer can hold a plain pointer
+    handshakeTimerId = context->GetTimerWheel().Schedule(
+        context->GetHandshakeTimeout(),
+        [this]()
+        {
+            eventLoop->Post([self = shared_from_this()]() { self->handshakeTimedOut(); });
+        });
+    isStarted = true;
+    bool isPosted = eventLoop->Post(
+        [self = shared_from_this()]()
+        {
+            self->socketId = self->eventLoop->AddSocket(self->socketHandle, self);
+            if (!self->isServer)
+            {
+                // Clients speak first
+                self->advanceHandshake();
+            }
+        });
+    if (!isPosted)
+    {
+        context->GetTimerWheel().Cancel(handshakeTimerId);
+        isStarted = false;
+        throw std::runtime_error("io_uring event loop is not running!");
+    }
+
+    // As with TlsConnectionTransport, servers hear about the handshake through the handshake
+    // complete callback while clients wait so they can start talking as soon as we return
+    if (!isServer && !eventLoop->IsLoopThread())
+    {
+        handshakeFuture.get();
+    }
+}
+
+void IoUringTlsConnectionTransport::Stop()
+{
+    if (!isStarted)
+    {
+        return;
+    }
+    if (!isStopRequested.exchange(true))
+    {
+        spdlog::debug("{} Stop() called", socketHandle);
+        eventLoop->Post(
+            [self = shared_from_this()]()
+            {
+                if (!self->isClosed && !self->isClosing)
+                {
+                    if (self->isHandshakeComplete)
+                    {
+                        SSL_shutdown(self->ssl.get());
+                        self->flushCiphertext();
+                    }
+                    self->closeConnection();
+                }
+            });
+    }
+
+    // The loop thread can't wait on itself; the socket finishes closing once we return to it
+    if (!eventLoop->IsLoopThread())
+    {
+        closedFuture.wait();
+    }
+}
+
+void IoUringTlsConnectionTransport::Write(const std::vector<std::byte>& bytes)
+{
+    if (isStopRequested || isClosed)
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(pendingWritesMutex);
+        pendingWrites.insert(pendingWrites.end(), bytes.begin(), bytes.end());
+        pendingWriteSize += bytes.size();
+        // Writes made before the loop gets around to flushing share one SSL_write and send
+        if (isFlushScheduled)
+        {
+            return;
+        }
+        isFlushScheduled = true;
+    }
+    eventLoop->Post([self = shared_from_this()]() { self->flushWrites(); });
+}
+
+size_t IoUringTlsConnectionTransport::GetPendingWriteSize()
+{
+    return pendingWriteSize;
+}
+
+void IoUringTlsConnectionTransport::SetOnWriteProgress(
+    std::function<void(size_t)> onWriteProgress)
+{
+    this->onWriteProgress = onWriteProgress;
+}
+
+void IoUringTlsConnectionTransport::SetOnBytesReceived(
+    std::function<void(const std::vector<std::byte>&)> onBytesReceived)
+{
+    this->onBytesReceived = onBytesReceived;
+}
+
+void IoUringTlsConnectionTransport::SetOnConnectionClosed(
+    std::function<void(void)> onConnectionClosed)
+{
+    this->onConnectionClosed = onConnectionClosed;
+}
+#pragma endregion
+
+#pragma region IoUringSocketHandler
+void IoUringTlsConnectionTransport::OnSocketReceived(const std::byte* data, size_t length)
+{
+    if (isClosing)
+    {
+        return;
+    }
+    if (BIO_write(readBio, data, static_cast<int>(length)) != static_cast<int>(length))
+    {
+        spdlog::error("{} Could not buffer received ciphertext", socketHandle);
+        closeConnection();
+        return;
+    }
+
+    if (!isHandshakeComplete)
+    {
+        advanceHandshake();
+        if (!isHandshakeComplete)
+        {
+            return;
+        }
+    }
+    readPlaintext();
+    flushCiphertext();
+}
+
+void IoUringTlsConnectionTransport::OnSocketSent(size_t length)
+{
+    size_t remainingSize = (pendingWriteSize -= length);
+    if (onWriteProgress && !isClosing)
+    {
+        onWriteProgress(remainingSize);
+    }
+}
+
+void IoUringTlsConnectionTransport::OnSocketClosed(bool isRemoteClose)
+{
+    spdlog::debug(
+        "{} CLOSED: Triggered by {}",
+        socketHandle,
+        isStopRequested ? "local" : "remote");
+    isClosing = true;
+    isClosed = true;
+    finishHandshake(false);
+    closedPromise.set_value();
+    // Like TlsConnectionTransport, only closes we didn't ask for are reported
+    if (!isStopRequested && onConnectionClosed)
+    {
+        onConnectionClosed();
+    }
+}
+#pragma endregion
+
+#pragma region Public methods
+void IoUringTlsConnectionTransport::SetOnHandshakeComplete(
+    std::function<void(bool)> onHandshakeComplete)
+{
+    this->onHandshakeComplete = onHandshakeComplete;
+}
+
+sockaddr_in IoUringTlsConnectionTransport::GetTargetAddress() const
+{
+    return targetAddress;
+}
+#pragma endregion
+
+#pragma region Private methods
+void IoUringTlsConnectionTransport::advanceHandshake()
+{
+    int connectResult = SSL_do_handshake(ssl.get());
+    if (connectResult != 1)
+    {
+        int connectError = SSL_get_error(ssl.get(), connectResult);
+        if (connectError == SSL_ERROR_WANT_READ)
+        {
+            // Send whatever this step produced and wait for the peer
+            flushCiphertext();
+            return;
+        }
+
+        // Unexpected error - close this connection, letting any alert go out first
+        flushCiphertext();
+        finishHandshake(false);
+        closeConnection();
+        return;
+    }
+
+    static MetricHistogram& handshakeDuration = MetricsRegistry::Default().GetHistogram(
+        "ftl_orchestrator_tls_handshake_duration_seconds",
+        "Time taken to complete TLS negotiation on a new connection",
+        std::string(),
+        1e-9);
+    handshakeDuration.RecordSince(handshakeStartTime);
+    spdlog::debug("{} SSL CONNECTED", socketHandle);
+    isHandshakeComplete = true;
+    finishHandshake(true);
+
+    // Application data may have arrived alongside the end of the handshake, and writes may
+    // have queued up while it was in progress
+    readPlaintext();
+    flushWrites();
+}
+
+void IoUringTlsConnectionTransport::readPlaintext()
+{
+    char readBuf[READ_BUFFER_SIZE];
+    while (!isClosing)
+    {
+        int bytesRead = SSL_read(ssl.get(), readBuf, sizeof(readBuf));
+        if (bytesRead > 0)
+        {
+            if (onBytesReceived)
+            {
+                onBytesReceived(
+                    std::vector<std::byte>(
+                        reinterpret_cast<std::byte*>(readBuf),
+                        (reinterpret_cast<std::byte*>(readBuf) + bytesRead)));
+            }
+            continue;
+        }
+
+        int readError = SSL_get_error(ssl.get(), bytesRead);
+        if (readError == SSL_ERROR_WANT_READ)
+        {
+            // Consumed everything received so far
+            return;
+        }
+        // SSL_ERROR_ZERO_RETURN (peer closed) or some other error - close
+        closeConnection();
+        return;
+    }
+}
+
+void IoUringTlsConnectionTransport::flushWrites()
+{
+    std::vector<std::byte> writes;
+    {
+        std::lock_guard<std::mutex> lock(pendingWritesMutex);
+        if (!isHandshakeComplete && !isClosing)
+        {
+            // Left in place; the handshake flushes them once it completes
+            isFlushScheduled = false;
+            return;
+        }
+        writes.swap(pendingWrites);
+        isFlushScheduled = false;
+    }
+    if (writes.empty() || isClosing)
+    {
+        return;
+    }
+
+    // Memory BIOs never block, so this either takes everything or fails outright
+    int sslWriteResult = SSL_write(ssl.get(), writes.data(), static_cast<int>(writes.size()));
+    if (sslWriteResult <= 0)
+    {
+        spdlog::error(
+            "{} SSL_write failed with error {}",
+            socketHandle,
+            SSL_get_error(ssl.get(), sslWriteResult));
+        closeConnection();
+        return;
+    }
+    pendingWriteSize -= writes.size();
+    flushCiphertext();
+}
+
+void IoUringTlsConnectionTransport::flushCiphertext()
+{
+    size_t pendingBytes = BIO_ctrl_pending(writeBio);
+    if (pendingBytes == 0)
+    {
+        return;
+    }
+    std::vector<std::byte> ciphertext(pendingBytes);
+    int bytesRead = BIO_read(writeBio, ciphertext.data(), static_cast<int>(pendingBytes));
+    if (bytesRead <= 0)
+    {
+        return;
+    }
+    ciphertext.resize(static_cast<size_t>(bytesRead));
+    pendingWriteSize += ciphertext.size();
+    eventLoop->Send(socketId, std::move(ciphertext));
+}
+
+void IoUringTlsConnectionTransport::finishHandshake(bool isSuccess)
+{
+    if (isHandshakeReported)
+    {
+        return;
+    }
+    isHandshakeReported = true;
+    // Waits out the timeout callback if it's running, since it touches this transport
+    context->GetTimerWheel().Cancel(handshakeTimerId);
+    handshakePromise.set_value(isSuccess);
+    if (onHandshakeComplete)
+    {
+        onHandshakeComplete(isSuccess);
+    }
+}
+
+void IoUringTlsConnectionTransport::handshakeTimedOut()
+{
+    if (!isHandshakeComplete && !isClosing)
+    {
+        spdlog::debug("{} SSL negotiation timed out", socketHandle);
+        finishHandshake(false);
+        closeConnection();
+    }
+}
+
+void IoUringTlsConnectionTransport::closeConnection()
+{
+    if (!isClosing)
+    {
+        isClosing = true;
+        eventLoop->CloseSocket(socketId);
+    }
+}
+#pragma endregion
@@ -0,0 +1,126 @@
+/**
+ * @file IoUringTlsConnectionTransport.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#pragma once
+
+#include "IConnectionTransport.h"
+#include "IoUringEventLoop.h"
+#include "OpenSslPtr.h"
+#include "TimerWheel.h"
+#include "TlsTransportContext.h"
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief
+ *  IoUringTlsConnectionTransport is a TLS connection driven by a shared IoUringEventLoop rather
+ *  than a thread of its own. OpenSSL runs over memory BIOs: ciphertext received by the loop is
+ *  fed in, and ciphertext OpenSSL produces is handed back to the loop to send.
+ *  Kernel TLS is not used, since OpenSSL never sees the socket.
+ */
+class IoUringTlsConnectionTransport :
+    public IConnectionTransport,
+    public IoUringSocketHandler,
+    public std::enable_shared_from_this<IoUringTlsConnectionTransport>
+{
+public:
+    /* Constructor/Destructor */
+    /**
+     * @brief Construct a new IoUringTlsConnectionTransport object
+     * @param eventLoop running event loop that will perform this connection's I/O
+     * @param context
+     *  shared TLS state (server or client role and pre-shared key) for this connection
+     * @param socketHandle the handle to the socket connection for this connection
+     * @param targetAddress the address that this connection is communicating with
+     */
+    IoUringTlsConnectionTransport(
+        std::shared_ptr<IoUringEventLoop> eventLoop,
+        std::shared_ptr<TlsTransportContext> context,
+        int socketHandle,
+        sockaddr_in targetAddress);
+    ~IoUringTlsConnectionTransport();
+
+    /* IConnectionTransport */
+    void StartAsync() override;
+    void Stop() override;
+    void Write(const std::vector<std::byte>& bytes) override;
+    size_t GetPendingWriteSize() override;
+    void SetOnWriteProgress(std::function<void(size_t)> onWriteProgress) override;
+    void SetOnBytesReceived(
+        std::function<void(const std::vector<std::byte>&)> onBytesReceived) override;
+    void SetOnConnectionClosed(std::function<void(void)> onConnectionClosed) override;
+
+    /* IoUringSocketHandler */
+    void OnSocketReceived(const std::byte* data, size_t length) override;
+    void OnSocketSent(size_t length) override;
+    void OnSocketClosed(bool isRemoteClose) override;
+
+    /* Public methods */
+    /**
+     * @brief
+     *  Sets the callback that will fire from the event loop thread once TLS negotiation has
+     *  either succeeded or failed (including timing out or being stopped). Must be set before
+     *  StartAsync().
+     * @param onHandshakeComplete callback to fire, with true if the handshake succeeded
+     */
+    void SetOnHandshakeComplete(std::function<void(bool)> onHandshakeComplete);
+
+    sockaddr_in GetTargetAddress() const;
+
+private:
+    /* Static members */
+    static constexpr int READ_BUFFER_SIZE = 16384;
+
+    /* Private members */
+    const std::shared_ptr<IoUringEventLoop> eventLoop;
+    const std::shared_ptr<TlsTransportContext> context;
+    const bool isServer;
+    const int socketHandle;
+    sockaddr_in targetAddress;
+    SslPtr ssl;
+    BIO* readBio = nullptr; // Owned by ssl
+    BIO* writeBio = nullptr; // Owned by ssl
+    std::function<void(const std::vector<std::byte>&)> onBytesReceived;
+    std::function<void(void)> onConnectionClosed;
+    std::function<void(bool)> onHandshakeComplete;
+    std::function<void(size_t)> onWriteProgress;
+    bool isStarted = false;
+    std::atomic<bool> isStopRequested { false };
+    std::atomic<bool> isClosed { false };
+    std::promise<void> closedPromise;
+    std::shared_future<void> closedFuture;
+    std::promise<bool> handshakePromise;
+    TimerWheel::timer_id_t handshakeTimerId = 0;
+    // Loop thread only
+    IoUringEventLoop::socket_id_t socketId = 0;
+    bool isClosing = false;
+    bool isHandshakeComplete = false;
+    bool isHandshakeReported = false;
+    std::chrono::steady_clock::time_point handshakeStartTime;
+    // Plaintext waiting for the next flush on the loop thread
+    std::mutex pendingWritesMutex;
+    std::vector<std::byte> pendingWrites;
+    bool isFlushScheduled = false;
+    // Plaintext waiting to be encrypted plus ciphertext waiting on the event loop to send it
+    std::atomic<size_t> pendingWriteSize { 0 };
+
+    /* Private methods */
+    void advanceHandshake();
+    void readPlaintext();
+    void flushWrites();
+    void flushCiphertext();
+    void finishHandshake(bool isSuccess);
+    void handshakeTimedOut();
+    void closeConnection();
+};
@@ -0,0 +1,227 @@
+/**
+ * @file LocalHttpServer.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include "LocalHttpServer.h"
+
+#include "Util.h"
+
+#include <spdlog/spdlog.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#pragma region Constructor/Destructor
+LocalHttpServer::LocalHttpServer(in_port_t listenPort) :
+    listenPort(listenPort)
+{ }
+
+LocalHttpServer::~LocalHttpServer()
+{
+    Stop();
+}
+#pragma endregion
+
+#pragma region Public methods
+void LocalHttpServer::AddRoute(std::string method, std::string path, http_handler_t handler)
+{
+    std::lock_guard<std::mutex> lock(routesMutex);
+    routes[std::make_pair(method, path)] = handler;
+}
+
+void LocalHttpServer::Start()
+{
+    sockaddr_in listenAddr
+    {
+        .sin_family = AF_INET,
+        .sin_port = htons(listenPort),
+        .sin_addr = { .s_addr = htonl(INADDR_LOOPBACK) }
+    };
+
+    listenSocketHandle = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (listenSocketHandle < 0)
+    {
+        int error = errno;
+        std::stringstream errStr;
+        errStr << "Unable to create HTTP listen socket! Error "
+            << error << ": " << Util::ErrnoToString(error);
+        throw std::runtime_error(errStr.str());
+    }
+
+    int reUseOption = 1;
+    setsockopt(listenSocketHandle, SOL_SOCKET, SO_REUSEADDR, &reUseOption, sizeof(reUseOption));
+
+    if ((bind(
+            listenSocketHandle,
+            reinterpret_cast<const sockaddr*>(&listenAddr),
+            sizeof(listenAddr)) < 0) ||
+        (listen(listenSocketHandle, SOCKET_LISTEN_QUEUE_LIMIT) < 0))
+    {
+        int error = errno;
+        close(listenSocketHandle);
+        listenSocketHandle = -1;
+        std::stringstream errStr;
+        errStr << "Unable to listen for HTTP on port " << listenPort << "! Error "
+            << error << ": " << Util::ErrnoToString(error);
+        throw std::runtime_error(errStr.str());
+    }
+
+    spdlog::info("LocalHttpServer: Listening on 127.0.0.1:{}...", listenPort);
+    serverThread = std::thread(&LocalHttpServer::serverThreadBody, this);
+}
+
+void LocalHttpServer::Stop()
+{
+    if (isStopping.exchange(true) || (listenSocketHandle < 0))
+    {
+        return;
+    }
+    shutdown(listenSocketHandle, SHUT_RDWR);
+    close(listenSocketHandle);
+    if (serverThread.joinable())
+    {
+        serverThread.join();
+    }
+}
+#pragma endregion
+
+#pragma region Private methods
+void LocalHttpServer::serverThreadBody()
+{
+    while (true)
+    {
+        int clientHandle = accept(listenSocketHandle, nullptr, nullptr);
+        if (clientHandle < 0)
+        {
+            if (isStopping)
+            {
+                break;
+            }
+            int error = errno;
+            spdlog::warn("LocalHttpServer: accept failed with error {}: {}",
+                error, Util::ErrnoToString(error));
+            continue;
+        }
+        handleClient(clientHandle);
+        close(clientHandle);
+    }
+}
+
+void LocalHttpServer::handleClient(int clientHandle)
+{
+    // Don't let a stalled client hold up everyone else
+    timeval timeout { .tv_sec = 1, .tv_usec = 0 };
+    setsockopt(clientHandle, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(clientHandle, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    // We only care about the request line and ignore headers and bodies
+    std::string requestBuffer;
+    char readBuffer[1024];
+    while (requestBuffer.find("\r\n") == std::string::npos)
+    {
+        ssize_t bytesRead = read(clientHandle, readBuffer, sizeof(readBuffer));
+        if ((bytesRead <= 0) || ((requestBuffer.size() + bytesRead) > MAX_REQUEST_SIZE))
+        {
+            return;
+        }
+        requestBuffer.append(readBuffer, bytesRead);
+    }
+
+    HttpResponse response;
+    try
+    {
+        response = dispatch(parseRequestLine(requestBuffer.substr(0, requestBuffer.find("\r\n"))));
+    }
+    catch (const std::exception& e)
+    {
+        response = HttpResponse { .StatusCode = 500, .Body = e.what() };
+    }
+
+    std::stringstream responseStream;
+    responseStream << "HTTP/1.0 " << response.StatusCode << " " << statusText(response.StatusCode)
+        << "\r\nContent-Type: " << response.ContentType
+        << "\r\nContent-Length: " << response.Body.size()
+        << "\r\nConnection: close\r\n\r\n" << response.Body;
+    std::string responseBytes = responseStream.str();
+    size_t written = 0;
+    while (written < responseBytes.size())
+    {
+        ssize_t writeResult = write(
+            clientHandle,
+            (responseBytes.data() + written),
+            (responseBytes.size() - written));
+        if (writeResult <= 0)
+        {
+            return;
+        }
+        written += writeResult;
+    }
+}
+
+HttpResponse LocalHttpServer::dispatch(const HttpRequest& request)
+{
+    http_handler_t handler;
+    {
+        std::lock_guard<std::mutex> lock(routesMutex);
+        auto route = routes.find(std::make_pair(request.Method, request.Path));
+        if (route == routes.end())
+        {
+            return HttpResponse { .StatusCode = 404, .Body = "Not Found\n" };
+        }
+        handler = route->second;
+    }
+    return handler(request);
+}
+
+HttpRequest LocalHttpServer::parseRequestLine(const std::string& requestLine)
+{
+    // e.g. "GET /metrics?foo=bar HTTP/1.1"
+    HttpRequest request;
+    std::string target;
+    std::stringstream lineStream(requestLine);
+    lineStream >> request.Method >> target;
+
+    size_t queryStart = target.find('?');
+    request.Path = target.substr(0, queryStart);
+    if (queryStart != std::string::npos)
+    {
+        std::stringstream queryStream(target.substr(queryStart + 1));
+        std::string parameter;
+        while (std::getline(queryStream, parameter, '&'))
+        {
+            size_t separator = parameter.find('=');
+            if (separator == std::string::npos)
+            {
+                request.QueryParameters[parameter] = std::string();
+            }
+            else
+            {
+                request.QueryParameters[parameter.substr(0, separator)] =
+                    parameter.substr(separator + 1);
+            }
+        }
+    }
+    return request;
+}
+
+std::string LocalHttpServer::statusText(int statusCode)
+{
+    switch (statusCode)
+    {
+    case 200:
+        return "OK";
+    case 400:
+        return "Bad Request";
+    case 404:
+        return "Not Found";
+    case 409:
+        return "Conflict";
+    default:
+        return "Internal Server Error";
+    }
+}
+#pragma endregion
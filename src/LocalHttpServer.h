@@ -0,0 +1,79 @@
+/**
+ * @file LocalHttpServer.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#pragma once
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+struct HttpRequest
+{
+    std::string Method;
+    std::string Path;
+    std::map<std::string, std::string> QueryParameters;
+};
+
+struct HttpResponse
+{
+    int StatusCode = 200;
+    std::string ContentType = "text/plain; charset=utf-8";
+    std::string Body;
+};
+
+typedef std::function<HttpResponse(const HttpRequest&)> http_handler_t;
+
+/**
+ * @brief
+ *  A minimal plain-HTTP/1.0 server bound to the loopback interface, used to expose metrics
+ *  and local tooling endpoints. Requests are served one at a time on a dedicated thread, so
+ *  handlers should be quick.
+ */
+class LocalHttpServer
+{
+public:
+    /* Constructor/Destructor */
+    LocalHttpServer(in_port_t listenPort);
+    ~LocalHttpServer();
+
+    /* Public methods */
+    /**
+     * @brief Registers a handler for the given method and path (query string excluded)
+     */
+    void AddRoute(std::string method, std::string path, http_handler_t handler);
+
+    /**
+     * @brief Binds the listening socket and starts serving requests on a new thread
+     */
+    void Start();
+
+    /**
+     * @brief Stops serving requests and waits for the server thread to exit
+     */
+    void Stop();
+
+private:
+    static constexpr int SOCKET_LISTEN_QUEUE_LIMIT = 16;
+    static constexpr size_t MAX_REQUEST_SIZE = 8192;
+    const in_port_t listenPort;
+    int listenSocketHandle = -1;
+    std::atomic<bool> isStopping { false };
+    std::thread serverThread;
+    std::mutex routesMutex;
+    std::map<std::pair<std::string, std::string>, http_handler_t> routes;
+
+    /* Private methods */
+    void serverThreadBody();
+    void handleClient(int clientHandle);
+    HttpResponse dispatch(const HttpRequest& request);
+    static HttpRequest parseRequestLine(const std::string& requestLine);
+    static std::string statusText(int statusCode);
+};
@@ -0,0 +1,53 @@
+/**
+ * @file Logging.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include "Logging.h"
+
+#include <spdlog/async.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+#pragma region Public methods
+void Logging::InitAsync(spdlog::level::level_enum level, size_t queueSize, bool dropOnOverflow)
+{
+    spdlog::init_thread_pool(queueSize, 1 /*thread_count*/);
+    auto sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+    auto logger = std::make_shared<spdlog::async_logger>(
+        "orchestrator",
+        sink,
+        spdlog::thread_pool(),
+        dropOnOverflow ? 
+            spdlog::async_overflow_policy::overrun_oldest :
+            spdlog::async_overflow_policy::block);
+    logger->set_level(level);
+    // Errors should reach the sink promptly even if nobody else is logging
+    logger->flush_on(spdlog::level::err);
+    spdlog::set_default_logger(logger);
+}
+
+void Logging::Shutdown()
+{
+    if (spdlog::thread_pool() != nullptr)
+    {
+        size_t droppedMessages = GetDroppedMessageCount();
+        if (droppedMessages > 0)
+        {
+            spdlog::warn("Logging: {} log messages were dropped due to queue overflow.",
+                droppedMessages);
+        }
+    }
+    spdlog::shutdown();
+}
+
+size_t Logging::GetDroppedMessageCount()
+{
+    if (auto threadPool = spdlog::thread_pool())
+    {
+        return threadPool->overrun_counter();
+    }
+    return 0;
+}
+#pragma endregion
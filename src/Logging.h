@@ -0,0 +1,41 @@
+/**
+ * @file Logging.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ * @brief Sets up the asynchronous logging pipeline used by the orchestrator
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <spdlog/common.h>
+
+/**
+ * @brief
+ *  Logging moves log formatting and sink I/O off of connection threads. Log calls enqueue
+ *  messages into a fixed-size queue that is drained by a dedicated sink thread.
+ */
+class Logging
+{
+public:
+    /**
+     * @brief Replaces the default logger with an asynchronous logger
+     * @param level minimum level that will be logged; anything lower is never formatted
+     * @param queueSize maximum number of messages waiting to be written by the sink thread
+     * @param dropOnOverflow
+     *  true to discard the oldest queued message when the queue is full,
+     *  false to block the logging thread until there is room
+     */
+    static void InitAsync(spdlog::level::level_enum level, size_t queueSize, bool dropOnOverflow);
+
+    /**
+     * @brief Flushes any queued messages and stops the sink thread
+     */
+    static void Shutdown();
+
+    /**
+     * @brief Number of messages that were discarded because the queue was full
+     */
+    static size_t GetDroppedMessageCount();
+};
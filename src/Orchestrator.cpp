@@ -12,14 +12,45 @@
 #include "StreamStore.h"
 #include "Util.h"
 
+#include <algorithm>
 #include <list>
 
 #pragma region Constructor/Destructor
 template <class TConnection>
 Orchestrator<TConnection>::Orchestrator(
-    std::unique_ptr<IConnectionManager<TConnection>> connectionManager
+    std::unique_ptr<IConnectionManager<TConnection>> connectionManager,
+    OrchestratorOptions options
 ) : 
-    connectionManager(std::move(connectionManager))
+    connectionManager(std::move(connectionManager)),
+    options(options),
+    relayFanOut(MetricsRegistry::Default().GetHistogram(
+        "ftl_orchestrator_relay_fan_out",
+        "Number of relays opened when a stream is published")),
+    heartbeatTimeouts(MetricsRegistry::Default().GetCounter(
+        "ftl_orchestrator_heartbeat_timeouts_total",
+        "Connections closed after going silent for too many heartbeat intervals")),
+    slowConsumerDisconnects(MetricsRegistry::Default().GetCounter(
+        "ftl_orchestrator_slow_consumer_disconnects_total",
+        "Connections closed after too many messages backed up waiting to be sent to them")),
+    coalescedRelayCommands(MetricsRegistry::Default().GetCounter(
+        "ftl_orchestrator_coalesced_relay_commands_total",
+        "Relay commands never sent because another in the same batching window repeated or "
+        "cancelled them")),
+    reusedLingeringRoutes(MetricsRegistry::Default().GetCounter(
+        "ftl_orchestrator_reused_lingering_routes_total",
+        "Resubscriptions served by a route kept open after the edge unsubscribed")),
+    snapshotWrites(MetricsRegistry::Default().GetCounter(
+        "ftl_orchestrator_snapshot_writes_total",
+        "State snapshots written")),
+    snapshotFailures(MetricsRegistry::Default().GetCounter(
+        "ftl_orchestrator_snapshot_failures_total",
+        "State snapshots that could not be written")),
+    restoredRoutes(MetricsRegistry::Default().GetCounter(
+        "ftl_orchestrator_restored_routes_total",
+        "Routes from a snapshot kept running when both of their nodes reconnected")),
+    replicatedEvents(MetricsRegistry::Default().GetCounter(
+        "ftl_orchestrator_replicated_events_total",
+        "State changes streamed to standby orchestrators"))
 { }
 #pragma endregion
 
@@ -31,114 +62,1096 @@ void Orchestrator<TConnection>::Init()
     connectionManager->SetOnNewConnection(
         std::bind(&Orchestrator::newConnection, this, std::placeholders::_1));
 
+    // Expose store sizes, read whenever metrics are scraped
+    auto& registry = MetricsRegistry::Default();
+    metricGauges.push_back(registry.AddGauge(
+        "ftl_orchestrator_streams",
+        "Streams currently published",
+        [this]() { return static_cast<double>(streamStore.GetStreamCount()); }));
+    metricGauges.push_back(registry.AddGauge(
+        "ftl_orchestrator_subscriptions",
+        "Channel subscriptions currently held by nodes",
+        [this]() { return static_cast<double>(subscriptions.GetSubscriptionCount()); }));
+    metricGauges.push_back(registry.AddGauge(
+        "ftl_orchestrator_connections",
+        "Connections that have completed an intro",
+        [this]()
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            return static_cast<double>(connections.size());
+        }));
+    metricGauges.push_back(registry.AddGauge(
+        "ftl_orchestrator_pending_connections",
+        "Connections waiting on an intro",
+        [this]()
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            return static_cast<double>(pendingConnections.size());
+        }));
+    metricGauges.push_back(registry.AddGauge(
+        "ftl_orchestrator_backed_up_connections",
+        "Connections holding back messages until their peer catches up",
+        [this]()
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            return static_cast<double>(backedUpConnections.size());
+        }));
+    metricGauges.push_back(registry.AddGauge(
+        "ftl_orchestrator_lingering_routes",
+        "Routes kept open after their edge unsubscribed",
+        [this]()
+        {
+            std::lock_guard<std::mutex> lock(lingeringRoutesMutex);
+            return static_cast<double>(lingeringRoutes.size());
+        }));
+    metricGauges.push_back(registry.AddGauge(
+        "ftl_orchestrator_standbys",
+        "Standby orchestrators receiving our state changes",
+        [this]()
+        {
+            std::lock_guard<std::mutex> lock(standbysMutex);
+            return static_cast<double>(standbys.size());
+        }));
+
+    if (!options.CapturePath.empty())
+    {
+        capture = std::make_unique<TrafficCapture>(options.CapturePath);
+        spdlog::info("Orchestrator: Capturing received messages to {}", options.CapturePath);
+    }
+
+    if (!options.SnapshotPath.empty() || !options.JournalPath.empty())
+    {
+        loadState();
+        if (!options.SnapshotPath.empty() && (options.SnapshotInterval.count() > 0))
+        {
+            schedulePeriodicSnapshot();
+        }
+    }
+
     connectionManager->Init();
 }
 
 template <class TConnection>
-void Orchestrator<TConnection>::Run(std::promise<void>&& readyListeningPromise)
+void Orchestrator<TConnection>::Run(std::promise<void>&& readyListeningPromise)
+{
+    connectionManager->Listen(std::move(readyListeningPromise)); // This call will block
+
+    // If we've reached this point, we have stopped listening, and should disconnect all 
+    // outstanding connections.
+    if (!isStopping)
+    {
+        throw std::runtime_error("Connection manager stopped listening unexpectedly");
+    }
+
+    // Take a copy of all active connections - avoid holding a lock while stopping connections,
+    // or we might deadlock if we catch a connection waiting on a lock to try to remove itself!
+    std::set<std::shared_ptr<TConnection>> activeConnections;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        activeConnections.insert(pendingConnections.begin(), pendingConnections.end());
+        activeConnections.insert(connections.begin(), connections.end());
+    }
+    {
+        std::lock_guard<std::mutex> lock(standbysMutex);
+        for (const auto& [standby, target] : standbys)
+        {
+            activeConnections.insert(standby);
+        }
+    }
+    for (const auto& connection : activeConnections)
+    {
+        connection->Stop();
+    }
+    
+    // *Now* we can lock and clear
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        pendingConnections.clear();
+        connections.clear();
+        backedUpConnections.clear();
+        nodeMetadata.clear();
+        captureConnectionIds.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(standbysMutex);
+        standbys.clear();
+        hasStandbys = false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(relayBatchesMutex);
+        relayBatches.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(lingeringRoutesMutex);
+        lingeringRoutes.clear();
+    }
+
+    // Clear all stores
+    streamStore.Clear();
+    subscriptions.Clear();
+}
+
+template <class TConnection>
+void Orchestrator<TConnection>::Stop()
+{
+    isStopping = true; // Indicate that we're stopping so we don't handle new connections
+                       // or closed events from connections we're getting rid of
+    // Persist our state before connections are torn down
+    WriteSnapshot();
+    connectionManager->StopListening();
+}
+
+template <class TConnection>
+bool Orchestrator<TConnection>::WriteSnapshot()
+{
+    if (options.SnapshotPath.empty())
+    {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(snapshotWriteMutex);
+    try
+    {
+        auto startTime = std::chrono::steady_clock::now();
+        // Everything journaled up to here has already been applied, so the snapshot covers it
+        uint64_t journalSequence = (journal ? journal->Rotate() : 0);
+        StateSnapshot snapshot = takeSnapshot();
+        snapshot.JournalSequence = journalSequence;
+        snapshot.WriteToFile(options.SnapshotPath);
+        snapshotWrites.Increment();
+        if (journal)
+        {
+            journal->RemoveSegmentsThrough(journalSequence);
+        }
+        spdlog::debug(
+            "Orchestrator: Wrote snapshot of {} nodes, {} streams, {} subscriptions and {} routes "
+            "in {} ms",
+            snapshot.Nodes.size(),
+            snapshot.Streams.size(),
+            snapshot.Subscriptions.size(),
+            snapshot.Routes.size(),
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - startTime).count());
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        snapshotFailures.Increment();
+        spdlog::error("Orchestrator: Could not write snapshot: {}", e.what());
+        return false;
+    }
+}
+
+template <class TConnection>
+void Orchestrator<TConnection>::RestoreState(StateSnapshot state)
+{
+    {
+        std::lock_guard<std::mutex> lock(provisionalMutex);
+        provisionalNodes.clear();
+        provisionalRoutes.clear();
+    }
+    provisionState(std::move(state));
+    // Make it durable before anything builds on it
+    WriteSnapshot();
+}
+
+template <class TConnection>
+const std::unique_ptr<IConnectionManager<TConnection>>&
+    Orchestrator<TConnection>::GetConnectionManager()
+{
+    return connectionManager;
+}
+
+template <class TConnection>
+const std::set<std::shared_ptr<TConnection>> Orchestrator<TConnection>::GetConnections()
+{
+    // Heartbeats can close connections from the timer thread
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    return connections;
+}
+
+template <class TConnection>
+std::set<ftl_channel_id_t> Orchestrator<TConnection>::GetSubscribedChannels(
+    std::shared_ptr<TConnection> connection)
+{
+    std::set<ftl_channel_id_t> returnVal;
+    for (const auto& sub : subscriptions.GetSubscriptions(connection))
+    {
+        returnVal.insert(sub.ChannelId);
+    }
+    return returnVal;
+}
+#pragma endregion
+
+#pragma region Private methods
+template <class TConnection>
+void Orchestrator<TConnection>::openRoute(
+    Stream<TConnection> stream,
+    std::shared_ptr<TConnection> edgeConnection,
+    std::vector<std::byte> streamKey)
+{
+    // TODO: Handle relays, generate real routes.
+    // for now, we just tell the ingest to start relaying directly to the edge node.
+    sendRelay(stream.IngestConnection, ConnectionRelayPayload
+        {
+            .IsStartRelay = true,
+            .ChannelId = stream.ChannelId,
+            .StreamId = stream.StreamId,
+            .TargetHostname = edgeConnection->GetHostname(),
+            .StreamKey = streamKey,
+        });
+    journalEvent(JournalEvent
+        {
+            .Type = JournalEventType::RouteOpen,
+            .Hostname = stream.IngestConnection->GetHostname(),
+            .ChannelId = stream.ChannelId,
+            .StreamId = stream.StreamId,
+            .TargetHostname = edgeConnection->GetHostname(),
+        });
+}
+
+template <class TConnection>
+void Orchestrator<TConnection>::closeRoute(
+    Stream<TConnection> stream,
+    std::shared_ptr<TConnection> edgeConnection)
+{
+    // TODO: Handle relays, generate real routes.
+    // for now, we just tell the ingest to stop relaying directly to the edge node.
+    sendRelay(stream.IngestConnection, ConnectionRelayPayload
+        {
+            .IsStartRelay = false,
+            .ChannelId = stream.ChannelId,
+            .StreamId = stream.StreamId,
+            .TargetHostname = edgeConnection->GetHostname(),
+            .StreamKey = std::vector<std::byte>(),
+        });
+    journalEvent(JournalEvent
+        {
+            .Type = JournalEventType::RouteClose,
+            .Hostname = stream.IngestConnection->GetHostname(),
+            .ChannelId = stream.ChannelId,
+            .StreamId = stream.StreamId,
+            .TargetHostname = edgeConnection->GetHostname(),
+        });
+}
+
+template <class TConnection>
+void Orchestrator<TConnection>::closeAllRoutes(Stream<TConnection> stream)
+{
+    // Gather every subscriber up front so all stop commands go out in a single pass
+    std::vector<ChannelSubscription<TConnection>> channelSubs = 
+        subscriptions.GetSubscriptions(stream.ChannelId);
+    for (const auto& subscription : channelSubs)
+    {
+        closeRoute(stream, subscription.SubscribedConnection);
+    }
+}
+
+template <class TConnection>
+void Orchestrator<TConnection>::sendRelay(
+    std::shared_ptr<TConnection> ingestConnection,
+    ConnectionRelayPayload payload)
+{
+    if (options.RelayBatchWindow.count() <= 0)
+    {
+        ingestConnection->SendStreamRelay(payload);
+        return;
+    }
+
+    bool isNewBatch = false;
+    {
+        std::lock_guard<std::mutex> lock(relayBatchesMutex);
+        auto batchIt = relayBatches.find(ingestConnection);
+        if (batchIt == relayBatches.end())
+        {
+            batchIt = relayBatches.emplace(
+                ingestConnection,
+                std::map<RelayRouteKey, ConnectionRelayPayload>()).first;
+            isNewBatch = true;
+        }
+        auto& batch = batchIt->second;
+
+        RelayRouteKey key
+        {
+            .ChannelId = payload.ChannelId,
+            .StreamId = payload.StreamId,
+            .TargetHostname = payload.TargetHostname,
+        };
+        auto commandIt = batch.find(key);
+        if (commandIt == batch.end())
+        {
+            batch.emplace(std::move(key), std::move(payload));
+        }
+        else if (commandIt->second.IsStartRelay == payload.IsStartRelay)
+        {
+            // Repeated; the ingest only needs to hear it once, with the latest stream key
+            commandIt->second = std::move(payload);
+            coalescedRelayCommands.Increment();
+        }
+        else
+        {
+            // A start and a stop in the same window leave the route as the ingest already has it
+            batch.erase(commandIt);
+            coalescedRelayCommands.Increment(2);
+        }
+    }
+
+    if (isNewBatch)
+    {
+        std::weak_ptr<TConnection> weakIngestConnection(ingestConnection);
+        timers.Schedule(
+            options.RelayBatchWindow,
+            [this, weakIngestConnection]() { flushRelayBatch(weakIngestConnection); });
+    }
+}
+
+template <class TConnection>
+void Orchestrator<TConnection>::flushRelayBatch(std::weak_ptr<TConnection> ingestConnection)
+{
+    auto strongIngestConnection = ingestConnection.lock();
+    if (!strongIngestConnection || isStopping)
+    {
+        return;
+    }
+
+    std::map<RelayRouteKey, ConnectionRelayPayload> batch;
+    {
+        std::lock_guard<std::mutex> lock(relayBatchesMutex);
+        auto batchIt = relayBatches.find(strongIngestConnection);
+        if (batchIt == relayBatches.end())
+        {
+            return;
+        }
+        batch = std::move(batchIt->second);
+        relayBatches.erase(batchIt);
+    }
+    for (const auto& [key, payload] : batch)
+    {
+        strongIngestConnection->SendStreamRelay(payload);
+    }
+}
+
+template <class TConnection>
+std::chrono::milliseconds Orchestrator<TConnection>::routeLingerFor(ftl_channel_id_t channelId)
+{
+    auto channelLingerIt = options.ChannelRouteLinger.find(channelId);
+    if (channelLingerIt != options.ChannelRouteLinger.end())
+    {
+        return channelLingerIt->second;
+    }
+    return options.RouteLinger;
+}
+
+template <class TConnection>
+void Orchestrator<TConnection>::lingerRoute(
+    Stream<TConnection> stream,
+    std::shared_ptr<TConnection> edgeConnection,
+    std::vector<std::byte> streamKey)
+{
+    std::weak_ptr<TConnection> weakEdgeConnection(edgeConnection);
+    ftl_channel_id_t channelId = stream.ChannelId;
+    std::optional<TimerWheel::timer_id_t> replacedTimerId;
+    {
+        std::lock_guard<std::mutex> lock(lingeringRoutesMutex);
+        uint64_t lingerId = nextLingerId++;
+        // Holding the lock keeps the expiry from looking for this entry before it exists
+        TimerWheel::timer_id_t timerId = timers.Schedule(
+            routeLingerFor(channelId),
+            [this, weakEdgeConnection, channelId, lingerId]()
+            {
+                expireLingeringRoute(weakEdgeConnection, channelId, lingerId);
+            });
+        LingeringRoute lingeringRoute
+        {
+            .RoutedStream = stream,
+            .StreamKey = std::move(streamKey),
+            .LingerId = lingerId,
+            .TimerId = timerId,
+        };
+        auto [lingeringIt, isInserted] = lingeringRoutes.try_emplace(
+            lingering_route_key_t(edgeConnection, channelId),
+            lingeringRoute);
+        if (!isInserted)
+        {
+            replacedTimerId = lingeringIt->second.TimerId;
+            lingeringIt->second = std::move(lingeringRoute);
+        }
+    }
+    // Cancelling waits on a running expiry, which needs the lock
+    if (replacedTimerId)
+    {
+        timers.Cancel(replacedTimerId.value());
+    }
+}
+
+template <class TConnection>
+bool Orchestrator<TConnection>::reuseLingeringRoute(
+    Stream<TConnection> stream,
+    std::shared_ptr<TConnection> edgeConnection,
+    const std::vector<std::byte>& streamKey)
+{
+    std::optional<LingeringRoute> lingeringRoute;
+    {
+        std::lock_guard<std::mutex> lock(lingeringRoutesMutex);
+        auto lingeringIt = lingeringRoutes.find(
+            lingering_route_key_t(edgeConnection, stream.ChannelId));
+        if (lingeringIt == lingeringRoutes.end())
+        {
+            return false;
+        }
+        lingeringRoute = std::move(lingeringIt->second);
+        lingeringRoutes.erase(lingeringIt);
+    }
+    timers.Cancel(lingeringRoute->TimerId);
+
+    if (!isStreamLive(lingeringRoute->RoutedStream))
+    {
+        // The stream it carried has ended, and the ingest has already been told to stop
+        return false;
+    }
+    if (lingeringRoute->StreamKey != streamKey)
+    {
+        // Relaying with a stream key the edge no longer expects
+        closeRoute(lingeringRoute->RoutedStream, edgeConnection);
+        return false;
+    }
+    spdlog::info(
+        "Orchestrator: Reusing lingering route for channel {} to {}",
+        stream.ChannelId,
+        edgeConnection->GetHostname());
+    reusedLingeringRoutes.Increment();
+    return true;
+}
+
+template <class TConnection>
+void Orchestrator<TConnection>::expireLingeringRoute(
+    std::weak_ptr<TConnection> edgeConnection,
+    ftl_channel_id_t channelId,
+    uint64_t lingerId)
+{
+    auto strongEdgeConnection = edgeConnection.lock();
+    if (!strongEdgeConnection || isStopping)
+    {
+        return;
+    }
+
+    Stream<TConnection> routedStream;
+    {
+        std::lock_guard<std::mutex> lock(lingeringRoutesMutex);
+        auto lingeringIt = lingeringRoutes.find(
+            lingering_route_key_t(strongEdgeConnection, channelId));
+        if ((lingeringIt == lingeringRoutes.end()) || (lingeringIt->second.LingerId != lingerId))
+        {
+            return;
+        }
+        routedStream = lingeringIt->second.RoutedStream;
+        lingeringRoutes.erase(lingeringIt);
+    }
+
+    // If the stream has ended since, the ingest has already been told to stop
+    if (isStreamLive(routedStream))
+    {
+        closeRoute(routedStream, strongEdgeConnection);
+    }
+}
+
+template <class TConnection>
+void Orchestrator<TConnection>::closeLingeringRoutes(
+    std::function<bool(const lingering_route_key_t&, const LingeringRoute&)> predicate)
+{
+    std::vector<std::pair<lingering_route_key_t, LingeringRoute>> closedRoutes;
+    {
+        std::lock_guard<std::mutex> lock(lingeringRoutesMutex);
+        for (auto lingeringIt = lingeringRoutes.begin(); lingeringIt != lingeringRoutes.end();)
+        {
+            if (predicate(lingeringIt->first, lingeringIt->second))
+            {
+                closedRoutes.emplace_back(lingeringIt->first, std::move(lingeringIt->second));
+                lingeringIt = lingeringRoutes.erase(lingeringIt);
+            }
+            else
+            {
+                ++lingeringIt;
+            }
+        }
+    }
+    for (const auto& [key, lingeringRoute] : closedRoutes)
+    {
+        timers.Cancel(lingeringRoute.TimerId);
+        if (isStreamLive(lingeringRoute.RoutedStream))
+        {
+            closeRoute(lingeringRoute.RoutedStream, key.first);
+        }
+    }
+}
+
+template <class TConnection>
+bool Orchestrator<TConnection>::isStreamLive(const Stream<TConnection>& stream)
+{
+    auto liveStream = streamStore.GetStreamByChannelId(stream.ChannelId);
+    return (liveStream && (liveStream->StreamId == stream.StreamId) &&
+        (liveStream->IngestConnection == stream.IngestConnection));
+}
+
+template <class TConnection>
+void Orchestrator<TConnection>::journalEvent(JournalEvent event)
+{
+    // Whatever we tear down while stopping is still there when we start again
+    if (isStopping)
+    {
+        return;
+    }
+    replicateEvent(event);
+    if (journal)
+    {
+        journal->Append(std::move(event));
+    }
+}
+
+template <class TConnection>
+void Orchestrator<TConnection>::replicateEvent(const JournalEvent& event)
+{
+    if (!hasStandbys)
+    {
+        return;
+    }
+    BinaryWriter writer;
+    event.WriteTo(writer);
+    ConnectionReplicationPayload payload
+    {
+        .IsSubscribe = false,
+        .Events = std::move(writer.GetBuffer()),
+    };
+
+    std::lock_guard<std::mutex> lock(standbysMutex);
+    for (auto& [standby, target] : standbys)
+    {
+        if (target.IsSynced)
+        {
+            standby->SendStateReplication(payload);
+        }
+        else
+        {
+            target.Backlog.push_back(event);
+        }
+    }
+    replicatedEvents.Increment();
+}
+
+template <class TConnection>
+void Orchestrator<TConnection>::sendReplication(
+    const std::shared_ptr<TConnection>& standby,
+    const std::vector<JournalEvent>& events)
+{
+    BinaryWriter writer;
+    for (const auto& event : events)
+    {
+        event.WriteTo(writer);
+        if (writer.GetBuffer().size() >= REPLICATION_MESSAGE_LENGTH)
+        {
+            standby->SendStateReplication(ConnectionReplicationPayload
+                {
+                    .IsSubscribe = false,
+                    .Events = std::move(writer.GetBuffer()),
+                });
+            writer.GetBuffer().clear();
+        }
+    }
+    if (!writer.GetBuffer().empty())
+    {
+        standby->SendStateReplication(ConnectionReplicationPayload
+            {
+                .IsSubscribe = false,
+                .Events = std::move(writer.GetBuffer()),
+            });
+    }
+}
+
+template <class TConnection>
+void Orchestrator<TConnection>::captureMessage(
+    const std::shared_ptr<TConnection>& connection,
+    captured_message_t message)
+{
+    if (!capture)
+    {
+        return;
+    }
+    uint32_t connectionId;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        auto idIt = captureConnectionIds.find(connection);
+        if (idIt == captureConnectionIds.end())
+        {
+            return;
+        }
+        connectionId = idIt->second;
+    }
+    capture->Record(connectionId, std::move(message));
+}
+
+template <class TConnection>
+StateSnapshot Orchestrator<TConnection>::takeSnapshot()
+{
+    StateSnapshot snapshot;
+    snapshot.WrittenAt = std::chrono::system_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        for (const auto& [connection, node] : nodeMetadata)
+        {
+            snapshot.Nodes.push_back(node);
+            snapshot.Nodes.back().Hostname = connection->GetHostname();
+        }
+    }
+    for (const auto& stream : streamStore.GetAllStreams())
+    {
+        std::string ingestHostname = stream.IngestConnection->GetHostname();
+        snapshot.Streams.push_back(SnapshotStream
+            {
+                .IngestHostname = ingestHostname,
+                .ChannelId = stream.ChannelId,
+                .StreamId = stream.StreamId,
+            });
+        for (const auto& subscription : subscriptions.GetSubscriptions(stream.ChannelId))
+        {
+            snapshot.Routes.push_back(SnapshotRoute
+                {
+                    .ChannelId = stream.ChannelId,
+                    .StreamId = stream.StreamId,
+                    .IngestHostname = ingestHostname,
+                    .TargetHostname = subscription.SubscribedConnection->GetHostname(),
+                });
+        }
+    }
+    for (const auto& subscription : subscriptions.GetAllSubscriptions())
+    {
+        snapshot.Subscriptions.push_back(SnapshotSubscription
+            {
+                .EdgeHostname = subscription.SubscribedConnection->GetHostname(),
+                .ChannelId = subscription.ChannelId,
+                .StreamKey = subscription.StreamKey,
+            });
+    }
+    {
+        // Lingering routes are still running on their ingest
+        std::lock_guard<std::mutex> lock(lingeringRoutesMutex);
+        for (const auto& [key, lingeringRoute] : lingeringRoutes)
+        {
+            snapshot.Routes.push_back(SnapshotRoute
+                {
+                    .ChannelId = lingeringRoute.RoutedStream.ChannelId,
+                    .StreamId = lingeringRoute.RoutedStream.StreamId,
+                    .IngestHostname = lingeringRoute.RoutedStream.IngestConnection->GetHostname(),
+                    .TargetHostname = key.first->GetHostname(),
+                });
+        }
+    }
+    {
+        // Carry over anything restored from the last snapshot that hasn't been claimed yet, so
+        // restarting twice in quick succession doesn't lose it
+        std::lock_guard<std::mutex> lock(provisionalMutex);
+        for (const auto& [hostname, provisionalNode] : provisionalNodes)
+        {
+            if (provisionalNode.Node)
+            {
+                snapshot.Nodes.push_back(provisionalNode.Node.value());
+            }
+            snapshot.Streams.insert(
+                snapshot.Streams.end(),
+                provisionalNode.Streams.begin(),
+                provisionalNode.Streams.end());
+            snapshot.Subscriptions.insert(
+                snapshot.Subscriptions.end(),
+                provisionalNode.Subscriptions.begin(),
+                provisionalNode.Subscriptions.end());
+        }
+        snapshot.Routes.insert(
+            snapshot.Routes.end(),
+            provisionalRoutes.begin(),
+            provisionalRoutes.end());
+    }
+    std::sort(snapshot.Routes.begin(), snapshot.Routes.end());
+    snapshot.Routes.erase(
+        std::unique(snapshot.Routes.begin(), snapshot.Routes.end()),
+        snapshot.Routes.end());
+    return snapshot;
+}
+
+template <class TConnection>
+void Orchestrator<TConnection>::loadState()
+{
+    StateSnapshot state;
+    bool isSnapshotRestored = false;
+    if (!options.SnapshotPath.empty())
+    {
+        try
+        {
+            if (std::optional<StateSnapshot> snapshot =
+                StateSnapshot::ReadFromFile(options.SnapshotPath))
+            {
+                state = std::move(snapshot.value());
+                isSnapshotRestored = true;
+                spdlog::info(
+                    "Orchestrator: Read snapshot taken {} s ago",
+                    std::chrono::duration_cast<std::chrono::seconds>(
+                        std::chrono::system_clock::now() - state.WrittenAt).count());
+            }
+            else
+            {
+                spdlog::info("Orchestrator: No snapshot at {}", options.SnapshotPath);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error("Orchestrator: Ignoring snapshot {}: {}", options.SnapshotPath, e.what());
+        }
+    }
+
+    // Replay whatever happened after the snapshot was taken
+    size_t replayedEventCount = 0;
+    uint64_t lastSequence = state.JournalSequence;
+    if (!options.JournalPath.empty())
+    {
+        if (options.SnapshotPath.empty())
+        {
+            spdlog::warn(
+                "Orchestrator: Journaling without snapshots; the journal will grow without bound");
+        }
+        try
+        {
+            std::vector<JournalEvent> events =
+                EventJournal::ReadEvents(options.JournalPath, state.JournalSequence);
+            if (!events.empty())
+            {
+                lastSequence = events.back().Sequence;
+            }
+            if (!events.empty() && (events.front().Sequence != (state.JournalSequence + 1)))
+            {
+                // Applying events to state they weren't recorded against would invent routes
+                spdlog::error(
+                    "Orchestrator: Ignoring journal {}, it starts at event {} but the snapshot "
+                    "ends at event {}",
+                    options.JournalPath,
+                    events.front().Sequence,
+                    state.JournalSequence);
+            }
+            else
+            {
+                for (const auto& event : events)
+                {
+                    event.ApplyTo(state);
+                }
+                replayedEventCount = events.size();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error(
+                "Orchestrator: Ignoring journal {}: {}",
+                options.JournalPath,
+                e.what());
+        }
+        journal = std::make_unique<EventJournal>(
+            options.JournalPath,
+            options.JournalFsync,
+            options.JournalFsyncInterval,
+            (lastSequence + 1));
+    }
+
+    if (!isSnapshotRestored && (replayedEventCount == 0))
+    {
+        spdlog::info("Orchestrator: Nothing to restore, starting with no state");
+        return;
+    }
+    if (replayedEventCount > 0)
+    {
+        spdlog::info(
+            "Orchestrator: Replayed {} journaled events from {}",
+            replayedEventCount,
+            options.JournalPath);
+    }
+    provisionState(std::move(state));
+}
+
+template <class TConnection>
+void Orchestrator<TConnection>::provisionState(StateSnapshot state)
+{
+    {
+        std::lock_guard<std::mutex> lock(provisionalMutex);
+        for (auto& node : state.Nodes)
+        {
+            std::string hostname = node.Hostname;
+            provisionalNodes[hostname].Node = std::move(node);
+        }
+        for (auto& stream : state.Streams)
+        {
+            std::string hostname = stream.IngestHostname;
+            provisionalNodes[hostname].Streams.push_back(std::move(stream));
+        }
+        for (auto& subscription : state.Subscriptions)
+        {
+            std::string hostname = subscription.EdgeHostname;
+            provisionalNodes[hostname].Subscriptions.push_back(std::move(subscription));
+        }
+        provisionalRoutes.insert(state.Routes.begin(), state.Routes.end());
+    }
+    spdlog::info(
+        "Orchestrator: Restored {} nodes, {} streams, {} subscriptions and {} routes; waiting up "
+        "to {} ms for nodes to reconnect",
+        state.Nodes.size(),
+        state.Streams.size(),
+        state.Subscriptions.size(),
+        state.Routes.size(),
+        options.SnapshotReconcileTimeout.count());
+    timers.Schedule(options.SnapshotReconcileTimeout, [this]() { expireProvisionalState(); });
+}
+
+template <class TConnection>
+void Orchestrator<TConnection>::schedulePeriodicSnapshot()
+{
+    timers.Schedule(
+        options.SnapshotInterval,
+        [this]()
+        {
+            if (isStopping)
+            {
+                return;
+            }
+            WriteSnapshot();
+            schedulePeriodicSnapshot();
+        });
+}
+
+template <class TConnection>
+void Orchestrator<TConnection>::restoreProvisionalState(std::shared_ptr<TConnection> connection)
+{
+    ProvisionalNode provisionalNode;
+    {
+        std::lock_guard<std::mutex> lock(provisionalMutex);
+        auto provisionalIt = provisionalNodes.find(connection->GetHostname());
+        if (provisionalIt == provisionalNodes.end())
+        {
+            return;
+        }
+        provisionalNode = std::move(provisionalIt->second);
+        provisionalNodes.erase(provisionalIt);
+    }
+
+    for (const auto& restoredStream : provisionalNode.Streams)
+    {
+        if (streamStore.GetStreamByChannelId(restoredStream.ChannelId))
+        {
+            // The channel has gone live somewhere else since
+            continue;
+        }
+        Stream<TConnection> stream
+        {
+            .IngestConnection = connection,
+            .ChannelId = restoredStream.ChannelId,
+            .StreamId = restoredStream.StreamId,
+        };
+        streamStore.AddStream(stream);
+        for (const auto& subscription : subscriptions.GetSubscriptions(stream.ChannelId))
+        {
+            restoreRoute(stream, subscription.SubscribedConnection, subscription.StreamKey);
+        }
+    }
+
+    auto existingSubscriptions = subscriptions.GetSubscriptions(connection);
+    for (const auto& restoredSubscription : provisionalNode.Subscriptions)
+    {
+        bool isAlreadySubscribed = std::any_of(
+            existingSubscriptions.begin(),
+            existingSubscriptions.end(),
+            [&restoredSubscription](const ChannelSubscription<TConnection>& subscription)
+            {
+                return (subscription.ChannelId == restoredSubscription.ChannelId);
+            });
+        if (isAlreadySubscribed)
+        {
+            continue;
+        }
+        subscriptions.AddSubscription(
+            connection,
+            restoredSubscription.ChannelId,
+            restoredSubscription.StreamKey);
+        if (auto stream = streamStore.GetStreamByChannelId(restoredSubscription.ChannelId))
+        {
+            restoreRoute(stream.value(), connection, restoredSubscription.StreamKey);
+        }
+    }
+
+    spdlog::info(
+        "Orchestrator: Restored {} streams and {} subscriptions for {}",
+        provisionalNode.Streams.size(),
+        provisionalNode.Subscriptions.size(),
+        connection->GetHostname());
+}
+
+template <class TConnection>
+void Orchestrator<TConnection>::restoreRoute(
+    Stream<TConnection> stream,
+    std::shared_ptr<TConnection> edgeConnection,
+    std::vector<std::byte> streamKey)
 {
-    connectionManager->Listen(std::move(readyListeningPromise)); // This call will block
-
-    // If we've reached this point, we have stopped listening, and should disconnect all 
-    // outstanding connections.
-    if (!isStopping)
+    SnapshotRoute route
     {
-        throw std::runtime_error("Connection manager stopped listening unexpectedly");
+        .ChannelId = stream.ChannelId,
+        .StreamId = stream.StreamId,
+        .IngestHostname = stream.IngestConnection->GetHostname(),
+        .TargetHostname = edgeConnection->GetHostname(),
+    };
+    bool isRunning = false;
+    {
+        std::lock_guard<std::mutex> lock(provisionalMutex);
+        isRunning = (provisionalRoutes.erase(route) > 0);
+    }
+    if (isRunning)
+    {
+        // The ingest never stopped relaying, so leave it be
+        restoredRoutes.Increment();
+        return;
     }
+    openRoute(stream, edgeConnection, streamKey);
+}
 
-    // Take a copy of all active connections - avoid holding a lock while stopping connections,
-    // or we might deadlock if we catch a connection waiting on a lock to try to remove itself!
-    std::set<std::shared_ptr<TConnection>> activeConnections;
+template <class TConnection>
+void Orchestrator<TConnection>::expireProvisionalState()
+{
+    if (isStopping)
     {
-        std::lock_guard<std::mutex> lock(connectionsMutex);
-        activeConnections.insert(pendingConnections.begin(), pendingConnections.end());
-        activeConnections.insert(connections.begin(), connections.end());
+        return;
     }
-    for (const auto& connection : activeConnections)
+
+    std::map<std::string, ProvisionalNode> expiredNodes;
+    std::set<SnapshotRoute> expiredRoutes;
     {
-        connection->Stop();
+        std::lock_guard<std::mutex> lock(provisionalMutex);
+        expiredNodes.swap(provisionalNodes);
+        expiredRoutes.swap(provisionalRoutes);
     }
-    
-    // *Now* we can lock and clear
+
+    for (const auto& [hostname, provisionalNode] : expiredNodes)
     {
-        std::lock_guard<std::mutex> lock(connectionsMutex);
-        pendingConnections.clear();
-        connections.clear();
+        journalEvent(JournalEvent
+            {
+                .Type = JournalEventType::ConnectionClosed,
+                .Hostname = hostname,
+            });
     }
 
-    // Clear all stores
-    streamStore.Clear();
-    subscriptions.Clear();
-}
+    // Ingests that came back are still relaying to edges that didn't
+    size_t stoppedRouteCount = 0;
+    for (const auto& route : expiredRoutes)
+    {
+        journalEvent(JournalEvent
+            {
+                .Type = JournalEventType::RouteClose,
+                .Hostname = route.IngestHostname,
+                .ChannelId = route.ChannelId,
+                .StreamId = route.StreamId,
+                .TargetHostname = route.TargetHostname,
+            });
+        auto stream = streamStore.GetStreamByChannelId(route.ChannelId);
+        if (!stream || (stream->StreamId != route.StreamId) ||
+            (stream->IngestConnection->GetHostname() != route.IngestHostname))
+        {
+            continue;
+        }
+        sendRelay(stream->IngestConnection, ConnectionRelayPayload
+            {
+                .IsStartRelay = false,
+                .ChannelId = route.ChannelId,
+                .StreamId = route.StreamId,
+                .TargetHostname = route.TargetHostname,
+                .StreamKey = std::vector<std::byte>(),
+            });
+        ++stoppedRouteCount;
+    }
 
-template <class TConnection>
-void Orchestrator<TConnection>::Stop()
-{
-    isStopping = true; // Indicate that we're stopping so we don't handle new connections
-                       // or closed events from connections we're getting rid of
-    connectionManager->StopListening();
+    if (!expiredNodes.empty() || (stoppedRouteCount > 0))
+    {
+        spdlog::warn(
+            "Orchestrator: {} nodes didn't reconnect after restoring the snapshot; discarded their "
+            "state and stopped {} routes to them",
+            expiredNodes.size(),
+            stoppedRouteCount);
+    }
 }
 
 template <class TConnection>
-const std::unique_ptr<IConnectionManager<TConnection>>&
-    Orchestrator<TConnection>::GetConnectionManager()
+void Orchestrator<TConnection>::scheduleHeartbeat(std::weak_ptr<TConnection> connection)
 {
-    return connectionManager;
+    timers.Schedule(
+        options.HeartbeatInterval,
+        [this, connection]() { heartbeat(connection); });
 }
 
 template <class TConnection>
-const std::set<std::shared_ptr<TConnection>> Orchestrator<TConnection>::GetConnections()
+void Orchestrator<TConnection>::heartbeat(std::weak_ptr<TConnection> connection)
 {
-    return connections;
-}
+    if (isStopping)
+    {
+        return;
+    }
+    auto strongConnection = connection.lock();
+    if (!strongConnection)
+    {
+        return;
+    }
+    {
+        // Stop heartbeating connections we've already let go of
+        bool isTracked = false;
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            isTracked = (pendingConnections.contains(strongConnection) ||
+                connections.contains(strongConnection));
+        }
+        if (!isTracked)
+        {
+            // Standbys are added here before they leave pendingConnections
+            std::lock_guard<std::mutex> lock(standbysMutex);
+            isTracked = standbys.contains(strongConnection);
+        }
+        if (!isTracked)
+        {
+            return;
+        }
+    }
 
-template <class TConnection>
-std::set<ftl_channel_id_t> Orchestrator<TConnection>::GetSubscribedChannels(
-    std::shared_ptr<TConnection> connection)
-{
-    std::set<ftl_channel_id_t> returnVal;
-    for (const auto& sub : subscriptions.GetSubscriptions(connection))
+    auto silentFor = (std::chrono::steady_clock::now() - strongConnection->GetLastActivityTime());
+    if (silentFor >= (options.HeartbeatInterval * options.HeartbeatMissThreshold))
     {
-        returnVal.insert(sub.ChannelId);
+        // Half-open connections can take the kernel minutes to notice, so don't wait for the
+        // transport to report a close. Stop it first so nothing more arrives while we clean up.
+        spdlog::warn(
+            "Orchestrator: No response from {} in {} ms, closing connection",
+            strongConnection->GetHostname(),
+            std::chrono::duration_cast<std::chrono::milliseconds>(silentFor).count());
+        heartbeatTimeouts.Increment();
+        closeConnection(connection);
+        return;
     }
-    return returnVal;
-}
-#pragma endregion
 
-#pragma region Private methods
-template <class TConnection>
-void Orchestrator<TConnection>::openRoute(
-    Stream<TConnection> stream,
-    std::shared_ptr<TConnection> edgeConnection,
-    std::vector<std::byte> streamKey)
-{
-    // TODO: Handle relays, generate real routes.
-    // for now, we just tell the ingest to start relaying directly to the edge node.
-    stream.IngestConnection->SendStreamRelay(ConnectionRelayPayload
-        {
-            .IsStartRelay = true,
-            .ChannelId = stream.ChannelId,
-            .StreamId = stream.StreamId,
-            .TargetHostname = edgeConnection->GetHostname(),
-            .StreamKey = streamKey,
-        });
+    // Anything received counts, so only connections that have gone quiet need a ping
+    if (silentFor >= options.HeartbeatInterval)
+    {
+        strongConnection->SendPing();
+    }
+    scheduleHeartbeat(connection);
 }
 
 template <class TConnection>
-void Orchestrator<TConnection>::closeRoute(
-    Stream<TConnection> stream,
-    std::shared_ptr<TConnection> edgeConnection)
+void Orchestrator<TConnection>::closeConnection(std::weak_ptr<TConnection> connection)
 {
-    // TODO: Handle relays, generate real routes.
-    // for now, we just tell the ingest to stop relaying directly to the edge node.
-    stream.IngestConnection->SendStreamRelay(ConnectionRelayPayload
-        {
-            .IsStartRelay = false,
-            .ChannelId = stream.ChannelId,
-            .StreamId = stream.StreamId,
-            .TargetHostname = edgeConnection->GetHostname(),
-            .StreamKey = std::vector<std::byte>(),
-        });
+    if (isStopping)
+    {
+        return;
+    }
+    if (auto strongConnection = connection.lock())
+    {
+        // Stop it first so nothing more arrives while we clean up
+        strongConnection->Stop();
+        connectionClosed(connection);
+    }
 }
 
 template <class TConnection>
@@ -187,14 +1200,34 @@ void Orchestrator<TConnection>::newConnection(std::shared_ptr<TConnection> conne
             this,
             weakConnection,
             std::placeholders::_1));
+    connection->SetOnStateReplication(
+        std::bind(
+            &Orchestrator::connectionStateReplication,
+            this,
+            weakConnection,
+            std::placeholders::_1));
+    connection->SetOnWriteStateChanged(
+        std::bind(
+            &Orchestrator::connectionWriteStateChanged,
+            this,
+            weakConnection,
+            std::placeholders::_1));
 
     // Track the connection until we receive the opening intro message
     {
         std::lock_guard<std::mutex> lock(connectionsMutex);
         spdlog::info("Orchestrator: New connection, pending intro...");
         pendingConnections.insert(connection);
+        if (capture)
+        {
+            captureConnectionIds[connection] = capture->AddConnection();
+        }
     }
     connection->Start();
+    if (options.HeartbeatInterval.count() > 0)
+    {
+        scheduleHeartbeat(weakConnection);
+    }
 }
 
 #pragma region Connection callback handlers
@@ -210,8 +1243,36 @@ void Orchestrator<TConnection>::connectionClosed(std::weak_ptr<TConnection> conn
     if (auto strongConnection = connection.lock())
     {
         spdlog::info("Orchestrator: Connection closed to {}", strongConnection->GetHostname());
+        bool isIntroduced = false;
+        {
+            // Stop tracking it first, so it's gone by the time anyone hears about its routes
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            pendingConnections.erase(strongConnection);
+            isIntroduced = (connections.erase(strongConnection) > 0);
+            backedUpConnections.erase(strongConnection);
+            nodeMetadata.erase(strongConnection);
+            auto captureIdIt = captureConnectionIds.find(strongConnection);
+            if (captureIdIt != captureConnectionIds.end())
+            {
+                capture->Record(captureIdIt->second, CapturedClose { });
+                captureConnectionIds.erase(captureIdIt);
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(standbysMutex);
+            if (standbys.erase(strongConnection) > 0)
+            {
+                spdlog::warn("Orchestrator: Lost standby {}", strongConnection->GetHostname());
+                hasStandbys = !standbys.empty();
+            }
+        }
+        {
+            // Nothing waiting to be sent to it matters anymore
+            std::lock_guard<std::mutex> lock(relayBatchesMutex);
+            relayBatches.erase(strongConnection);
+        }
 
-        // First, clear any active routes to this connection
+        // Then clear any active routes to this connection
         for (const auto& sub : subscriptions.GetSubscriptions(strongConnection))
         {
             if (auto stream = streamStore.GetStreamByChannelId(sub.ChannelId))
@@ -222,12 +1283,77 @@ void Orchestrator<TConnection>::connectionClosed(std::weak_ptr<TConnection> conn
 
         // Remove all streams associated with this connection
         streamStore.RemoveAllConnectionStreams(strongConnection);
+        // Lingering routes to it are stopped like any other, and those from it are dropped
+        closeLingeringRoutes(
+            [&strongConnection](const lingering_route_key_t& key, const LingeringRoute& route)
+            {
+                return ((key.first == strongConnection) ||
+                    (route.RoutedStream.IngestConnection == strongConnection));
+            });
         // Remove all subscriptions associated with this connetion
         subscriptions.ClearSubscriptions(strongConnection);
 
+        if (isIntroduced)
+        {
+            std::string hostname = strongConnection->GetHostname();
+            {
+                // Restored routes from it went away with its streams
+                std::lock_guard<std::mutex> lock(provisionalMutex);
+                std::erase_if(provisionalRoutes,
+                    [&hostname](const SnapshotRoute& route)
+                    {
+                        return (route.IngestHostname == hostname);
+                    });
+            }
+            journalEvent(JournalEvent
+                {
+                    .Type = JournalEventType::ConnectionClosed,
+                    .Hostname = hostname,
+                });
+        }
+    }
+}
+
+template <class TConnection>
+void Orchestrator<TConnection>::connectionWriteStateChanged(
+    std::weak_ptr<TConnection> connection,
+    ConnectionWriteState writeState)
+{
+    auto strongConnection = connection.lock();
+    if (!strongConnection || isStopping)
+    {
+        return;
+    }
+
+    // This is called with the connection's send path locked, so anything that sends on it has to
+    // happen elsewhere
+    switch (writeState)
+    {
+    case ConnectionWriteState::BackedUp:
+    {
+        spdlog::warn(
+            "Orchestrator: {} isn't keeping up, holding back messages",
+            strongConnection->GetHostname());
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        backedUpConnections.insert(strongConnection);
+        break;
+    }
+    case ConnectionWriteState::Flowing:
+    {
+        spdlog::info("Orchestrator: {} has caught up", strongConnection->GetHostname());
         std::lock_guard<std::mutex> lock(connectionsMutex);
-        pendingConnections.erase(strongConnection);
-        connections.erase(strongConnection);
+        backedUpConnections.erase(strongConnection);
+        break;
+    }
+    case ConnectionWriteState::Overflowed:
+        spdlog::error(
+            "Orchestrator: {} fell too far behind, closing connection",
+            strongConnection->GetHostname());
+        slowConsumerDisconnects.Increment();
+        timers.Schedule(
+            std::chrono::milliseconds(0),
+            [this, connection]() { closeConnection(connection); });
+        break;
     }
 }
 
@@ -238,6 +1364,8 @@ ConnectionResult Orchestrator<TConnection>::connectionIntro(
 {
     if (auto strongConnection = connection.lock())
     {
+        captureMessage(strongConnection, payload);
+
         // Set the hostname
         strongConnection->SetHostname(payload.Hostname);
         spdlog::info(
@@ -251,9 +1379,37 @@ ConnectionResult Orchestrator<TConnection>::connectionIntro(
             payload.RegionCode);
 
         // Move this connection from pending to active
-        std::lock_guard<std::mutex> lock(connectionsMutex);
-        pendingConnections.erase(strongConnection);
-        connections.insert(strongConnection);
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            pendingConnections.erase(strongConnection);
+            connections.insert(strongConnection);
+            nodeMetadata[strongConnection] = SnapshotNode
+            {
+                .Hostname = payload.Hostname,
+                .VersionMajor = payload.VersionMajor,
+                .VersionMinor = payload.VersionMinor,
+                .VersionRevision = payload.VersionRevision,
+                .RelayLayer = payload.RelayLayer,
+                .RegionCode = payload.RegionCode,
+            };
+        }
+        journalEvent(JournalEvent
+            {
+                .Type = JournalEventType::Intro,
+                .Hostname = payload.Hostname,
+                .Node = SnapshotNode
+                {
+                    .Hostname = payload.Hostname,
+                    .VersionMajor = payload.VersionMajor,
+                    .VersionMinor = payload.VersionMinor,
+                    .VersionRevision = payload.VersionRevision,
+                    .RelayLayer = payload.RelayLayer,
+                    .RegionCode = payload.RegionCode,
+                },
+            });
+
+        // Pick up whatever this node had going before we restarted
+        restoreProvisionalState(strongConnection);
         return ConnectionResult
         {
             .IsSuccess = true
@@ -269,6 +1425,8 @@ ConnectionResult Orchestrator<TConnection>::connectionOutro(
 {
     if (auto strongConnection = connection.lock())
     {
+        captureMessage(strongConnection, payload);
+
         spdlog::info(
             "Orchestrator: Outro from {}: '{}'",
             strongConnection->GetHostname(),
@@ -288,11 +1446,26 @@ ConnectionResult Orchestrator<TConnection>::connectionNodeState(
 {
     if (auto strongConnection = connection.lock())
     {
-        spdlog::info(
-            "Orchestrator: Node State from {}: Load: {} / {}",
-            strongConnection->GetHostname(),
-            payload.CurrentLoad,
-            payload.MaximumLoad);
+        captureMessage(strongConnection, payload);
+
+        // Node state arrives constantly from every node, so keep it out of the default log level
+        if (spdlog::should_log(spdlog::level::debug))
+        {
+            spdlog::debug(
+                "Orchestrator: Node State from {}: Load: {} / {}",
+                strongConnection->GetHostname(),
+                payload.CurrentLoad,
+                payload.MaximumLoad);
+        }
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            auto nodeIt = nodeMetadata.find(strongConnection);
+            if (nodeIt != nodeMetadata.end())
+            {
+                nodeIt->second.CurrentLoad = payload.CurrentLoad;
+                nodeIt->second.MaximumLoad = payload.MaximumLoad;
+            }
+        }
         return ConnectionResult
         {
             .IsSuccess = true
@@ -308,6 +1481,8 @@ ConnectionResult Orchestrator<TConnection>::connectionChannelSubscription(
 {
     if (auto strongConnection = connection.lock())
     {
+        captureMessage(strongConnection, payload);
+
         if (payload.IsSubscribe)
         {
             spdlog::info(
@@ -315,6 +1490,18 @@ ConnectionResult Orchestrator<TConnection>::connectionChannelSubscription(
                 strongConnection->GetHostname(),
                 payload.ChannelId);
 
+            // Nodes re-announce subscriptions we may have restored from a snapshot
+            for (const auto& sub : subscriptions.GetSubscriptions(strongConnection))
+            {
+                if ((sub.ChannelId == payload.ChannelId) && (sub.StreamKey == payload.StreamKey))
+                {
+                    return ConnectionResult
+                    {
+                        .IsSuccess = true
+                    };
+                }
+            }
+
             // Add the subscription
             bool addResult = subscriptions.AddSubscription(
                 strongConnection,
@@ -327,12 +1514,22 @@ ConnectionResult Orchestrator<TConnection>::connectionChannelSubscription(
                     .IsSuccess = false
                 };
             }
+            journalEvent(JournalEvent
+                {
+                    .Type = JournalEventType::Subscribe,
+                    .Hostname = strongConnection->GetHostname(),
+                    .ChannelId = payload.ChannelId,
+                    .StreamKey = payload.StreamKey,
+                });
 
             // Check if this stream is already active
             if (auto stream = streamStore.GetStreamByChannelId(payload.ChannelId))
             {
-                // Establish a route to this edge node
-                openRoute(stream.value(), strongConnection, payload.StreamKey);
+                // Establish a route to this edge node, unless one is still lingering
+                if (!reuseLingeringRoute(stream.value(), strongConnection, payload.StreamKey))
+                {
+                    openRoute(stream.value(), strongConnection, payload.StreamKey);
+                }
             }
 
             return ConnectionResult
@@ -350,13 +1547,38 @@ ConnectionResult Orchestrator<TConnection>::connectionChannelSubscription(
             // Check if this stream is currently active
             if (auto stream = streamStore.GetStreamByChannelId(payload.ChannelId))
             {
-                // Close any existing route
-                closeRoute(stream.value(), strongConnection);
+                if (routeLingerFor(payload.ChannelId).count() > 0)
+                {
+                    // Keep the route open for a while in case the edge comes back for it
+                    std::vector<std::byte> streamKey;
+                    for (const auto& sub : subscriptions.GetSubscriptions(strongConnection))
+                    {
+                        if (sub.ChannelId == payload.ChannelId)
+                        {
+                            streamKey = sub.StreamKey;
+                        }
+                    }
+                    lingerRoute(stream.value(), strongConnection, streamKey);
+                }
+                else
+                {
+                    // Close any existing route
+                    closeRoute(stream.value(), strongConnection);
+                }
             }
 
             // Remove the subscription
             bool removeResult = 
                 subscriptions.RemoveSubscription(strongConnection, payload.ChannelId);
+            if (removeResult)
+            {
+                journalEvent(JournalEvent
+                    {
+                        .Type = JournalEventType::Unsubscribe,
+                        .Hostname = strongConnection->GetHostname(),
+                        .ChannelId = payload.ChannelId,
+                    });
+            }
 
             return ConnectionResult
             {
@@ -374,6 +1596,8 @@ ConnectionResult Orchestrator<TConnection>::connectionStreamPublish(
 {
     if (auto strongConnection = connection.lock())
     {
+        captureMessage(strongConnection, payload);
+
         if (payload.IsPublish)
         {
             spdlog::info(
@@ -382,6 +1606,17 @@ ConnectionResult Orchestrator<TConnection>::connectionStreamPublish(
                 payload.ChannelId,
                 payload.StreamId);
 
+            // Ingests re-announce streams we may have restored from a snapshot
+            auto existingStream = streamStore.GetStreamByChannelId(payload.ChannelId);
+            if (existingStream && (existingStream->IngestConnection == strongConnection) &&
+                (existingStream->StreamId == payload.StreamId))
+            {
+                return ConnectionResult
+                {
+                    .IsSuccess = true
+                };
+            }
+
             // Add it to the stream store
             // TODO: Handle existing streams
             Stream newStream
@@ -391,6 +1626,13 @@ ConnectionResult Orchestrator<TConnection>::connectionStreamPublish(
                 .StreamId = payload.StreamId,
             };
             streamStore.AddStream(newStream);
+            journalEvent(JournalEvent
+                {
+                    .Type = JournalEventType::Publish,
+                    .Hostname = strongConnection->GetHostname(),
+                    .ChannelId = payload.ChannelId,
+                    .StreamId = payload.StreamId,
+                });
 
             // Start opening relays to any subscribed connections
             std::vector<ChannelSubscription<TConnection>> channelSubs = 
@@ -399,6 +1641,7 @@ ConnectionResult Orchestrator<TConnection>::connectionStreamPublish(
             {
                 openRoute(newStream, subscription.SubscribedConnection, subscription.StreamKey);
             }
+            relayFanOut.Record(channelSubs.size());
 
             return ConnectionResult
             {
@@ -413,9 +1656,28 @@ ConnectionResult Orchestrator<TConnection>::connectionStreamPublish(
                 payload.ChannelId,
                 payload.StreamId);
 
+            // Lingering routes are stopped along with everything else; do it while the stream is
+            // still live so they can tell it's theirs
+            closeLingeringRoutes(
+                [&payload](const lingering_route_key_t&, const LingeringRoute& route)
+                {
+                    return ((route.RoutedStream.ChannelId == payload.ChannelId) &&
+                        (route.RoutedStream.StreamId == payload.StreamId));
+                });
+
             // Attempt to remove it if it exists
             if (auto removedStream = streamStore.RemoveStream(payload.ChannelId, payload.StreamId))
             {
+                journalEvent(JournalEvent
+                    {
+                        .Type = JournalEventType::Unpublish,
+                        .Hostname = removedStream->IngestConnection->GetHostname(),
+                        .ChannelId = payload.ChannelId,
+                        .StreamId = payload.StreamId,
+                    });
+                // Tell the ingest to stop relaying to everyone that was receiving this stream.
+                // Subscriptions stay in place so the next publish on this channel is routed.
+                closeAllRoutes(removedStream.value());
                 return ConnectionResult
                 {
                     .IsSuccess = true
@@ -444,10 +1706,98 @@ ConnectionResult Orchestrator<TConnection>::connectionStreamRelay(
 {
     if (auto strongConnection = connection.lock())
     {
+        captureMessage(strongConnection, payload);
+
         // TODO
     }
     throw std::runtime_error("Lost reference to active connection!");
 }
+
+template <class TConnection>
+ConnectionResult Orchestrator<TConnection>::connectionStateReplication(
+    std::weak_ptr<TConnection> connection,
+    ConnectionReplicationPayload payload)
+{
+    if (auto strongConnection = connection.lock())
+    {
+        if (!payload.IsSubscribe)
+        {
+            spdlog::warn(
+                "Orchestrator: {} sent us replicated state, but we aren't a standby",
+                strongConnection->GetHostname());
+            return ConnectionResult
+            {
+                .IsSuccess = false
+            };
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(standbysMutex);
+            if (standbys.contains(strongConnection))
+            {
+                return ConnectionResult
+                {
+                    .IsSuccess = true
+                };
+            }
+            standbys.emplace(strongConnection, StandbyTarget());
+            hasStandbys = true;
+        }
+        bool isIntroduced = false;
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            isIntroduced = connections.contains(strongConnection);
+            if (!isIntroduced)
+            {
+                pendingConnections.erase(strongConnection);
+            }
+        }
+        if (isIntroduced)
+        {
+            spdlog::warn(
+                "Orchestrator: Node {} asked to become a standby, ignoring",
+                strongConnection->GetHostname());
+            std::lock_guard<std::mutex> lock(standbysMutex);
+            standbys.erase(strongConnection);
+            hasStandbys = !standbys.empty();
+            return ConnectionResult
+            {
+                .IsSuccess = false
+            };
+        }
+
+        // Changes made from here on wait in the backlog, so they land after the copy of our
+        // state that they might already be part of. Replaying them again is harmless.
+        StateSnapshot state = takeSnapshot();
+        sendReplication(strongConnection, JournalEvent::FromSnapshot(state));
+        size_t backlogLength = 0;
+        {
+            std::lock_guard<std::mutex> lock(standbysMutex);
+            auto targetIt = standbys.find(strongConnection);
+            if (targetIt != standbys.end())
+            {
+                backlogLength = targetIt->second.Backlog.size();
+                sendReplication(strongConnection, targetIt->second.Backlog);
+                targetIt->second.Backlog.clear();
+                targetIt->second.IsSynced = true;
+            }
+        }
+        spdlog::info(
+            "Orchestrator: Sent standby {} our {} nodes, {} streams, {} subscriptions and {} "
+            "routes, plus {} changes made meanwhile",
+            strongConnection->GetHostname(),
+            state.Nodes.size(),
+            state.Streams.size(),
+            state.Subscriptions.size(),
+            state.Routes.size(),
+            backlogLength);
+        return ConnectionResult
+        {
+            .IsSuccess = true
+        };
+    }
+    throw std::runtime_error("Lost reference to active connection!");
+}
 #pragma endregion /Connection callback handlers
 #pragma endregion /Private methods
 
@@ -455,8 +1805,10 @@ ConnectionResult Orchestrator<TConnection>::connectionStreamRelay(
 // Yeah, this is weird, but necessary.
 // See https://stackoverflow.com/questions/495021/why-can-templates-only-be-implemented-in-the-header-file
 
+#include "InProcessConnection.h"
 #include "test/mocks/MockConnection.h"
 
 template class Orchestrator<FtlConnection>;
+template class Orchestrator<InProcessConnection>;
 template class Orchestrator<MockConnection>;
 #pragma endregion
\ No newline at end of file
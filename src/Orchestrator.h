@@ -9,21 +9,64 @@
 
 #include "FtlTypes.h"
 
+#include "EventJournal.h"
 #include "IConnection.h"
 #include "IConnectionManager.h"
+#include "Metrics.h"
+#include "StateSnapshot.h"
+#include "Stream.h"
 #include "StreamStore.h"
 #include "SubscriptionStore.h"
+#include "TimerWheel.h"
+#include "TrafficCapture.h"
 
 #include <arpa/inet.h>
+#include <chrono>
+#include <functional>
 #include <future>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <set>
+#include <string>
+#include <vector>
 
 // Forward declarations
 class Configuration;
 
+/**
+ * @brief Tuning for how Orchestrator looks after its connections
+ */
+struct OrchestratorOptions
+{
+    // How often quiet connections are pinged; zero disables heartbeats
+    std::chrono::milliseconds HeartbeatInterval = std::chrono::milliseconds(0);
+    // Intervals a connection may go without sending anything before it's considered dead
+    uint32_t HeartbeatMissThreshold = 3;
+    // How long relay commands for an ingest are held so flapping subscriptions can cancel out;
+    // zero sends them immediately
+    std::chrono::milliseconds RelayBatchWindow = std::chrono::milliseconds(0);
+    // How long a route stays open after its edge unsubscribes, so a quick resubscribe can reuse
+    // it; zero closes routes immediately
+    std::chrono::milliseconds RouteLinger = std::chrono::milliseconds(0);
+    // Per-channel overrides for RouteLinger
+    std::map<ftl_channel_id_t, std::chrono::milliseconds> ChannelRouteLinger;
+    // File state is persisted to and restored from; empty disables snapshots
+    std::string SnapshotPath;
+    // How often a snapshot is written while running; zero only writes one on Stop()
+    std::chrono::milliseconds SnapshotInterval = std::chrono::milliseconds(0);
+    // How long restored state waits for its nodes to reconnect before it's discarded
+    std::chrono::milliseconds SnapshotReconcileTimeout = std::chrono::seconds(30);
+    // Journal segments are written to <JournalPath>.<sequence>; empty disables the journal
+    std::string JournalPath;
+    JournalFsyncPolicy JournalFsync = JournalFsyncPolicy::EveryCommit;
+    // How often the journal is synced under JournalFsyncPolicy::Interval
+    std::chrono::milliseconds JournalFsyncInterval = std::chrono::milliseconds(1000);
+    // File every received message is recorded to for offline replay; empty disables capture
+    std::string CapturePath;
+};
+
 /**
  * @brief
  *  Orchestrator handles listening for and maintaining incoming
@@ -34,7 +77,9 @@ class Orchestrator
 {
 public:
     /* Constructor/Destructor */
-    Orchestrator(std::unique_ptr<IConnectionManager<TConnection>> connectionManager);
+    Orchestrator(
+        std::unique_ptr<IConnectionManager<TConnection>> connectionManager,
+        OrchestratorOptions options = OrchestratorOptions());
 
     /* Public methods */
     /**
@@ -55,6 +100,20 @@ public:
      */
     void Stop();
 
+    /**
+     * @brief Writes the current state to the snapshot file, if one is configured
+     * @return bool true if a snapshot was written
+     */
+    bool WriteSnapshot();
+
+    /**
+     * @brief
+     *  Takes on state from elsewhere, such as what a standby replicated from its primary, in
+     *  place of anything restored from our own snapshot. It's kept for the nodes that reconnect
+     *  within the reconcile timeout, just like a restored snapshot.
+     */
+    void RestoreState(StateSnapshot state);
+
     /**
      * @brief Retrieves the ConnectionManager owned by this Orchestrator
      */
@@ -75,15 +134,108 @@ public:
     std::set<ftl_channel_id_t> GetSubscribedChannels(std::shared_ptr<TConnection> connection);
 
 private:
+    /* Private types */
+    /**
+     * @brief Identifies the route a relay command starts or stops on an ingest
+     */
+    struct RelayRouteKey
+    {
+        ftl_channel_id_t ChannelId;
+        ftl_stream_id_t StreamId;
+        std::string TargetHostname;
+
+        auto operator<=>(const RelayRouteKey&) const = default;
+    };
+
+    /**
+     * @brief A route kept open after its edge unsubscribed, until it's reused or expires
+     */
+    struct LingeringRoute
+    {
+        Stream<TConnection> RoutedStream;
+        std::vector<std::byte> StreamKey;
+        // Distinguishes this linger from earlier ones for the same edge and channel
+        uint64_t LingerId;
+        TimerWheel::timer_id_t TimerId;
+    };
+    typedef std::pair<std::shared_ptr<TConnection>, ftl_channel_id_t> lingering_route_key_t;
+
+    /**
+     * @brief State restored from a snapshot for a node that hasn't reconnected yet
+     */
+    struct ProvisionalNode
+    {
+        std::optional<SnapshotNode> Node;
+        std::vector<SnapshotStream> Streams;
+        std::vector<SnapshotSubscription> Subscriptions;
+    };
+
+    /**
+     * @brief A standby orchestrator we're streaming our state changes to
+     */
+    struct StandbyTarget
+    {
+        // Unset while it's being sent a copy of our state; changes made meanwhile wait in Backlog
+        bool IsSynced = false;
+        std::vector<JournalEvent> Backlog;
+    };
+
+    /* Private static members */
+    // Replicated events are sent in messages of about this many bytes, well under the protocol's
+    // 64KB payload limit
+    static constexpr size_t REPLICATION_MESSAGE_LENGTH = (32 * 1024);
+
     /* Private members */
     const std::unique_ptr<IConnectionManager<TConnection>> connectionManager;
+    const OrchestratorOptions options;
     StreamStore<TConnection> streamStore;
     std::mutex connectionsMutex;
     std::set<std::shared_ptr<TConnection>> pendingConnections;
     std::set<std::shared_ptr<TConnection>> connections;
+    // Connections whose peers aren't reading as fast as we're sending them messages
+    std::set<std::shared_ptr<TConnection>> backedUpConnections;
+    // What each introduced node has told us about itself
+    std::map<std::shared_ptr<TConnection>, SnapshotNode> nodeMetadata;
+    // What each connection is called in the traffic capture
+    std::map<std::shared_ptr<TConnection>, uint32_t> captureConnectionIds;
     std::mutex streamsMutex;
     SubscriptionStore<TConnection> subscriptions;
+    std::mutex relayBatchesMutex;
+    // Relay commands waiting out the batching window, by the ingest they're headed to
+    std::map<std::shared_ptr<TConnection>, std::map<RelayRouteKey, ConnectionRelayPayload>>
+        relayBatches;
+    std::mutex lingeringRoutesMutex;
+    // Lingering routes by the edge they lead to and its channel
+    std::map<lingering_route_key_t, LingeringRoute> lingeringRoutes;
+    uint64_t nextLingerId = 0;
+    // Keeps periodic and shutdown snapshots from writing over each other
+    std::mutex snapshotWriteMutex;
+    std::mutex provisionalMutex;
+    // State restored from a snapshot, by the hostname of the node it belongs to
+    std::map<std::string, ProvisionalNode> provisionalNodes;
+    // Routes ingests were running when the snapshot was taken, not yet claimed by a reconnect
+    std::set<SnapshotRoute> provisionalRoutes;
+    // Held while sending to standbys, so every standby sees changes in the same order
+    std::mutex standbysMutex;
+    std::map<std::shared_ptr<TConnection>, StandbyTarget> standbys;
+    // Lets state changes skip the lock when there's nobody to replicate them to
+    std::atomic<bool> hasStandbys { false };
     std::atomic<bool> isStopping { false };
+    MetricHistogram& relayFanOut;
+    MetricCounter& heartbeatTimeouts;
+    MetricCounter& slowConsumerDisconnects;
+    MetricCounter& coalescedRelayCommands;
+    MetricCounter& reusedLingeringRoutes;
+    MetricCounter& snapshotWrites;
+    MetricCounter& snapshotFailures;
+    MetricCounter& restoredRoutes;
+    MetricCounter& replicatedEvents;
+    std::vector<MetricsRegistry::GaugeHandle> metricGauges;
+    // Outlives the timers, whose callbacks journal what they change
+    std::unique_ptr<EventJournal> journal;
+    std::unique_ptr<TrafficCapture> capture;
+    // Declared last so its thread is stopped before anything a timer touches goes away
+    TimerWheel timers;
 
     /* Private methods */
     void openRoute(
@@ -91,10 +243,51 @@ private:
         std::shared_ptr<TConnection> edgeConnection,
         std::vector<std::byte> streamKey);
     void closeRoute(Stream<TConnection> stream, std::shared_ptr<TConnection> edgeConnection);
+    void closeAllRoutes(Stream<TConnection> stream);
+    void sendRelay(std::shared_ptr<TConnection> ingestConnection, ConnectionRelayPayload payload);
+    void flushRelayBatch(std::weak_ptr<TConnection> ingestConnection);
+    std::chrono::milliseconds routeLingerFor(ftl_channel_id_t channelId);
+    void lingerRoute(
+        Stream<TConnection> stream,
+        std::shared_ptr<TConnection> edgeConnection,
+        std::vector<std::byte> streamKey);
+    bool reuseLingeringRoute(
+        Stream<TConnection> stream,
+        std::shared_ptr<TConnection> edgeConnection,
+        const std::vector<std::byte>& streamKey);
+    void expireLingeringRoute(
+        std::weak_ptr<TConnection> edgeConnection,
+        ftl_channel_id_t channelId,
+        uint64_t lingerId);
+    bool isStreamLive(const Stream<TConnection>& stream);
+    void closeLingeringRoutes(
+        std::function<bool(const lingering_route_key_t&, const LingeringRoute&)> predicate);
+    void journalEvent(JournalEvent event);
+    void replicateEvent(const JournalEvent& event);
+    void sendReplication(
+        const std::shared_ptr<TConnection>& standby,
+        const std::vector<JournalEvent>& events);
+    void captureMessage(const std::shared_ptr<TConnection>& connection, captured_message_t message);
+    StateSnapshot takeSnapshot();
+    void loadState();
+    void provisionState(StateSnapshot state);
+    void schedulePeriodicSnapshot();
+    void restoreProvisionalState(std::shared_ptr<TConnection> connection);
+    void restoreRoute(
+        Stream<TConnection> stream,
+        std::shared_ptr<TConnection> edgeConnection,
+        std::vector<std::byte> streamKey);
+    void expireProvisionalState();
+    void scheduleHeartbeat(std::weak_ptr<TConnection> connection);
+    void heartbeat(std::weak_ptr<TConnection> connection);
+    void closeConnection(std::weak_ptr<TConnection> connection);
     /* ConnectionManager callback handlers */
     void newConnection(std::shared_ptr<TConnection> connection);
     /* Connection callback handlers */
     void connectionClosed(std::weak_ptr<TConnection> connection);
+    void connectionWriteStateChanged(
+        std::weak_ptr<TConnection> connection,
+        ConnectionWriteState writeState);
     ConnectionResult connectionIntro(
         std::weak_ptr<TConnection> connection,
         ConnectionIntroPayload payload);
@@ -113,5 +306,8 @@ private:
     ConnectionResult connectionStreamRelay(
         std::weak_ptr<TConnection> connection,
         ConnectionRelayPayload payload);
+    ConnectionResult connectionStateReplication(
+        std::weak_ptr<TConnection> connection,
+        ConnectionReplicationPayload payload);
     
 };
\ No newline at end of file
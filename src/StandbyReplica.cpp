@@ -0,0 +1,306 @@
+/**
+ * @file StandbyReplica.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include "StandbyReplica.h"
+
+#include "BinaryEncoding.h"
+
+#include <spdlog/spdlog.h>
+#include <vector>
+
+#pragma region Constructor/Destructor
+template <class TConnection>
+StandbyReplica<TConnection>::StandbyReplica(
+    std::function<std::shared_ptr<TConnection>()> connectToPrimary,
+    StandbyReplicaOptions options) :
+    connectToPrimary(connectToPrimary),
+    options(options),
+    replicatedEvents(MetricsRegistry::Default().GetCounter(
+        "ftl_orchestrator_standby_replicated_events_total",
+        "State changes received from the primary while on standby"))
+{ }
+#pragma endregion Constructor/Destructor
+
+#pragma region Public methods
+template <class TConnection>
+StateSnapshot StandbyReplica<TConnection>::WaitForFailover()
+{
+    std::shared_ptr<TConnection> primary;
+    while (!primary)
+    {
+        try
+        {
+            primary = connectToPrimary();
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::warn(
+                "StandbyReplica: Could not reach the primary, retrying in {} ms: {}",
+                options.ReconnectInterval.count(),
+                e.what());
+            std::unique_lock<std::mutex> lock(mutex);
+            conditionVariable.wait_for(
+                lock,
+                options.ReconnectInterval,
+                [this]() { return isStopping; });
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (isStopping)
+        {
+            break;
+        }
+    }
+    if (!primary)
+    {
+        return takeSnapshot();
+    }
+
+    primary->SetOnConnectionClosed(std::bind(&StandbyReplica::primaryClosed, this));
+    primary->SetOnStateReplication(
+        std::bind(&StandbyReplica::primaryStateReplication, this, std::placeholders::_1));
+    primary->Start();
+    primary->SendStateReplication(ConnectionReplicationPayload
+        {
+            .IsSubscribe = true,
+            .Events = std::vector<std::byte>(),
+        });
+    spdlog::info("StandbyReplica: Connected to the primary, replicating its state...");
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!isPrimaryLost && !isStopping)
+    {
+        conditionVariable.wait_for(lock, options.HeartbeatInterval);
+        if (isPrimaryLost || isStopping)
+        {
+            break;
+        }
+
+        auto silentFor = (std::chrono::steady_clock::now() - primary->GetLastActivityTime());
+        if (silentFor >= (options.HeartbeatInterval * options.HeartbeatMissThreshold))
+        {
+            spdlog::warn(
+                "StandbyReplica: No response from the primary in {} ms",
+                std::chrono::duration_cast<std::chrono::milliseconds>(silentFor).count());
+            isPrimaryLost = true;
+            break;
+        }
+        if (silentFor >= options.HeartbeatInterval)
+        {
+            lock.unlock();
+            primary->SendPing();
+            lock.lock();
+        }
+    }
+    bool isFailover = isPrimaryLost;
+    lock.unlock();
+
+    // Stop it first so nothing more is applied while we take the final copy
+    primary->Stop();
+    StateSnapshot state = takeSnapshot();
+    if (isFailover)
+    {
+        spdlog::warn(
+            "StandbyReplica: Lost the primary, taking over with {} nodes, {} streams, "
+            "{} subscriptions and {} routes",
+            state.Nodes.size(),
+            state.Streams.size(),
+            state.Subscriptions.size(),
+            state.Routes.size());
+    }
+    return state;
+}
+
+template <class TConnection>
+void StandbyReplica<TConnection>::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isStopping = true;
+    }
+    conditionVariable.notify_all();
+}
+
+template <class TConnection>
+StateSnapshot StandbyReplica<TConnection>::GetState()
+{
+    return takeSnapshot();
+}
+#pragma endregion Public methods
+
+#pragma region Private methods
+template <class TConnection>
+void StandbyReplica<TConnection>::apply(const JournalEvent& event)
+{
+    switch (event.Type)
+    {
+    case JournalEventType::Intro:
+    {
+        SnapshotNode& node = (nodes[event.Hostname] = event.Node);
+        node.Hostname = event.Hostname;
+        break;
+    }
+    case JournalEventType::ConnectionClosed:
+    {
+        nodes.erase(event.Hostname);
+        std::erase_if(streams,
+            [&event](const auto& entry)
+            {
+                return (entry.second.IngestHostname == event.Hostname);
+            });
+        subscriptions.erase(
+            subscriptions.lower_bound({ event.Hostname, 0 }),
+            subscriptions.upper_bound({ event.Hostname, UINT32_MAX }));
+        std::erase_if(routes,
+            [&event](const SnapshotRoute& route)
+            {
+                return (route.IngestHostname == event.Hostname);
+            });
+        break;
+    }
+    case JournalEventType::Publish:
+    {
+        streams[event.ChannelId] = SnapshotStream
+        {
+            .IngestHostname = event.Hostname,
+            .ChannelId = event.ChannelId,
+            .StreamId = event.StreamId,
+        };
+        break;
+    }
+    case JournalEventType::Unpublish:
+    {
+        auto streamIt = streams.find(event.ChannelId);
+        if ((streamIt != streams.end()) &&
+            (streamIt->second.IngestHostname == event.Hostname) &&
+            (streamIt->second.StreamId == event.StreamId))
+        {
+            streams.erase(streamIt);
+        }
+        break;
+    }
+    case JournalEventType::Subscribe:
+    {
+        subscriptions[{ event.Hostname, event.ChannelId }] = SnapshotSubscription
+        {
+            .EdgeHostname = event.Hostname,
+            .ChannelId = event.ChannelId,
+            .StreamKey = event.StreamKey,
+        };
+        break;
+    }
+    case JournalEventType::Unsubscribe:
+    {
+        subscriptions.erase({ event.Hostname, event.ChannelId });
+        break;
+    }
+    case JournalEventType::RouteOpen:
+    case JournalEventType::RouteClose:
+    {
+        SnapshotRoute route
+        {
+            .ChannelId = event.ChannelId,
+            .StreamId = event.StreamId,
+            .IngestHostname = event.Hostname,
+            .TargetHostname = event.TargetHostname,
+        };
+        if (event.Type == JournalEventType::RouteOpen)
+        {
+            routes.insert(std::move(route));
+        }
+        else
+        {
+            routes.erase(route);
+        }
+        break;
+    }
+    default:
+        spdlog::warn(
+            "StandbyReplica: Skipping replicated event of unknown type {}",
+            static_cast<uint8_t>(event.Type));
+        break;
+    }
+}
+
+template <class TConnection>
+StateSnapshot StandbyReplica<TConnection>::takeSnapshot()
+{
+    StateSnapshot snapshot;
+    snapshot.WrittenAt = std::chrono::system_clock::now();
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& [hostname, node] : nodes)
+    {
+        snapshot.Nodes.push_back(node);
+    }
+    for (const auto& [channelId, stream] : streams)
+    {
+        snapshot.Streams.push_back(stream);
+    }
+    for (const auto& [key, subscription] : subscriptions)
+    {
+        snapshot.Subscriptions.push_back(subscription);
+    }
+    snapshot.Routes.assign(routes.begin(), routes.end());
+    return snapshot;
+}
+
+#pragma region Connection callback handlers
+template <class TConnection>
+ConnectionResult StandbyReplica<TConnection>::primaryStateReplication(
+    ConnectionReplicationPayload payload)
+{
+    // Decode everything before applying any of it, so a bad message changes nothing
+    std::vector<JournalEvent> events;
+    try
+    {
+        BinaryReader reader(payload.Events.data(), payload.Events.size());
+        while (!reader.IsAtEnd())
+        {
+            events.push_back(JournalEvent::ReadFrom(reader));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("StandbyReplica: Ignoring malformed state from the primary: {}", e.what());
+        return ConnectionResult
+        {
+            .IsSuccess = false
+        };
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& event : events)
+        {
+            apply(event);
+        }
+    }
+    replicatedEvents.Increment(events.size());
+    return ConnectionResult
+    {
+        .IsSuccess = true
+    };
+}
+
+template <class TConnection>
+void StandbyReplica<TConnection>::primaryClosed()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isPrimaryLost = true;
+    }
+    conditionVariable.notify_all();
+}
+#pragma endregion Connection callback handlers
+#pragma endregion Private methods
+
+#pragma region Template instantiations
+#include "FtlConnection.h"
+#include "InProcessConnection.h"
+
+template class StandbyReplica<FtlConnection>;
+template class StandbyReplica<InProcessConnection>;
+#pragma endregion Template instantiations
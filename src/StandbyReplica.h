@@ -0,0 +1,106 @@
+/**
+ * @file StandbyReplica.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#pragma once
+
+#include "EventJournal.h"
+#include "FtlTypes.h"
+#include "IConnection.h"
+#include "Metrics.h"
+#include "StateSnapshot.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+
+/**
+ * @brief Tuning for how StandbyReplica keeps an eye on its primary
+ */
+struct StandbyReplicaOptions
+{
+    // How often a quiet primary is pinged
+    std::chrono::milliseconds HeartbeatInterval = std::chrono::milliseconds(1000);
+    // Intervals the primary may go without sending anything before it's considered dead
+    uint32_t HeartbeatMissThreshold = 3;
+    // How long to wait between attempts to reach a primary we haven't reached yet
+    std::chrono::milliseconds ReconnectInterval = std::chrono::milliseconds(1000);
+};
+
+/**
+ * @brief
+ *  StandbyReplica connects to a primary orchestrator, asks it for its state and keeps a copy of
+ *  it up to date from the changes the primary streams afterwards. Once the primary is lost, the
+ *  copy is handed over so this instance can take over with warm state: nodes reconnecting to it
+ *  keep their routes running, just as after restoring a snapshot.
+ *
+ *  Until the primary has been reached, failing to connect is retried; once it has, losing it
+ *  (the connection closing, or going silent for too many heartbeat intervals) is a failover.
+ */
+template <class TConnection>
+class StandbyReplica
+{
+public:
+    /* Constructor/Destructor */
+    /**
+     * @param connectToPrimary opens a new connection to the primary, throwing if it can't
+     */
+    StandbyReplica(
+        std::function<std::shared_ptr<TConnection>()> connectToPrimary,
+        StandbyReplicaOptions options = StandbyReplicaOptions());
+
+    StandbyReplica(const StandbyReplica&) = delete;
+    StandbyReplica& operator=(const StandbyReplica&) = delete;
+
+    /* Public methods */
+    /**
+     * @brief Replicates the primary's state until the primary is lost or Stop() is called
+     * @return StateSnapshot the primary's state as of when it was lost
+     */
+    StateSnapshot WaitForFailover();
+
+    /**
+     * @brief Stops replicating, unblocking WaitForFailover()
+     */
+    void Stop();
+
+    /**
+     * @brief A copy of the state replicated so far
+     */
+    StateSnapshot GetState();
+
+private:
+    /* Private types */
+    typedef std::pair<std::string, ftl_channel_id_t> subscription_key_t;
+
+    /* Private members */
+    const std::function<std::shared_ptr<TConnection>()> connectToPrimary;
+    const StandbyReplicaOptions options;
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+    bool isPrimaryLost = false;
+    bool isStopping = false;
+    // The replicated state, indexed the way events look it up. JournalEvent::ApplyTo does the
+    // same to a StateSnapshot, but scans it, which is too slow for a primary's whole state.
+    std::map<std::string, SnapshotNode> nodes;
+    std::map<ftl_channel_id_t, SnapshotStream> streams;
+    std::map<subscription_key_t, SnapshotSubscription> subscriptions;
+    std::set<SnapshotRoute> routes;
+    MetricCounter& replicatedEvents;
+
+    /* Private methods */
+    void apply(const JournalEvent& event);
+    StateSnapshot takeSnapshot();
+    /* Connection callback handlers */
+    ConnectionResult primaryStateReplication(ConnectionReplicationPayload payload);
+    void primaryClosed();
+};
@@ -0,0 +1,312 @@
+/**
+ * @file StateSnapshot.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include "StateSnapshot.h"
+
+#include "BinaryEncoding.h"
+#include "Util.h"
+
+#include <array>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#pragma region Helpers
+namespace
+{
+    // "FTLOSNAP"
+    constexpr std::array<std::byte, 8> SNAPSHOT_MAGIC {
+        std::byte('F'), std::byte('T'), std::byte('L'), std::byte('O'),
+        std::byte('S'), std::byte('N'), std::byte('A'), std::byte('P'),
+    };
+    // Magic, schema version, reserved, written at, body length, body checksum
+    constexpr size_t SNAPSHOT_HEADER_LENGTH = (8 + 2 + 2 + 8 + 8 + 8);
+}
+#pragma endregion Helpers
+
+#pragma region Static methods
+std::optional<StateSnapshot> StateSnapshot::ReadFromFile(const std::string& path)
+{
+    int fileHandle = open(path.c_str(), (O_RDONLY | O_CLOEXEC));
+    if (fileHandle < 0)
+    {
+        int error = errno;
+        if (error == ENOENT)
+        {
+            return std::nullopt;
+        }
+        std::stringstream errStr;
+        errStr << "Could not open snapshot " << path << ": " << Util::ErrnoToString(error);
+        throw std::runtime_error(errStr.str());
+    }
+
+    struct stat fileStat;
+    if (fstat(fileHandle, &fileStat) < 0)
+    {
+        int error = errno;
+        close(fileHandle);
+        std::stringstream errStr;
+        errStr << "Could not stat snapshot " << path << ": " << Util::ErrnoToString(error);
+        throw std::runtime_error(errStr.str());
+    }
+    size_t fileLength = static_cast<size_t>(fileStat.st_size);
+    if (fileLength == 0)
+    {
+        close(fileHandle);
+        throw std::runtime_error("Snapshot " + path + " is empty");
+    }
+
+    void* mapped = mmap(nullptr, fileLength, PROT_READ, MAP_PRIVATE, fileHandle, 0);
+    int mapError = errno;
+    // The mapping holds its own reference to the file
+    close(fileHandle);
+    if (mapped == MAP_FAILED)
+    {
+        std::stringstream errStr;
+        errStr << "Could not map snapshot " << path << ": " << Util::ErrnoToString(mapError);
+        throw std::runtime_error(errStr.str());
+    }
+
+    try
+    {
+        StateSnapshot snapshot = Deserialize(static_cast<const std::byte*>(mapped), fileLength);
+        munmap(mapped, fileLength);
+        return snapshot;
+    }
+    catch (...)
+    {
+        munmap(mapped, fileLength);
+        throw;
+    }
+}
+
+StateSnapshot StateSnapshot::Deserialize(const std::byte* bytes, size_t length)
+{
+    if ((length < SNAPSHOT_HEADER_LENGTH) ||
+        (std::memcmp(bytes, SNAPSHOT_MAGIC.data(), SNAPSHOT_MAGIC.size()) != 0))
+    {
+        throw std::runtime_error("Not an orchestrator snapshot");
+    }
+    BinaryReader header(
+        (bytes + SNAPSHOT_MAGIC.size()),
+        (SNAPSHOT_HEADER_LENGTH - SNAPSHOT_MAGIC.size()));
+    uint16_t schemaVersion = header.Read<uint16_t>();
+    header.Read<uint16_t>(); // Reserved
+    int64_t writtenAtMs = static_cast<int64_t>(header.Read<uint64_t>());
+    uint64_t bodyLength = header.Read<uint64_t>();
+    uint64_t bodyChecksum = header.Read<uint64_t>();
+    if ((schemaVersion < 1) || (schemaVersion > SCHEMA_VERSION))
+    {
+        std::stringstream errStr;
+        errStr << "Unsupported snapshot schema version " << schemaVersion << " (expected " <<
+            SCHEMA_VERSION << " or older)";
+        throw std::runtime_error(errStr.str());
+    }
+    const std::byte* body = (bytes + SNAPSHOT_HEADER_LENGTH);
+    if ((bodyLength != (length - SNAPSHOT_HEADER_LENGTH)) ||
+        (BinaryWriter::Checksum(body, bodyLength) != bodyChecksum))
+    {
+        throw std::runtime_error("Snapshot is corrupt");
+    }
+
+    StateSnapshot snapshot;
+    snapshot.WrittenAt = std::chrono::system_clock::time_point(
+        std::chrono::milliseconds(writtenAtMs));
+    BinaryReader reader(body, bodyLength);
+    if (schemaVersion >= 2)
+    {
+        snapshot.JournalSequence = reader.Read<uint64_t>();
+    }
+    uint32_t nodeCount = reader.Read<uint32_t>();
+    for (uint32_t i = 0; i < nodeCount; ++i)
+    {
+        SnapshotNode node;
+        node.Hostname = reader.ReadString();
+        node.VersionMajor = reader.Read<uint8_t>();
+        node.VersionMinor = reader.Read<uint8_t>();
+        node.VersionRevision = reader.Read<uint8_t>();
+        node.RelayLayer = reader.Read<uint8_t>();
+        node.RegionCode = reader.ReadString();
+        node.CurrentLoad = reader.Read<uint32_t>();
+        node.MaximumLoad = reader.Read<uint32_t>();
+        snapshot.Nodes.push_back(std::move(node));
+    }
+    uint32_t streamCount = reader.Read<uint32_t>();
+    for (uint32_t i = 0; i < streamCount; ++i)
+    {
+        std::string ingestHostname = reader.ReadString();
+        ftl_channel_id_t channelId = reader.Read<uint32_t>();
+        ftl_stream_id_t streamId = reader.Read<uint32_t>();
+        snapshot.Streams.push_back(SnapshotStream
+            {
+                .IngestHostname = std::move(ingestHostname),
+                .ChannelId = channelId,
+                .StreamId = streamId,
+            });
+    }
+    uint32_t subscriptionCount = reader.Read<uint32_t>();
+    for (uint32_t i = 0; i < subscriptionCount; ++i)
+    {
+        std::string edgeHostname = reader.ReadString();
+        ftl_channel_id_t channelId = reader.Read<uint32_t>();
+        std::vector<std::byte> streamKey = reader.ReadBytes();
+        snapshot.Subscriptions.push_back(SnapshotSubscription
+            {
+                .EdgeHostname = std::move(edgeHostname),
+                .ChannelId = channelId,
+                .StreamKey = std::move(streamKey),
+            });
+    }
+    uint32_t routeCount = reader.Read<uint32_t>();
+    for (uint32_t i = 0; i < routeCount; ++i)
+    {
+        ftl_channel_id_t channelId = reader.Read<uint32_t>();
+        ftl_stream_id_t streamId = reader.Read<uint32_t>();
+        std::string ingestHostname = reader.ReadString();
+        std::string targetHostname = reader.ReadString();
+        snapshot.Routes.push_back(SnapshotRoute
+            {
+                .ChannelId = channelId,
+                .StreamId = streamId,
+                .IngestHostname = std::move(ingestHostname),
+                .TargetHostname = std::move(targetHostname),
+            });
+    }
+    if (!reader.IsAtEnd())
+    {
+        throw std::runtime_error("Snapshot has trailing data");
+    }
+    return snapshot;
+}
+#pragma endregion Static methods
+
+#pragma region Public methods
+void StateSnapshot::WriteToFile(const std::string& path) const
+{
+    std::vector<std::byte> bytes = Serialize();
+
+    // Write alongside the destination and rename over it, so readers only ever see a whole file
+    std::string tempPath = (path + ".tmp");
+    int fileHandle = open(
+        tempPath.c_str(),
+        (O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC),
+        (S_IRUSR | S_IWUSR | S_IRGRP));
+    if (fileHandle < 0)
+    {
+        int error = errno;
+        std::stringstream errStr;
+        errStr << "Could not create snapshot " << tempPath << ": " << Util::ErrnoToString(error);
+        throw std::runtime_error(errStr.str());
+    }
+    size_t written = 0;
+    while (written < bytes.size())
+    {
+        ssize_t result = write(fileHandle, (bytes.data() + written), (bytes.size() - written));
+        if (result < 0)
+        {
+            int error = errno;
+            if (error == EINTR)
+            {
+                continue;
+            }
+            close(fileHandle);
+            std::stringstream errStr;
+            errStr << "Could not write snapshot " << tempPath << ": " <<
+                Util::ErrnoToString(error);
+            throw std::runtime_error(errStr.str());
+        }
+        written += static_cast<size_t>(result);
+    }
+    if (fsync(fileHandle) < 0)
+    {
+        int error = errno;
+        close(fileHandle);
+        std::stringstream errStr;
+        errStr << "Could not sync snapshot " << tempPath << ": " << Util::ErrnoToString(error);
+        throw std::runtime_error(errStr.str());
+    }
+    close(fileHandle);
+
+    if (rename(tempPath.c_str(), path.c_str()) < 0)
+    {
+        int error = errno;
+        std::stringstream errStr;
+        errStr << "Could not replace snapshot " << path << ": " << Util::ErrnoToString(error);
+        throw std::runtime_error(errStr.str());
+    }
+
+    // Make the rename itself durable
+    std::string directory = std::filesystem::path(path).parent_path().string();
+    int directoryHandle = open(
+        (directory.empty() ? "." : directory.c_str()),
+        (O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (directoryHandle >= 0)
+    {
+        fsync(directoryHandle);
+        close(directoryHandle);
+    }
+}
+
+std::vector<std::byte> StateSnapshot::Serialize() const
+{
+    BinaryWriter body;
+    body.Write(JournalSequence);
+    body.Write(static_cast<uint32_t>(Nodes.size()));
+    for (const auto& node : Nodes)
+    {
+        body.Write(node.Hostname);
+        body.Write(node.VersionMajor);
+        body.Write(node.VersionMinor);
+        body.Write(node.VersionRevision);
+        body.Write(node.RelayLayer);
+        body.Write(node.RegionCode);
+        body.Write(node.CurrentLoad);
+        body.Write(node.MaximumLoad);
+    }
+    body.Write(static_cast<uint32_t>(Streams.size()));
+    for (const auto& stream : Streams)
+    {
+        body.Write(stream.IngestHostname);
+        body.Write(stream.ChannelId);
+        body.Write(stream.StreamId);
+    }
+    body.Write(static_cast<uint32_t>(Subscriptions.size()));
+    for (const auto& subscription : Subscriptions)
+    {
+        body.Write(subscription.EdgeHostname);
+        body.Write(subscription.ChannelId);
+        body.Write(subscription.StreamKey);
+    }
+    body.Write(static_cast<uint32_t>(Routes.size()));
+    for (const auto& route : Routes)
+    {
+        body.Write(route.ChannelId);
+        body.Write(route.StreamId);
+        body.Write(route.IngestHostname);
+        body.Write(route.TargetHostname);
+    }
+    const std::vector<std::byte>& bodyBytes = body.GetBuffer();
+
+    BinaryWriter snapshot;
+    std::vector<std::byte>& bytes = snapshot.GetBuffer();
+    bytes.reserve(SNAPSHOT_HEADER_LENGTH + bodyBytes.size());
+    bytes.insert(bytes.end(), SNAPSHOT_MAGIC.begin(), SNAPSHOT_MAGIC.end());
+    snapshot.Write(SCHEMA_VERSION);
+    snapshot.Write(static_cast<uint16_t>(0)); // Reserved
+    snapshot.Write(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        WrittenAt.time_since_epoch()).count()));
+    snapshot.Write(static_cast<uint64_t>(bodyBytes.size()));
+    snapshot.Write(BinaryWriter::Checksum(bodyBytes.data(), bodyBytes.size()));
+    bytes.insert(bytes.end(), bodyBytes.begin(), bodyBytes.end());
+    return std::move(bytes);
+}
+#pragma endregion Public methods
@@ -0,0 +1,117 @@
+/**
+ * @file StateSnapshot.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#pragma once
+
+#include "FtlTypes.h"
+
+#include <chrono>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief What a node told us about itself, keyed by hostname so it survives reconnects
+ */
+struct SnapshotNode
+{
+    std::string Hostname;
+    uint8_t VersionMajor = 0;
+    uint8_t VersionMinor = 0;
+    uint8_t VersionRevision = 0;
+    uint8_t RelayLayer = 0;
+    std::string RegionCode;
+    uint32_t CurrentLoad = 0;
+    uint32_t MaximumLoad = 0;
+
+    bool operator==(const SnapshotNode&) const = default;
+};
+
+struct SnapshotStream
+{
+    std::string IngestHostname;
+    ftl_channel_id_t ChannelId;
+    ftl_stream_id_t StreamId;
+
+    bool operator==(const SnapshotStream&) const = default;
+};
+
+struct SnapshotSubscription
+{
+    std::string EdgeHostname;
+    ftl_channel_id_t ChannelId;
+    std::vector<std::byte> StreamKey;
+
+    bool operator==(const SnapshotSubscription&) const = default;
+};
+
+/**
+ * @brief A relay an ingest has been told to run
+ */
+struct SnapshotRoute
+{
+    ftl_channel_id_t ChannelId;
+    ftl_stream_id_t StreamId;
+    std::string IngestHostname;
+    std::string TargetHostname;
+
+    auto operator<=>(const SnapshotRoute&) const = default;
+};
+
+/**
+ * @brief
+ *  The orchestrator's view of the cluster at a point in time, persisted so a restarted
+ *  orchestrator can pick up where it left off instead of rebuilding every route.
+ *
+ *  Files start with a fixed header carrying the schema version and a checksum of the body, and
+ *  are replaced atomically, so a crash mid-write leaves the previous snapshot in place. Reading
+ *  maps the file into memory and parses it in place.
+ */
+class StateSnapshot
+{
+public:
+    /* Public members */
+    std::chrono::system_clock::time_point WrittenAt;
+    std::vector<SnapshotNode> Nodes;
+    std::vector<SnapshotStream> Streams;
+    std::vector<SnapshotSubscription> Subscriptions;
+    std::vector<SnapshotRoute> Routes;
+    // Last journal event this snapshot includes; replay picks up after it
+    uint64_t JournalSequence = 0;
+
+    /* Static members */
+    static constexpr uint16_t SCHEMA_VERSION = 2;
+
+    /* Static methods */
+    /**
+     * @brief Reads a snapshot written by WriteToFile
+     * @return std::optional<StateSnapshot> the snapshot, or nullopt if there is no file at path
+     * @throws std::runtime_error if the file can't be read or isn't a snapshot we understand
+     */
+    static std::optional<StateSnapshot> ReadFromFile(const std::string& path);
+
+    /* Public methods */
+    /**
+     * @brief Durably replaces the file at path with this snapshot
+     * @throws std::runtime_error if the snapshot could not be written
+     */
+    void WriteToFile(const std::string& path) const;
+
+    /**
+     * @brief Serializes this snapshot, header included
+     */
+    std::vector<std::byte> Serialize() const;
+
+    /**
+     * @brief Parses a serialized snapshot
+     * @throws std::runtime_error if the bytes aren't a snapshot we understand
+     */
+    static StateSnapshot Deserialize(const std::byte* bytes, size_t length);
+};
@@ -17,6 +17,7 @@
 #include <mutex>
 #include <optional>
 #include <sstream>
+#include <vector>
 
 /**
  * @brief Manages storage and retrieval of Streams
@@ -131,6 +132,30 @@ public:
         return std::nullopt;
     }
 
+    /**
+     * @brief Returns a copy of every stream currently in the store
+     */
+    std::vector<Stream<TConnection>> GetAllStreams()
+    {
+        std::lock_guard<std::mutex> lock(streamStoreMutex);
+        std::vector<Stream<TConnection>> returnVal;
+        returnVal.reserve(streamByChannelId.size());
+        for (const auto& [channelId, stream] : streamByChannelId)
+        {
+            returnVal.push_back(stream);
+        }
+        return returnVal;
+    }
+
+    /**
+     * @brief Returns the number of streams currently in the store
+     */
+    size_t GetStreamCount()
+    {
+        std::lock_guard<std::mutex> lock(streamStoreMutex);
+        return streamByChannelId.size();
+    }
+
     /**
      * @brief Clears all records
      */
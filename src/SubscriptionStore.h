@@ -215,6 +215,37 @@ public:
         }
     }
 
+    /**
+     * @brief Returns a copy of every subscription currently in the store
+     */
+    std::vector<ChannelSubscription<TConnection>> GetAllSubscriptions()
+    {
+        std::lock_guard<std::mutex> lock(subscriptionsStoreMutex);
+        std::vector<ChannelSubscription<TConnection>> returnVal;
+        for (const auto& [channelId, subs] : subscriptionsByChannel)
+        {
+            for (const auto& sub : subs)
+            {
+                returnVal.push_back(*sub);
+            }
+        }
+        return returnVal;
+    }
+
+    /**
+     * @brief Returns the total number of subscriptions across all channels
+     */
+    size_t GetSubscriptionCount()
+    {
+        std::lock_guard<std::mutex> lock(subscriptionsStoreMutex);
+        size_t count = 0;
+        for (const auto& [channelId, subs] : subscriptionsByChannel)
+        {
+            count += subs.size();
+        }
+        return count;
+    }
+
     /**
      * @brief Clears all records
      */
@@ -8,22 +8,39 @@
 #include "TlsConnectionManager.h"
 
 #include "FtlConnection.h"
+#include "IoUringEventLoop.h"
+#include "IoUringTlsConnectionTransport.h"
 #include "TlsConnectionTransport.h"
 #include "Util.h"
 
+#include <algorithm>
+#include <netinet/tcp.h>
 #include <openssl/ssl.h>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 
 #pragma region Constructor/Destructor
 template <class T>
 TlsConnectionManager<T>::TlsConnectionManager(
     std::vector<std::byte> preSharedKey,
-    in_port_t listenPort
+    in_port_t listenPort,
+    TlsConnectionManagerOptions options
 ) :
     preSharedKey(preSharedKey),
-    listenPort(listenPort)
+    listenPort(listenPort),
+    options(options),
+    pendingHandshakes(std::make_shared<PendingHandshakes>())
 { }
+
+template <class T>
+TlsConnectionManager<T>::~TlsConnectionManager()
+{
+    if (eventLoop)
+    {
+        eventLoop->Stop();
+    }
+}
 #pragma endregion
 
 #pragma region IConnectionManager
@@ -34,10 +51,124 @@ void TlsConnectionManager<T>::Init()
     SSL_load_error_strings();
     SSL_library_init();
     OpenSSL_add_all_algorithms();
+
+    transportContext = std::make_shared<TlsTransportContext>(
+        true /*isServer*/,
+        preSharedKey,
+        options.HandshakeTimeout,
+        options.EnableKernelTls);
+
+    if (options.TransportBackend == TlsTransportBackend::IoUring)
+    {
+        if (IoUringEventLoop::IsSupported())
+        {
+            eventLoop = std::make_shared<IoUringEventLoop>();
+            eventLoop->Start();
+            spdlog::info("TlsConnectionManager: Using io_uring transport");
+            if (options.EnableKernelTls)
+            {
+                spdlog::warn("Kernel TLS is not used by the io_uring transport.");
+            }
+        }
+        else
+        {
+            spdlog::warn(
+                "io_uring transport requested, but this kernel doesn't support it. "
+                "Falling back to poll.");
+        }
+    }
+
+    pendingHandshakesGauge = MetricsRegistry::Default().AddGauge(
+        "ftl_orchestrator_tls_pending_handshakes",
+        "Accepted connections that have not yet completed TLS negotiation",
+        [pendingHandshakes = pendingHandshakes]()
+        {
+            std::lock_guard<std::mutex> lock(pendingHandshakes->Mutex);
+            return static_cast<double>(pendingHandshakes->Count);
+        });
 }
 
 template <class T>
 void TlsConnectionManager<T>::Listen(std::promise<void>&& readyPromise)
+{
+    size_t acceptorCount = std::max<size_t>(options.AcceptorThreadCount, 1);
+    std::vector<int> socketHandles;
+    try
+    {
+        for (size_t i = 0; i < acceptorCount; ++i)
+        {
+            socketHandles.push_back(createListenSocket());
+        }
+    }
+    catch (...)
+    {
+        for (const auto& socketHandle : socketHandles)
+        {
+            close(socketHandle);
+        }
+        throw;
+    }
+    {
+        std::lock_guard<std::mutex> lock(listenSocketHandlesMutex);
+        listenSocketHandles = socketHandles;
+    }
+
+    // Accept new connections. The first acceptor runs on this thread.
+    spdlog::info(
+        "TlsConnectionManager: Listening on port {} with {} acceptor(s)...",
+        listenPort,
+        acceptorCount);
+    std::vector<std::future<void>> acceptors;
+    for (size_t i = 1; i < acceptorCount; ++i)
+    {
+        acceptors.push_back(std::async(
+            std::launch::async,
+            &TlsConnectionManager<T>::acceptConnections,
+            this,
+            socketHandles.at(i)));
+    }
+    readyPromise.set_value(); // Indicate to promise that we are now listening
+    try
+    {
+        acceptConnections(socketHandles.at(0));
+    }
+    catch (...)
+    {
+        // Bring the other acceptors down with us rather than wait on them forever
+        StopListening();
+        throw;
+    }
+    for (auto& acceptor : acceptors)
+    {
+        acceptor.get();
+    }
+}
+
+template <class T>
+void TlsConnectionManager<T>::StopListening()
+{
+    std::lock_guard<std::mutex> lock(listenSocketHandlesMutex);
+    for (const auto& listenSocketHandle : listenSocketHandles)
+    {
+        shutdown(listenSocketHandle, SHUT_RDWR);
+        close(listenSocketHandle);
+        spdlog::debug("TlsConnectionManager: Closed listening on fd {}", listenSocketHandle);
+    }
+    listenSocketHandles.clear();
+}
+
+template <class T>
+void TlsConnectionManager<T>::SetOnNewConnection(
+    std::function<void(std::shared_ptr<T>)> onNewConnection)
+{
+    this->onNewConnection = onNewConnection;
+}
+
+#pragma endregion
+
+#pragma region Private methods
+template <class T>
+int TlsConnectionManager<T>::createListenSocket()
 {
     sockaddr_in listenAddr
     {
@@ -47,7 +178,7 @@ void TlsConnectionManager<T>::Listen(std::promise<void>&& readyPromise)
     };
 
     // Create socket
-    listenSocketHandle = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    int listenSocketHandle = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
     if (listenSocketHandle < 0)
     {
         int error = errno;
@@ -61,6 +192,24 @@ void TlsConnectionManager<T>::Listen(std::promise<void>&& readyPromise)
     int reUseOption = 1;
     setsockopt(listenSocketHandle, SOL_SOCKET, SO_REUSEADDR, &reUseOption, sizeof(reUseOption));
 
+    // Let each acceptor bind its own socket to the same port; the kernel spreads incoming
+    // connections across them
+    if ((options.AcceptorThreadCount > 1) &&
+        (setsockopt(
+            listenSocketHandle,
+            SOL_SOCKET,
+            SO_REUSEPORT,
+            &reUseOption,
+            sizeof(reUseOption)) < 0))
+    {
+        int error = errno;
+        close(listenSocketHandle);
+        std::stringstream errStr;
+        errStr << "Unable to set SO_REUSEPORT on listen socket! Error "
+            << error << ": " << Util::ErrnoToString(error);
+        throw std::runtime_error(errStr.str());
+    }
+
     // Bind socket
     if (bind(
         listenSocketHandle,
@@ -68,6 +217,7 @@ void TlsConnectionManager<T>::Listen(std::promise<void>&& readyPromise)
         sizeof(listenAddr)) < 0)
     {
         int error = errno;
+        close(listenSocketHandle);
         std::stringstream errStr;
         errStr << "Unable to bind socket! Error "
             << error << ": " << Util::ErrnoToString(error);
@@ -77,18 +227,22 @@ void TlsConnectionManager<T>::Listen(std::promise<void>&& readyPromise)
     spdlog::debug("TlsConnectionManager: Bound on fd {}", listenSocketHandle);
 
     // Listen on socket
-    if (listen(listenSocketHandle, SOCKET_LISTEN_QUEUE_LIMIT) < 0)
+    if (listen(listenSocketHandle, options.ListenBacklog) < 0)
     {
         int error = errno;
+        close(listenSocketHandle);
         std::stringstream errStr;
         errStr << "Unable to listen on socket! Error "
             << error << ": " << Util::ErrnoToString(error);
         throw std::runtime_error(errStr.str());
     }
 
-    // Accept new connections
-    spdlog::info("TlsConnectionManager: Listening on port {}...", listenPort);
-    readyPromise.set_value(); // Indicate to promise that we are now listening
+    return listenSocketHandle;
+}
+
+template <class T>
+void TlsConnectionManager<T>::acceptConnections(int listenSocketHandle)
+{
     while (true)
     {
         sockaddr_in acceptedAddr { 0 };
@@ -104,23 +258,81 @@ void TlsConnectionManager<T>::Listen(std::promise<void>&& readyPromise)
             if (error == EINVAL)
             {
                 // This means we've closed the listen handle
-                spdlog::info("TlsConnectionManager: Shutting down...");
+                spdlog::info("TlsConnectionManager: Shutting down acceptor on fd {}...",
+                    listenSocketHandle);
                 break;
             }
+            if ((error == EINTR) || (error == ECONNABORTED) || (error == EMFILE) ||
+                (error == ENFILE) || (error == ENOBUFS) || (error == ENOMEM))
+            {
+                // Transient - the client gave up before we got to it, or we're temporarily out
+                // of descriptors/memory. Back off briefly instead of spinning.
+                spdlog::warn("TlsConnectionManager: accept() failed transiently: {}",
+                    Util::ErrnoToString(error));
+                if (error != EINTR && error != ECONNABORTED)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+                continue;
+            }
             std::stringstream errStr;
             errStr << "Unable to accept incoming connection! Error "
                 << error << ": " << Util::ErrnoToString(error);
             throw std::runtime_error(errStr.str());
         }
 
+        // Turn the connection away rather than queue behind a flood of slow handshakes
+        if (!tryAdmitHandshake(acceptedAddr))
+        {
+            close(clientHandle);
+            continue;
+        }
+
         spdlog::info("TlsConnectionManager: Accepted new connection on fd {}", clientHandle);
+        configureAcceptedSocket(clientHandle);
 
-        std::shared_ptr<TlsConnectionTransport> transport = 
-            std::make_shared<TlsConnectionTransport>(
-                true /*isServer*/,
+        // TLS negotiation happens off of this thread; release this connection's pending
+        // handshake slot once it completes either way
+        auto onHandshakeComplete =
+            [pendingHandshakes = pendingHandshakes, address = acceptedAddr.sin_addr.s_addr]
+            (bool isSuccess)
+            {
+                static MetricCounter& handshakeFailures = MetricsRegistry::Default().GetCounter(
+                    "ftl_orchestrator_tls_handshake_failures_total",
+                    "Accepted connections that failed or timed out during TLS negotiation");
+                if (!isSuccess)
+                {
+                    handshakeFailures.Increment();
+                }
+
+                std::lock_guard<std::mutex> lock(pendingHandshakes->Mutex);
+                --pendingHandshakes->Count;
+                if (--pendingHandshakes->CountByAddress[address] == 0)
+                {
+                    pendingHandshakes->CountByAddress.erase(address);
+                }
+            };
+
+        std::shared_ptr<IConnectionTransport> transport;
+        if (eventLoop)
+        {
+            auto ioUringTransport = std::make_shared<IoUringTlsConnectionTransport>(
+                eventLoop,
+                transportContext,
+                clientHandle,
+                acceptedAddr);
+            ioUringTransport->SetOnHandshakeComplete(onHandshakeComplete);
+            transport = ioUringTransport;
+        }
+        else
+        {
+            auto pollTransport = std::make_shared<TlsConnectionTransport>(
+                transportContext,
                 clientHandle,
-                acceptedAddr,
-                preSharedKey);
+                acceptedAddr);
+            pollTransport->SetOnHandshakeComplete(onHandshakeComplete);
+            transport = pollTransport;
+        }
 
         std::shared_ptr<T> connection = std::make_shared<T>(transport);
 
@@ -136,20 +348,74 @@ void TlsConnectionManager<T>::Listen(std::promise<void>&& readyPromise)
 }
 
 template <class T>
-void TlsConnectionManager<T>::StopListening()
+void TlsConnectionManager<T>::configureAcceptedSocket(int socketHandle)
 {
-    shutdown(listenSocketHandle, SHUT_RDWR);
-    close(listenSocketHandle);
-    spdlog::debug("TlsConnectionManager: Closed listening on fd {}", listenSocketHandle);
+    // Let the kernel give up on dead peers sooner than its defaults, which can take minutes.
+    // Failing to is not fatal; heartbeats will still catch them.
+    auto setOption =
+        [socketHandle](int level, int option, int value, const char* optionName)
+        {
+            if (setsockopt(socketHandle, level, option, &value, sizeof(value)) < 0)
+            {
+                spdlog::warn("TlsConnectionManager: Unable to set {} on fd {}: {}",
+                    optionName, socketHandle, Util::ErrnoToString(errno));
+            }
+        };
+    if (options.TcpKeepAliveInterval.count() > 0)
+    {
+        int intervalSeconds = static_cast<int>(options.TcpKeepAliveInterval.count());
+        setOption(SOL_SOCKET, SO_KEEPALIVE, 1, "SO_KEEPALIVE");
+        setOption(IPPROTO_TCP, TCP_KEEPIDLE, intervalSeconds, "TCP_KEEPIDLE");
+        setOption(IPPROTO_TCP, TCP_KEEPINTVL, intervalSeconds, "TCP_KEEPINTVL");
+        setOption(IPPROTO_TCP, TCP_KEEPCNT, options.TcpKeepAliveProbeCount, "TCP_KEEPCNT");
+    }
+    if (options.TcpUserTimeout.count() > 0)
+    {
+        setOption(
+            IPPROTO_TCP,
+            TCP_USER_TIMEOUT,
+            static_cast<int>(options.TcpUserTimeout.count()),
+            "TCP_USER_TIMEOUT");
+    }
 }
 
 template <class T>
-void TlsConnectionManager<T>::SetOnNewConnection(
-    std::function<void(std::shared_ptr<T>)> onNewConnection)
+bool TlsConnectionManager<T>::tryAdmitHandshake(const sockaddr_in& address)
 {
-    this->onNewConnection = onNewConnection;
-}
+    static MetricCounter& rejectedPoolFull = MetricsRegistry::Default().GetCounter(
+        "ftl_orchestrator_tls_handshakes_rejected_total",
+        "Accepted connections closed before TLS negotiation due to handshake limits",
+        "reason=\"pool_full\"");
+    static MetricCounter& rejectedPerAddress = MetricsRegistry::Default().GetCounter(
+        "ftl_orchestrator_tls_handshakes_rejected_total",
+        "Accepted connections closed before TLS negotiation due to handshake limits",
+        "reason=\"per_address_limit\"");
 
+    std::lock_guard<std::mutex> lock(pendingHandshakes->Mutex);
+    if (pendingHandshakes->Count >= options.MaxPendingHandshakes)
+    {
+        rejectedPoolFull.Increment();
+        spdlog::warn(
+            "TlsConnectionManager: Rejecting connection from {}, {} handshakes already pending",
+            Util::AddressToString(address.sin_addr),
+            pendingHandshakes->Count);
+        return false;
+    }
+    size_t& addressCount = pendingHandshakes->CountByAddress[address.sin_addr.s_addr];
+    if (addressCount >= options.MaxPendingHandshakesPerAddress)
+    {
+        rejectedPerAddress.Increment();
+        spdlog::warn(
+            "TlsConnectionManager: Rejecting connection from {}, {} handshakes already pending "
+                "from this address",
+            Util::AddressToString(address.sin_addr),
+            addressCount);
+        return false;
+    }
+    ++addressCount;
+    ++pendingHandshakes->Count;
+    return true;
+}
 #pragma endregion
 
 #pragma region Template instantiations
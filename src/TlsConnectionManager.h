@@ -9,12 +9,57 @@
 
 #include "IConnection.h"
 #include "IConnectionManager.h"
+#include "Metrics.h"
+#include "TlsTransportContext.h"
 
 #include <arpa/inet.h>
+#include <chrono>
 #include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
+class IoUringEventLoop;
+
+/**
+ * @brief How accepted connections perform their socket I/O
+ */
+enum class TlsTransportBackend
+{
+    // A thread per connection polling its socket (TlsConnectionTransport)
+    Poll,
+    // One io_uring event loop shared by every connection (IoUringTlsConnectionTransport)
+    IoUring,
+};
+
+/**
+ * @brief Tuning for how TlsConnectionManager admits new connections
+ */
+struct TlsConnectionManagerOptions
+{
+    // Connections still negotiating TLS beyond this are closed as soon as they are accepted
+    size_t MaxPendingHandshakes = 1024;
+    // Per remote address cap on connections still negotiating TLS
+    size_t MaxPendingHandshakesPerAddress = 64;
+    std::chrono::milliseconds HandshakeTimeout = TlsTransportContext::DEFAULT_HANDSHAKE_TIMEOUT;
+    // Number of threads accepting connections, each with its own SO_REUSEPORT listen socket
+    size_t AcceptorThreadCount = 1;
+    // Pending connection queue length for each listen socket
+    int ListenBacklog = 1024;
+    // Offload the record layer of established connections to kernel TLS where available
+    bool EnableKernelTls = false;
+    // Falls back to Poll if the kernel doesn't support what the io_uring backend needs
+    TlsTransportBackend TransportBackend = TlsTransportBackend::Poll;
+    // Idle time before, and interval between, TCP keepalive probes; zero leaves them off
+    std::chrono::seconds TcpKeepAliveInterval = std::chrono::seconds(0);
+    // Unanswered keepalive probes before the kernel drops the connection
+    int TcpKeepAliveProbeCount = 3;
+    // How long sent data may go unacknowledged before the kernel drops the connection (zero
+    // keeps the kernel default of many minutes)
+    std::chrono::milliseconds TcpUserTimeout = std::chrono::milliseconds(0);
+};
+
 /**
  * @brief Class responsible for creating a TLS Server and accepting new TlsConnections
  */
@@ -22,10 +67,15 @@ template <class TConnection>
 class TlsConnectionManager : public IConnectionManager<TConnection>
 {
 public:
+    /* Static members */
+    static constexpr in_port_t DEFAULT_LISTEN_PORT = 8085;
+
     /* Constructor/Destructor */
     TlsConnectionManager(
         std::vector<std::byte> preSharedKey,
-        in_port_t listenPort = DEFAULT_LISTEN_PORT);
+        in_port_t listenPort = DEFAULT_LISTEN_PORT,
+        TlsConnectionManagerOptions options = TlsConnectionManagerOptions());
+    ~TlsConnectionManager();
 
     /* IConnectionManager */
     void Init() override;
@@ -35,10 +85,34 @@ public:
         std::function<void(std::shared_ptr<TConnection>)> onNewConnection) override;
 
 private:
-    static constexpr in_port_t DEFAULT_LISTEN_PORT = 8085;
-    static constexpr int SOCKET_LISTEN_QUEUE_LIMIT = 64;
+    /**
+     * @brief
+     *  Connections that have been accepted but haven't finished TLS negotiation. Shared with
+     *  transports' handshake callbacks, which may outlive a single accept loop iteration.
+     */
+    struct PendingHandshakes
+    {
+        std::mutex Mutex;
+        size_t Count = 0;
+        std::map<in_addr_t, size_t> CountByAddress;
+    };
+
     const std::vector<std::byte> preSharedKey;
     const in_port_t listenPort;
-    int listenSocketHandle;
+    const TlsConnectionManagerOptions options;
+    // Shared by every accepted connection; created in Init() once OpenSSL is initialized
+    std::shared_ptr<TlsTransportContext> transportContext;
+    // Performs I/O for every accepted connection when using the io_uring backend
+    std::shared_ptr<IoUringEventLoop> eventLoop;
+    const std::shared_ptr<PendingHandshakes> pendingHandshakes;
+    MetricsRegistry::GaugeHandle pendingHandshakesGauge;
+    std::mutex listenSocketHandlesMutex;
+    std::vector<int> listenSocketHandles;
     std::function<void(std::shared_ptr<TConnection>)> onNewConnection;
+
+    /* Private methods */
+    int createListenSocket();
+    void acceptConnections(int listenSocketHandle);
+    void configureAcceptedSocket(int socketHandle);
+    bool tryAdmitHandshake(const sockaddr_in& address);
 };
\ No newline at end of file
@@ -0,0 +1,403 @@
+/**
+ * @file TrafficCapture.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include "TrafficCapture.h"
+
+#include "BinaryEncoding.h"
+#include "Util.h"
+
+#include <array>
+#include <cstring>
+#include <fcntl.h>
+#include <spdlog/spdlog.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#pragma region Helpers
+namespace
+{
+    // "FTLOCAPT"
+    constexpr std::array<std::byte, 8> CAPTURE_MAGIC {
+        std::byte('F'), std::byte('T'), std::byte('L'), std::byte('O'),
+        std::byte('C'), std::byte('A'), std::byte('P'), std::byte('T'),
+    };
+    constexpr uint16_t CAPTURE_FORMAT_VERSION = 1;
+    constexpr size_t CAPTURE_HEADER_LENGTH = (8 + 2);
+
+    /**
+     * @brief Writes the fields of a message, after its type (the variant index)
+     */
+    struct MessageWriter
+    {
+        BinaryWriter& writer;
+
+        void operator()(const CapturedConnect&) { }
+
+        void operator()(const CapturedClose&) { }
+
+        void operator()(const ConnectionIntroPayload& payload)
+        {
+            writer.Write(payload.VersionMajor);
+            writer.Write(payload.VersionMinor);
+            writer.Write(payload.VersionRevision);
+            writer.Write(payload.RelayLayer);
+            writer.Write(payload.RegionCode);
+            writer.Write(payload.Hostname);
+        }
+
+        void operator()(const ConnectionOutroPayload& payload)
+        {
+            writer.Write(payload.DisconnectReason);
+        }
+
+        void operator()(const ConnectionNodeStatePayload& payload)
+        {
+            writer.WriteVarint(payload.CurrentLoad);
+            writer.WriteVarint(payload.MaximumLoad);
+        }
+
+        void operator()(const ConnectionSubscriptionPayload& payload)
+        {
+            writer.Write(static_cast<uint8_t>(payload.IsSubscribe));
+            writer.WriteVarint(payload.ChannelId);
+            writer.Write(payload.StreamKey);
+        }
+
+        void operator()(const ConnectionPublishPayload& payload)
+        {
+            writer.Write(static_cast<uint8_t>(payload.IsPublish));
+            writer.WriteVarint(payload.ChannelId);
+            writer.WriteVarint(payload.StreamId);
+        }
+
+        void operator()(const ConnectionRelayPayload& payload)
+        {
+            writer.Write(static_cast<uint8_t>(payload.IsStartRelay));
+            writer.WriteVarint(payload.ChannelId);
+            writer.WriteVarint(payload.StreamId);
+            writer.Write(payload.TargetHostname);
+            writer.Write(payload.StreamKey);
+        }
+    };
+
+    captured_message_t readMessage(BinaryReader& reader)
+    {
+        uint8_t type = reader.Read<uint8_t>();
+        switch (type)
+        {
+        case 0:
+            return CapturedConnect { };
+        case 1:
+            return CapturedClose { };
+        case 2:
+        {
+            ConnectionIntroPayload payload;
+            payload.VersionMajor = reader.Read<uint8_t>();
+            payload.VersionMinor = reader.Read<uint8_t>();
+            payload.VersionRevision = reader.Read<uint8_t>();
+            payload.RelayLayer = reader.Read<uint8_t>();
+            payload.RegionCode = reader.ReadString();
+            payload.Hostname = reader.ReadString();
+            return payload;
+        }
+        case 3:
+            return ConnectionOutroPayload
+            {
+                .DisconnectReason = reader.ReadString(),
+            };
+        case 4:
+        {
+            ConnectionNodeStatePayload payload;
+            payload.CurrentLoad = static_cast<uint32_t>(reader.ReadVarint());
+            payload.MaximumLoad = static_cast<uint32_t>(reader.ReadVarint());
+            return payload;
+        }
+        case 5:
+        {
+            ConnectionSubscriptionPayload payload;
+            payload.IsSubscribe = (reader.Read<uint8_t>() != 0);
+            payload.ChannelId = static_cast<ftl_channel_id_t>(reader.ReadVarint());
+            payload.StreamKey = reader.ReadBytes();
+            return payload;
+        }
+        case 6:
+        {
+            ConnectionPublishPayload payload;
+            payload.IsPublish = (reader.Read<uint8_t>() != 0);
+            payload.ChannelId = static_cast<ftl_channel_id_t>(reader.ReadVarint());
+            payload.StreamId = static_cast<ftl_stream_id_t>(reader.ReadVarint());
+            return payload;
+        }
+        case 7:
+        {
+            ConnectionRelayPayload payload;
+            payload.IsStartRelay = (reader.Read<uint8_t>() != 0);
+            payload.ChannelId = static_cast<ftl_channel_id_t>(reader.ReadVarint());
+            payload.StreamId = static_cast<ftl_stream_id_t>(reader.ReadVarint());
+            payload.TargetHostname = reader.ReadString();
+            payload.StreamKey = reader.ReadBytes();
+            return payload;
+        }
+        default:
+        {
+            std::stringstream errStr;
+            errStr << "Unknown capture record type " << static_cast<int>(type);
+            throw std::runtime_error(errStr.str());
+        }
+        }
+    }
+}
+#pragma endregion Helpers
+
+#pragma region Constructor/Destructor
+TrafficCapture::TrafficCapture(std::string path) :
+    path(path),
+    startTime(std::chrono::steady_clock::now()),
+    capturedMessages(MetricsRegistry::Default().GetCounter(
+        "ftl_orchestrator_captured_messages_total",
+        "Received messages written to the traffic capture")),
+    writeFailures(MetricsRegistry::Default().GetCounter(
+        "ftl_orchestrator_capture_write_failures_total",
+        "Traffic capture writes that failed; the messages in them are lost"))
+{
+    fileHandle = open(
+        path.c_str(),
+        (O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC),
+        (S_IRUSR | S_IWUSR | S_IRGRP));
+    if (fileHandle < 0)
+    {
+        int error = errno;
+        std::stringstream errStr;
+        errStr << "Could not create capture " << path << ": " << Util::ErrnoToString(error);
+        throw std::runtime_error(errStr.str());
+    }
+    BinaryWriter header;
+    header.GetBuffer().assign(CAPTURE_MAGIC.begin(), CAPTURE_MAGIC.end());
+    header.Write(CAPTURE_FORMAT_VERSION);
+    if (::write(fileHandle, header.GetBuffer().data(), header.GetBuffer().size()) !=
+        static_cast<ssize_t>(header.GetBuffer().size()))
+    {
+        int error = errno;
+        close(fileHandle);
+        std::stringstream errStr;
+        errStr << "Could not write header to capture " << path << ": " <<
+            Util::ErrnoToString(error);
+        throw std::runtime_error(errStr.str());
+    }
+
+    writerThread = std::thread(&TrafficCapture::writerThreadBody, this);
+}
+
+TrafficCapture::~TrafficCapture()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isStopping = true;
+    }
+    writeConditionVariable.notify_all();
+    writerThread.join();
+    close(fileHandle);
+}
+#pragma endregion Constructor/Destructor
+
+#pragma region Static methods
+std::vector<CaptureRecord> TrafficCapture::ReadFromFile(const std::string& path)
+{
+    int fileHandle = open(path.c_str(), (O_RDONLY | O_CLOEXEC));
+    if (fileHandle < 0)
+    {
+        int error = errno;
+        std::stringstream errStr;
+        errStr << "Could not open capture " << path << ": " << Util::ErrnoToString(error);
+        throw std::runtime_error(errStr.str());
+    }
+    struct stat fileStat;
+    if (fstat(fileHandle, &fileStat) < 0)
+    {
+        int error = errno;
+        close(fileHandle);
+        std::stringstream errStr;
+        errStr << "Could not stat capture " << path << ": " << Util::ErrnoToString(error);
+        throw std::runtime_error(errStr.str());
+    }
+    size_t fileLength = static_cast<size_t>(fileStat.st_size);
+    if (fileLength < CAPTURE_HEADER_LENGTH)
+    {
+        close(fileHandle);
+        throw std::runtime_error("Not an orchestrator traffic capture");
+    }
+    void* mapped = mmap(nullptr, fileLength, PROT_READ, MAP_PRIVATE, fileHandle, 0);
+    int mapError = errno;
+    // The mapping holds its own reference to the file
+    close(fileHandle);
+    if (mapped == MAP_FAILED)
+    {
+        std::stringstream errStr;
+        errStr << "Could not map capture " << path << ": " << Util::ErrnoToString(mapError);
+        throw std::runtime_error(errStr.str());
+    }
+
+    const std::byte* bytes = static_cast<const std::byte*>(mapped);
+    if (std::memcmp(bytes, CAPTURE_MAGIC.data(), CAPTURE_MAGIC.size()) != 0)
+    {
+        munmap(mapped, fileLength);
+        throw std::runtime_error("Not an orchestrator traffic capture");
+    }
+    BinaryReader header((bytes + CAPTURE_MAGIC.size()), sizeof(uint16_t));
+    uint16_t formatVersion = header.Read<uint16_t>();
+    if (formatVersion != CAPTURE_FORMAT_VERSION)
+    {
+        munmap(mapped, fileLength);
+        std::stringstream errStr;
+        errStr << "Unsupported capture format version " << formatVersion << " (expected " <<
+            CAPTURE_FORMAT_VERSION << ")";
+        throw std::runtime_error(errStr.str());
+    }
+
+    std::vector<CaptureRecord> records;
+    BinaryReader reader((bytes + CAPTURE_HEADER_LENGTH), (fileLength - CAPTURE_HEADER_LENGTH));
+    std::chrono::nanoseconds timestamp(0);
+    try
+    {
+        while (!reader.IsAtEnd())
+        {
+            timestamp += std::chrono::nanoseconds(reader.ReadVarint());
+            uint32_t connectionId = static_cast<uint32_t>(reader.ReadVarint());
+            captured_message_t message = readMessage(reader);
+            records.push_back(CaptureRecord
+                {
+                    .Timestamp = timestamp,
+                    .ConnectionId = connectionId,
+                    .Message = std::move(message),
+                });
+        }
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::warn(
+            "TrafficCapture: Ignoring the rest of {} after {} records: {}",
+            path,
+            records.size(),
+            e.what());
+    }
+    munmap(mapped, fileLength);
+    return records;
+}
+#pragma endregion Static methods
+
+#pragma region Public methods
+uint32_t TrafficCapture::AddConnection()
+{
+    uint32_t connectionId;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        connectionId = nextConnectionId++;
+    }
+    Record(connectionId, CapturedConnect { });
+    return connectionId;
+}
+
+void TrafficCapture::Record(uint32_t connectionId, captured_message_t message)
+{
+    {
+        // Timestamped under the lock so records are queued in timestamp order
+        std::lock_guard<std::mutex> lock(mutex);
+        pendingRecords.push_back(CaptureRecord
+            {
+                .Timestamp = (std::chrono::steady_clock::now() - startTime),
+                .ConnectionId = connectionId,
+                .Message = std::move(message),
+            });
+        ++recordedCount;
+    }
+    writeConditionVariable.notify_one();
+}
+
+void TrafficCapture::Flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    uint64_t flushCount = recordedCount;
+    writtenConditionVariable.wait(
+        lock,
+        [this, flushCount]() { return (writtenCount >= flushCount); });
+}
+#pragma endregion Public methods
+
+#pragma region Private methods
+void TrafficCapture::writerThreadBody()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        writeConditionVariable.wait(
+            lock,
+            [this]() { return (isStopping || !pendingRecords.empty()); });
+
+        // Everything queued while the last write was in flight goes out together
+        std::vector<CaptureRecord> records;
+        records.swap(pendingRecords);
+        lock.unlock();
+
+        if (!records.empty())
+        {
+            try
+            {
+                write(records);
+            }
+            catch (const std::exception& e)
+            {
+                spdlog::error("TrafficCapture: {}", e.what());
+                writeFailures.Increment();
+            }
+        }
+
+        lock.lock();
+        writtenCount += records.size();
+        writtenConditionVariable.notify_all();
+        if (isStopping && pendingRecords.empty())
+        {
+            break;
+        }
+    }
+}
+
+void TrafficCapture::write(const std::vector<CaptureRecord>& records)
+{
+    BinaryWriter batch;
+    for (const auto& record : records)
+    {
+        batch.WriteVarint(static_cast<uint64_t>((record.Timestamp - lastWrittenTimestamp).count()));
+        lastWrittenTimestamp = record.Timestamp;
+        batch.WriteVarint(record.ConnectionId);
+        batch.Write(static_cast<uint8_t>(record.Message.index()));
+        std::visit(MessageWriter { .writer = batch }, record.Message);
+    }
+    const std::vector<std::byte>& bytes = batch.GetBuffer();
+
+    size_t written = 0;
+    while (written < bytes.size())
+    {
+        ssize_t result = ::write(fileHandle, (bytes.data() + written), (bytes.size() - written));
+        if (result < 0)
+        {
+            int error = errno;
+            if (error == EINTR)
+            {
+                continue;
+            }
+            std::stringstream errStr;
+            errStr << "Could not write capture " << path << ": " << Util::ErrnoToString(error);
+            throw std::runtime_error(errStr.str());
+        }
+        written += static_cast<size_t>(result);
+    }
+    capturedMessages.Increment(records.size());
+}
+#pragma endregion Private methods
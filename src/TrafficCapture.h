@@ -0,0 +1,123 @@
+/**
+ * @file TrafficCapture.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#pragma once
+
+#include "FtlTypes.h"
+#include "IConnection.h"
+#include "Metrics.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+/**
+ * @brief Marks a connection being accepted; it has no payload of its own
+ */
+struct CapturedConnect { };
+
+/**
+ * @brief Marks a connection being closed
+ */
+struct CapturedClose { };
+
+typedef std::variant<
+    CapturedConnect,
+    CapturedClose,
+    ConnectionIntroPayload,
+    ConnectionOutroPayload,
+    ConnectionNodeStatePayload,
+    ConnectionSubscriptionPayload,
+    ConnectionPublishPayload,
+    ConnectionRelayPayload> captured_message_t;
+
+/**
+ * @brief A message the orchestrator received, and who from and when
+ */
+struct CaptureRecord
+{
+    // Time since the capture started
+    std::chrono::nanoseconds Timestamp;
+    // Assigned when the connection is accepted, unique within a capture
+    uint32_t ConnectionId;
+    captured_message_t Message;
+};
+
+/**
+ * @brief
+ *  Records every message the orchestrator receives to a file, so the traffic can be replayed
+ *  offline against an Orchestrator<MockConnection> to reproduce an incident or measure a change.
+ *
+ *  Record() only queues the message; a writer thread owned by the capture writes out everything
+ *  queued since its last write together. Records are varint-encoded and carry the time since
+ *  the previous one, so most take a handful of bytes.
+ */
+class TrafficCapture
+{
+public:
+    /* Constructor/Destructor */
+    /**
+     * @throws std::runtime_error if the file can't be created
+     */
+    TrafficCapture(std::string path);
+    ~TrafficCapture();
+
+    TrafficCapture(const TrafficCapture&) = delete;
+    TrafficCapture& operator=(const TrafficCapture&) = delete;
+
+    /* Static methods */
+    /**
+     * @brief Reads every record from a capture. A torn record at the end (from a capture that
+     *  was never stopped) ends the read.
+     * @throws std::runtime_error if the file can't be read or isn't a capture
+     */
+    static std::vector<CaptureRecord> ReadFromFile(const std::string& path);
+
+    /* Public methods */
+    /**
+     * @brief Gives a newly accepted connection an ID and records that it connected
+     */
+    uint32_t AddConnection();
+
+    /**
+     * @brief Queues a message to be written, timestamped now
+     */
+    void Record(uint32_t connectionId, captured_message_t message);
+
+    /**
+     * @brief Waits until every message recorded so far has been written
+     */
+    void Flush();
+
+private:
+    /* Private members */
+    const std::string path;
+    const std::chrono::steady_clock::time_point startTime;
+    std::mutex mutex;
+    std::condition_variable writeConditionVariable;
+    std::condition_variable writtenConditionVariable;
+    std::vector<CaptureRecord> pendingRecords;
+    uint32_t nextConnectionId = 1;
+    uint64_t recordedCount = 0;
+    uint64_t writtenCount = 0;
+    bool isStopping = false;
+    // Only touched by the writer thread
+    int fileHandle = -1;
+    std::chrono::nanoseconds lastWrittenTimestamp { 0 };
+    MetricCounter& capturedMessages;
+    MetricCounter& writeFailures;
+    std::thread writerThread;
+
+    /* Private methods */
+    void writerThreadBody();
+    void write(const std::vector<CaptureRecord>& records);
+};
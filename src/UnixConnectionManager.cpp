@@ -0,0 +1,238 @@
+/**
+ * @file UnixConnectionManager.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include "UnixConnectionManager.h"
+
+#include "FtlConnection.h"
+#include "Metrics.h"
+#include "UnixConnectionTransport.h"
+#include "Util.h"
+
+#include <cstring>
+#include <spdlog/spdlog.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+#pragma region Constructor/Destructor
+template <class T>
+UnixConnectionManager<T>::UnixConnectionManager(
+    std::string socketPath,
+    UnixConnectionManagerOptions options
+) :
+    socketPath(socketPath),
+    options(options)
+{ }
+#pragma endregion
+
+#pragma region IConnectionManager
+template <class T>
+void UnixConnectionManager<T>::Init()
+{
+    if (socketPath.size() >= sizeof(sockaddr_un::sun_path))
+    {
+        std::stringstream errStr;
+        errStr << "Unix socket path '" << socketPath << "' is too long";
+        throw std::runtime_error(errStr.str());
+    }
+}
+
+template <class T>
+void UnixConnectionManager<T>::Listen(std::promise<void>&& readyPromise)
+{
+    int socketHandle = createListenSocket();
+    {
+        std::lock_guard<std::mutex> lock(listenSocketHandleMutex);
+        listenSocketHandle = socketHandle;
+    }
+
+    spdlog::info("UnixConnectionManager: Listening on {}...", socketPath);
+    readyPromise.set_value();
+
+    static MetricCounter& rejectedConnections = MetricsRegistry::Default().GetCounter(
+        "ftl_orchestrator_unix_connections_rejected_total",
+        "Unix socket connections closed because the peer's user is not allowed");
+    while (true)
+    {
+        int clientHandle = accept4(socketHandle, nullptr, nullptr, SOCK_CLOEXEC);
+        if (clientHandle < 0)
+        {
+            int error = errno;
+            if (error == EINVAL)
+            {
+                // This means we've closed the listen handle
+                spdlog::info("UnixConnectionManager: Shutting down listener on {}...",
+                    socketPath);
+                break;
+            }
+            if ((error == EINTR) || (error == ECONNABORTED) || (error == EMFILE) ||
+                (error == ENFILE) || (error == ENOBUFS) || (error == ENOMEM))
+            {
+                spdlog::warn("UnixConnectionManager: accept() failed transiently: {}",
+                    Util::ErrnoToString(error));
+                if (error != EINTR && error != ECONNABORTED)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+                continue;
+            }
+            std::stringstream errStr;
+            errStr << "Unable to accept incoming unix connection! Error "
+                << error << ": " << Util::ErrnoToString(error);
+            throw std::runtime_error(errStr.str());
+        }
+
+        // The kernel records who connected; that's our only authentication
+        ucred peerCredentials { };
+        socklen_t peerCredentialsLen = sizeof(peerCredentials);
+        if (getsockopt(
+            clientHandle,
+            SOL_SOCKET,
+            SO_PEERCRED,
+            &peerCredentials,
+            &peerCredentialsLen) != 0)
+        {
+            int error = errno;
+            spdlog::warn("UnixConnectionManager: Could not read peer credentials: {}",
+                Util::ErrnoToString(error));
+            close(clientHandle);
+            continue;
+        }
+        if (!isPeerAllowed(peerCredentials.uid))
+        {
+            rejectedConnections.Increment();
+            spdlog::warn(
+                "UnixConnectionManager: Rejecting connection from pid {} uid {}",
+                peerCredentials.pid,
+                peerCredentials.uid);
+            close(clientHandle);
+            continue;
+        }
+
+        spdlog::info(
+            "UnixConnectionManager: Accepted new connection on fd {} from pid {} uid {}",
+            clientHandle,
+            peerCredentials.pid,
+            peerCredentials.uid);
+
+        auto transport = std::make_shared<UnixConnectionTransport>(
+            clientHandle,
+            peerCredentials.uid);
+        std::shared_ptr<T> connection = std::make_shared<T>(transport);
+
+        if (onNewConnection)
+        {
+            onNewConnection(connection);
+        }
+        else
+        {
+            spdlog::warn("Accepted a new connection, but nobody was listening. :(");
+        }
+    }
+}
+
+template <class T>
+void UnixConnectionManager<T>::StopListening()
+{
+    std::lock_guard<std::mutex> lock(listenSocketHandleMutex);
+    if (listenSocketHandle < 0)
+    {
+        return;
+    }
+    shutdown(listenSocketHandle, SHUT_RDWR);
+    close(listenSocketHandle);
+    listenSocketHandle = -1;
+    unlink(socketPath.c_str());
+    spdlog::debug("UnixConnectionManager: Closed listening on {}", socketPath);
+}
+
+template <class T>
+void UnixConnectionManager<T>::SetOnNewConnection(
+    std::function<void(std::shared_ptr<T>)> onNewConnection)
+{
+    this->onNewConnection = onNewConnection;
+}
+#pragma endregion
+
+#pragma region Private methods
+template <class T>
+int UnixConnectionManager<T>::createListenSocket()
+{
+    sockaddr_un listenAddr { };
+    listenAddr.sun_family = AF_UNIX;
+    strncpy(listenAddr.sun_path, socketPath.c_str(), (sizeof(listenAddr.sun_path) - 1));
+
+    int socketHandle = socket(AF_UNIX, (SOCK_STREAM | SOCK_CLOEXEC), 0);
+    if (socketHandle < 0)
+    {
+        int error = errno;
+        std::stringstream errStr;
+        errStr << "Unable to create unix listen socket! Error "
+            << error << ": " << Util::ErrnoToString(error);
+        throw std::runtime_error(errStr.str());
+    }
+
+    // A socket file left behind by a previous run would make bind fail
+    struct stat pathStat;
+    if ((lstat(socketPath.c_str(), &pathStat) == 0) && S_ISSOCK(pathStat.st_mode))
+    {
+        unlink(socketPath.c_str());
+    }
+
+    if (bind(
+        socketHandle,
+        reinterpret_cast<const sockaddr*>(&listenAddr),
+        sizeof(listenAddr)) < 0)
+    {
+        int error = errno;
+        close(socketHandle);
+        std::stringstream errStr;
+        errStr << "Unable to bind unix socket " << socketPath << "! Error "
+            << error << ": " << Util::ErrnoToString(error);
+        throw std::runtime_error(errStr.str());
+    }
+
+    if (chmod(socketPath.c_str(), options.SocketMode) < 0)
+    {
+        int error = errno;
+        spdlog::warn("UnixConnectionManager: Could not set permissions on {}: {}",
+            socketPath,
+            Util::ErrnoToString(error));
+    }
+
+    if (listen(socketHandle, options.ListenBacklog) < 0)
+    {
+        int error = errno;
+        close(socketHandle);
+        unlink(socketPath.c_str());
+        std::stringstream errStr;
+        errStr << "Unable to listen on unix socket! Error "
+            << error << ": " << Util::ErrnoToString(error);
+        throw std::runtime_error(errStr.str());
+    }
+
+    return socketHandle;
+}
+
+template <class T>
+bool UnixConnectionManager<T>::isPeerAllowed(uid_t peerUid)
+{
+    if (options.AllowOwnUser && (peerUid == geteuid()))
+    {
+        return true;
+    }
+    return (options.AllowedUids.count(peerUid) > 0);
+}
+#pragma endregion
+
+#pragma region Template instantiations
+// Yeah, this is weird, but necessary.
+// See https://stackoverflow.com/questions/495021/why-can-templates-only-be-implemented-in-the-header-file
+template class UnixConnectionManager<FtlConnection>;
+#pragma endregion
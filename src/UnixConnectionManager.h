@@ -0,0 +1,69 @@
+/**
+ * @file UnixConnectionManager.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#pragma once
+
+#include "IConnection.h"
+#include "IConnectionManager.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+/**
+ * @brief Tuning for how UnixConnectionManager listens and who it lets in
+ */
+struct UnixConnectionManagerOptions
+{
+    // Peers running as the same user as the orchestrator may connect
+    bool AllowOwnUser = true;
+    // Additional users whose processes may connect
+    std::set<uid_t> AllowedUids;
+    // Permissions applied to the socket file; connecting requires write permission
+    mode_t SocketMode = 0660;
+    // Pending connection queue length for the listen socket
+    int ListenBacklog = 1024;
+};
+
+/**
+ * @brief
+ *  Class responsible for accepting plaintext connections from co-located nodes over an AF_UNIX
+ *  stream socket. Instead of a pre-shared key, peers are authenticated by the user id the
+ *  kernel reports for them (SO_PEERCRED).
+ */
+template <class TConnection>
+class UnixConnectionManager : public IConnectionManager<TConnection>
+{
+public:
+    /* Constructor/Destructor */
+    UnixConnectionManager(
+        std::string socketPath,
+        UnixConnectionManagerOptions options = UnixConnectionManagerOptions());
+
+    /* IConnectionManager */
+    void Init() override;
+    void Listen(std::promise<void>&& readyPromise = std::promise<void>()) override;
+    void StopListening() override;
+    void SetOnNewConnection(
+        std::function<void(std::shared_ptr<TConnection>)> onNewConnection) override;
+
+private:
+    const std::string socketPath;
+    const UnixConnectionManagerOptions options;
+    std::mutex listenSocketHandleMutex;
+    int listenSocketHandle = -1;
+    std::function<void(std::shared_ptr<TConnection>)> onNewConnection;
+
+    /* Private methods */
+    int createListenSocket();
+    bool isPeerAllowed(uid_t peerUid);
+};
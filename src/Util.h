@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <arpa/inet.h>
 #include <string>
 #include <string.h>
 
@@ -20,4 +21,14 @@ public:
         char* errMsg = strerror_r(error, errnoStrBuf, sizeof(errnoStrBuf));
         return std::string(errMsg);
     }
+
+    static std::string AddressToString(const in_addr& address)
+    {
+        char addressStrBuf[INET_ADDRSTRLEN];
+        if (inet_ntop(AF_INET, &address, addressStrBuf, sizeof(addressStrBuf)) == nullptr)
+        {
+            return std::string("unknown");
+        }
+        return std::string(addressStrBuf);
+    }
 };
\ No newline at end of file
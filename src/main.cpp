@@ -6,12 +6,21 @@
  * 
  */
 
+#include "CompositeConnectionManager.h"
 #include "Configuration.h"
 #include "FtlConnection.h"
+#include "FtlOrchestrationClient.h"
+#include "LocalHttpServer.h"
+#include "Logging.h"
+#include "Metrics.h"
 #include "Orchestrator.h"
+#include "StandbyReplica.h"
 #include "TlsConnectionManager.h"
+#include "UnixConnectionManager.h"
 
 #include <memory>
+#include <signal.h>
+#include <unistd.h>
 
 /**
  * @brief Entrypoint for the program binary.
@@ -23,15 +32,131 @@ int main()
     std::unique_ptr<Configuration> configuration = std::make_unique<Configuration>();
     configuration->Load();
 
+    // Keep log formatting and output off of the connection threads
+    Logging::InitAsync(
+        configuration->GetLogLevel(),
+        configuration->GetLogQueueSize(),
+        configuration->GetLogDropOnOverflow());
+
+    // Peers can disconnect mid-write (e.g. during TLS negotiation); surface that as a failed
+    // write on that connection instead of terminating the process
+    signal(SIGPIPE, SIG_IGN);
+
     // Set up our service to listen to orchestration connections via TCP/TLS
+    std::unique_ptr<IConnectionManager<FtlConnection>> connectionManager =
+        std::make_unique<TlsConnectionManager<FtlConnection>>(
+            configuration->GetPreSharedKey(),
+            TlsConnectionManager<FtlConnection>::DEFAULT_LISTEN_PORT,
+            TlsConnectionManagerOptions
+            {
+                .MaxPendingHandshakes = configuration->GetMaxPendingHandshakes(),
+                .MaxPendingHandshakesPerAddress =
+                    configuration->GetMaxPendingHandshakesPerAddress(),
+                .HandshakeTimeout = configuration->GetHandshakeTimeout(),
+                .AcceptorThreadCount = configuration->GetAcceptorThreadCount(),
+                .ListenBacklog = configuration->GetListenBacklog(),
+                .EnableKernelTls = configuration->GetKernelTlsEnabled(),
+                .TransportBackend = configuration->GetIoUringTransportEnabled() ?
+                    TlsTransportBackend::IoUring : TlsTransportBackend::Poll,
+                .TcpKeepAliveInterval = configuration->GetTcpKeepAliveInterval(),
+                .TcpUserTimeout = configuration->GetTcpUserTimeout(),
+            });
+
+    // ...and co-located nodes over a Unix socket alongside it, if configured
+    if (!configuration->GetUnixSocketPath().empty())
+    {
+        std::vector<std::unique_ptr<IConnectionManager<FtlConnection>>> connectionManagers;
+        connectionManagers.push_back(std::move(connectionManager));
+        connectionManagers.push_back(
+            std::make_unique<UnixConnectionManager<FtlConnection>>(
+                configuration->GetUnixSocketPath(),
+                UnixConnectionManagerOptions
+                {
+                    .AllowedUids = configuration->GetUnixSocketAllowedUids(),
+                }));
+        connectionManager = std::make_unique<CompositeConnectionManager<FtlConnection>>(
+            std::move(connectionManagers));
+    }
+
     auto orchestrator = std::make_unique<Orchestrator<FtlConnection>>(
-            std::make_unique<TlsConnectionManager<FtlConnection>>(
-                configuration->GetPreSharedKey()));
+        std::move(connectionManager),
+        OrchestratorOptions
+        {
+            .HeartbeatInterval = configuration->GetHeartbeatInterval(),
+            .HeartbeatMissThreshold = configuration->GetHeartbeatMissThreshold(),
+            .RelayBatchWindow = configuration->GetRelayBatchWindow(),
+            .RouteLinger = configuration->GetRouteLinger(),
+            .ChannelRouteLinger = configuration->GetChannelRouteLinger(),
+            .SnapshotPath = configuration->GetSnapshotPath(),
+            .SnapshotInterval = configuration->GetSnapshotInterval(),
+            .SnapshotReconcileTimeout = configuration->GetSnapshotReconcileTimeout(),
+            .JournalPath = configuration->GetJournalPath(),
+            .JournalFsync = configuration->GetJournalFsyncPolicy(),
+            .JournalFsyncInterval = configuration->GetJournalFsyncInterval(),
+            .CapturePath = configuration->GetCapturePath(),
+        });
     
     // Initialize
     orchestrator->Init();
 
+    // Serve Prometheus metrics on the loopback interface if requested
+    std::unique_ptr<LocalHttpServer> httpServer;
+    auto droppedLogsGauge = MetricsRegistry::Default().AddGauge(
+        "ftl_orchestrator_dropped_log_messages",
+        "Log messages discarded because the log queue was full",
+        []() { return static_cast<double>(Logging::GetDroppedMessageCount()); });
+    if (configuration->GetMetricsPort() != 0)
+    {
+        httpServer = std::make_unique<LocalHttpServer>(configuration->GetMetricsPort());
+        httpServer->AddRoute("GET", "/metrics",
+            [](const HttpRequest&)
+            {
+                return HttpResponse
+                {
+                    .ContentType = "text/plain; version=0.0.4; charset=utf-8",
+                    .Body = MetricsRegistry::Default().Serialize(),
+                };
+            });
+        httpServer->Start();
+    }
+
+    // As a standby, mirror the primary's state until it's lost, then take over with it
+    if (!configuration->GetStandbyPrimaryHostname().empty())
+    {
+        char hostname[256] { 0 };
+        gethostname(hostname, (sizeof(hostname) - 1));
+        auto transportContext =
+            FtlOrchestrationClient::CreateTransportContext(configuration->GetPreSharedKey());
+        StandbyReplicaOptions standbyOptions;
+        if (configuration->GetHeartbeatInterval().count() > 0)
+        {
+            standbyOptions.HeartbeatInterval = configuration->GetHeartbeatInterval();
+            standbyOptions.HeartbeatMissThreshold = configuration->GetHeartbeatMissThreshold();
+        }
+        StandbyReplica<FtlConnection> standby(
+            [&configuration, &transportContext, &hostname]()
+            {
+                return FtlOrchestrationClient::Connect(
+                    configuration->GetStandbyPrimaryHostname(),
+                    transportContext,
+                    std::string(hostname),
+                    configuration->GetStandbyPrimaryPort());
+            },
+            standbyOptions);
+        spdlog::info(
+            "Standing by for primary orchestrator {}:{}...",
+            configuration->GetStandbyPrimaryHostname(),
+            configuration->GetStandbyPrimaryPort());
+        orchestrator->RestoreState(standby.WaitForFailover());
+    }
+
     // Off we go
     orchestrator->Run();
+
+    if (httpServer)
+    {
+        httpServer->Stop();
+    }
+    Logging::Shutdown();
     return 0;
 }
\ No newline at end of file
@@ -5,15 +5,21 @@
  * @copyright Copyright (c) 2020 Hayden McAfee
  */
 
+#include <CompositeConnectionManager.h>
 #include <FtlOrchestrationClient.h>
 #include <Orchestrator.h>
 #include <TlsConnectionManager.h>
+#include <UnixConnectionManager.h>
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <list>
 #include <mutex>
+#include <poll.h>
+#include <sys/socket.h>
 #include <thread>
+#include <unistd.h>
 #include <vector>
 
 /**
@@ -24,7 +30,10 @@
 class FunctionalTestsFixture
 {
 public:
-    FunctionalTestsFixture() : 
+    FunctionalTestsFixture(
+        TlsConnectionManagerOptions options = TlsConnectionManagerOptions(),
+        std::string unixSocketPath = std::string(),
+        UnixConnectionManagerOptions unixOptions = UnixConnectionManagerOptions()) : 
         preSharedKey(
             {
                 std::byte(0x00), std::byte(0x01), std::byte(0x02), std::byte(0x03), 
@@ -33,7 +42,7 @@ public:
                 std::byte(0x0c), std::byte(0x0d), std::byte(0x0e), std::byte(0x0f), 
             }),
         orchestrator(std::make_unique<Orchestrator<FtlConnection>>(
-            std::make_unique<TlsConnectionManager<FtlConnection>>(preSharedKey)))
+            newConnectionManager(preSharedKey, options, unixSocketPath, unixOptions)))
     {
         orchestrator->Init();
 
@@ -84,6 +93,75 @@ public:
         return connection;
     }
 
+    /**
+     * @brief Opens a plain TCP connection to the local orchestration service that never
+     *  starts TLS negotiation
+     * @return int socket handle, owned by the caller
+     */
+    int ConnectStalledSocket()
+    {
+        sockaddr_in targetAddr
+        {
+            .sin_family = AF_INET,
+            .sin_port = htons(TlsConnectionManager<FtlConnection>::DEFAULT_LISTEN_PORT),
+            .sin_addr = { .s_addr = htonl(INADDR_LOOPBACK) },
+        };
+        int socketHandle = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        REQUIRE(socketHandle >= 0);
+        REQUIRE(connect(
+            socketHandle,
+            reinterpret_cast<const sockaddr*>(&targetAddr),
+            sizeof(targetAddr)) == 0);
+        return socketHandle;
+    }
+
+    /**
+     * @brief Waits for the remote end to close the given socket
+     * @return bool true if the socket was closed within the timeout
+     */
+    bool WaitForRemoteClose(int socketHandle, std::chrono::milliseconds timeout)
+    {
+        pollfd pollFd
+        {
+            .fd = socketHandle,
+            .events = POLLIN,
+            .revents = 0,
+        };
+        if (poll(&pollFd, 1, timeout.count()) <= 0)
+        {
+            return false;
+        }
+        char readBuf[16];
+        return (recv(socketHandle, readBuf, sizeof(readBuf), 0) <= 0);
+    }
+
+    /**
+     * @brief Builds the TLS connection manager, plus a Unix socket one alongside it if a path
+     *  is given
+     */
+    static std::unique_ptr<IConnectionManager<FtlConnection>> newConnectionManager(
+        std::vector<std::byte> preSharedKey,
+        TlsConnectionManagerOptions options,
+        std::string unixSocketPath,
+        UnixConnectionManagerOptions unixOptions)
+    {
+        auto tlsConnectionManager = std::make_unique<TlsConnectionManager<FtlConnection>>(
+            preSharedKey,
+            TlsConnectionManager<FtlConnection>::DEFAULT_LISTEN_PORT,
+            options);
+        if (unixSocketPath.empty())
+        {
+            return tlsConnectionManager;
+        }
+        std::vector<std::unique_ptr<IConnectionManager<FtlConnection>>> connectionManagers;
+        connectionManagers.push_back(std::move(tlsConnectionManager));
+        connectionManagers.push_back(std::make_unique<UnixConnectionManager<FtlConnection>>(
+            unixSocketPath,
+            unixOptions));
+        return std::make_unique<CompositeConnectionManager<FtlConnection>>(
+            std::move(connectionManagers));
+    }
+
 protected:
     const std::chrono::milliseconds WAIT_TIMEOUT = std::chrono::milliseconds(1000);
     const std::vector<std::byte> preSharedKey;
@@ -264,4 +342,317 @@ TEST_CASE_METHOD(
 
     // Stop connections
     ingestClient->Stop();
-}
\ No newline at end of file
+}
+
+TEST_CASE_METHOD(
+    FunctionalTestsFixture,
+    "Stalled TLS handshakes do not block new connections",
+    "[functional][tls]")
+{
+    // Open a few connections that never send a ClientHello
+    std::vector<int> stalledSockets;
+    for (int i = 0; i < 3; ++i)
+    {
+        stalledSockets.push_back(ConnectStalledSocket());
+    }
+
+    // A well-behaved client should still connect right away
+    bool isClientClosed = false;
+    auto client = ConnectNewClient("edge");
+    client->SetOnConnectionClosed([&isClientClosed]() { isClientClosed = true; });
+    auto startTime = std::chrono::steady_clock::now();
+    client->Start();
+    REQUIRE((std::chrono::steady_clock::now() - startTime) < WAIT_TIMEOUT);
+    REQUIRE(isClientClosed == false);
+
+    client->Stop();
+    for (const auto& stalledSocket : stalledSockets)
+    {
+        close(stalledSocket);
+    }
+}
+
+/**
+ * @brief Runs the orchestration service with a tight per-address handshake limit
+ */
+class HandshakeLimitTestsFixture : public FunctionalTestsFixture
+{
+public:
+    static constexpr size_t MAX_PENDING_PER_ADDRESS = 2;
+
+    HandshakeLimitTestsFixture() :
+        FunctionalTestsFixture(TlsConnectionManagerOptions
+            {
+                .MaxPendingHandshakes = 16,
+                .MaxPendingHandshakesPerAddress = MAX_PENDING_PER_ADDRESS,
+            })
+    { }
+};
+
+TEST_CASE_METHOD(
+    HandshakeLimitTestsFixture,
+    "Connections beyond the per-address handshake limit are closed",
+    "[functional][tls]")
+{
+    std::vector<int> stalledSockets;
+    for (size_t i = 0; i < MAX_PENDING_PER_ADDRESS; ++i)
+    {
+        stalledSockets.push_back(ConnectStalledSocket());
+    }
+
+    // The next connection from this address should be turned away immediately
+    int rejectedSocket = ConnectStalledSocket();
+    REQUIRE(WaitForRemoteClose(rejectedSocket, WAIT_TIMEOUT));
+    close(rejectedSocket);
+
+    // Once the stalled handshakes go away, their slots are released
+    for (const auto& stalledSocket : stalledSockets)
+    {
+        close(stalledSocket);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    bool isClientClosed = false;
+    auto client = ConnectNewClient("edge");
+    client->SetOnConnectionClosed([&isClientClosed]() { isClientClosed = true; });
+    client->Start();
+    REQUIRE(isClientClosed == false);
+    client->Stop();
+}
+
+/**
+ * @brief Runs the orchestration service with several SO_REUSEPORT acceptors
+ */
+class MultiAcceptorTestsFixture : public FunctionalTestsFixture
+{
+public:
+    MultiAcceptorTestsFixture() :
+        FunctionalTestsFixture(TlsConnectionManagerOptions
+            {
+                .AcceptorThreadCount = 4,
+            })
+    { }
+};
+
+TEST_CASE_METHOD(
+    MultiAcceptorTestsFixture,
+    "Connections are accepted across multiple acceptors",
+    "[functional][tls]")
+{
+    constexpr int CLIENT_COUNT = 16;
+    std::vector<std::shared_ptr<FtlConnection>> clients(CLIENT_COUNT);
+    std::atomic<int> closedCount { 0 };
+    std::vector<std::thread> connectThreads;
+    for (int i = 0; i < CLIENT_COUNT; ++i)
+    {
+        connectThreads.emplace_back(
+            [this, i, &clients, &closedCount]()
+            {
+                auto client = FtlOrchestrationClient::Connect(
+                    "127.0.0.1",
+                    preSharedKey,
+                    "edge" + std::to_string(i));
+                client->SetOnConnectionClosed([&closedCount]() { ++closedCount; });
+                client->Start();
+                clients.at(i) = client;
+            });
+    }
+    for (auto& connectThread : connectThreads)
+    {
+        connectThread.join();
+    }
+    REQUIRE(closedCount == 0);
+
+    for (const auto& client : clients)
+    {
+        client->Stop();
+    }
+}
+
+/**
+ * @brief Runs the orchestration service with the io_uring transport backend
+ */
+class IoUringTransportTestsFixture : public FunctionalTestsFixture
+{
+public:
+    IoUringTransportTestsFixture() :
+        FunctionalTestsFixture(TlsConnectionManagerOptions
+            {
+                .TransportBackend = TlsTransportBackend::IoUring,
+            })
+    { }
+};
+
+TEST_CASE_METHOD(
+    IoUringTransportTestsFixture,
+    "Ingest to Edge relaying over the io_uring transport",
+    "[functional][relay][io_uring]")
+{
+    // Falls back to poll on kernels without io_uring support, which is still expected to work
+    ftl_channel_id_t channelId = 1234;
+    ftl_stream_id_t streamId = 5678;
+    std::vector<std::byte> streamKey(16, std::byte(0x0a));
+
+    auto ingestClient = ConnectNewClient("ingest", true);
+    auto edgeClient = ConnectNewClient("edge", true);
+
+    std::optional<ConnectionRelayPayload> recvRelayPayload;
+    std::mutex recvRelayMutex;
+    std::condition_variable recvRelayCv;
+    ingestClient->SetOnStreamRelay(
+        [&recvRelayPayload, &recvRelayMutex, &recvRelayCv](ConnectionRelayPayload relayPayload)
+        {
+            {
+                std::lock_guard<std::mutex> lock(recvRelayMutex);
+                recvRelayPayload = relayPayload;
+            }
+            recvRelayCv.notify_one();
+            return ConnectionResult
+            {
+                .IsSuccess = true
+            };
+        });
+
+    edgeClient->SendChannelSubscription(
+        ConnectionSubscriptionPayload
+        {
+            .IsSubscribe = true,
+            .ChannelId = channelId,
+            .StreamKey = streamKey,
+        });
+    ingestClient->SendStreamPublish(
+        ConnectionPublishPayload
+        {
+            .IsPublish = true,
+            .ChannelId = channelId,
+            .StreamId = streamId,
+        });
+
+    std::unique_lock<std::mutex> lock(recvRelayMutex);
+    recvRelayCv.wait_for(
+        lock,
+        WAIT_TIMEOUT,
+        [&recvRelayPayload]() { return recvRelayPayload.has_value(); });
+    REQUIRE(recvRelayPayload.has_value());
+    REQUIRE(recvRelayPayload.value().IsStartRelay == true);
+    REQUIRE(recvRelayPayload.value().ChannelId == channelId);
+    REQUIRE(recvRelayPayload.value().TargetHostname == edgeClient->GetHostname());
+    lock.unlock();
+
+    ingestClient->Stop();
+    edgeClient->Stop();
+}
+
+/**
+ * @brief Runs the orchestration service with a Unix socket listener alongside TLS
+ */
+class UnixSocketTestsFixture : public FunctionalTestsFixture
+{
+public:
+    UnixSocketTestsFixture(
+        UnixConnectionManagerOptions unixOptions = UnixConnectionManagerOptions()) :
+        FunctionalTestsFixture(TlsConnectionManagerOptions(), unixSocketPath(), unixOptions)
+    { }
+
+    static std::string unixSocketPath()
+    {
+        return "/tmp/ftl-orchestrator-test-" + std::to_string(getpid()) + ".sock";
+    }
+};
+
+TEST_CASE_METHOD(
+    UnixSocketTestsFixture,
+    "Unix socket nodes relay with TLS nodes",
+    "[functional][relay][unix]")
+{
+    ftl_channel_id_t channelId = 1234;
+    ftl_stream_id_t streamId = 5678;
+    std::vector<std::byte> streamKey(16, std::byte(0x0b));
+
+    // A co-located ingest over the Unix socket, and a remote edge over TLS
+    auto ingestClient = FtlOrchestrationClient::ConnectUnix(unixSocketPath(), "ingest");
+    ingestClient->Start();
+    ingestClient->SendIntro(
+        ConnectionIntroPayload
+        {
+            .VersionMajor = 0,
+            .VersionMinor = 0,
+            .VersionRevision = 1,
+            .RelayLayer = 0,
+            .RegionCode = "global",
+            .Hostname = "ingest",
+        });
+    auto edgeClient = ConnectNewClient("edge", true);
+
+    std::optional<ConnectionRelayPayload> recvRelayPayload;
+    std::mutex recvRelayMutex;
+    std::condition_variable recvRelayCv;
+    ingestClient->SetOnStreamRelay(
+        [&recvRelayPayload, &recvRelayMutex, &recvRelayCv](ConnectionRelayPayload relayPayload)
+        {
+            {
+                std::lock_guard<std::mutex> lock(recvRelayMutex);
+                recvRelayPayload = relayPayload;
+            }
+            recvRelayCv.notify_one();
+            return ConnectionResult
+            {
+                .IsSuccess = true
+            };
+        });
+
+    edgeClient->SendChannelSubscription(
+        ConnectionSubscriptionPayload
+        {
+            .IsSubscribe = true,
+            .ChannelId = channelId,
+            .StreamKey = streamKey,
+        });
+    ingestClient->SendStreamPublish(
+        ConnectionPublishPayload
+        {
+            .IsPublish = true,
+            .ChannelId = channelId,
+            .StreamId = streamId,
+        });
+
+    std::unique_lock<std::mutex> lock(recvRelayMutex);
+    recvRelayCv.wait_for(
+        lock,
+        WAIT_TIMEOUT,
+        [&recvRelayPayload]() { return recvRelayPayload.has_value(); });
+    REQUIRE(recvRelayPayload.has_value());
+    REQUIRE(recvRelayPayload.value().IsStartRelay == true);
+    REQUIRE(recvRelayPayload.value().TargetHostname == edgeClient->GetHostname());
+    lock.unlock();
+
+    ingestClient->Stop();
+    edgeClient->Stop();
+}
+
+/**
+ * @brief Runs the orchestration service with a Unix socket that our own user may not use
+ */
+class UnixSocketRejectionTestsFixture : public UnixSocketTestsFixture
+{
+public:
+    UnixSocketRejectionTestsFixture() :
+        UnixSocketTestsFixture(UnixConnectionManagerOptions
+            {
+                .AllowOwnUser = false,
+            })
+    { }
+};
+
+TEST_CASE_METHOD(
+    UnixSocketRejectionTestsFixture,
+    "Unix socket connections from users that aren't allowed are closed",
+    "[functional][unix]")
+{
+    std::promise<void> closedPromise;
+    auto closed = closedPromise.get_future();
+    auto client = FtlOrchestrationClient::ConnectUnix(unixSocketPath(), "ingest");
+    client->SetOnConnectionClosed([&closedPromise]() { closedPromise.set_value(); });
+    client->Start();
+    REQUIRE(closed.wait_for(WAIT_TIMEOUT) == std::future_status::ready);
+    client->Stop();
+}
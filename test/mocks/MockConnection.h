@@ -12,6 +12,8 @@
 
 #include "../../src/Stream.h" // TODO: Replace with generic structure
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <string>
 #include <tuple>
@@ -112,17 +114,53 @@ public:
         }
     }
 
+    ConnectionResult MockFireOnStateReplication(ConnectionReplicationPayload payload)
+    {
+        if (onStateReplication)
+        {
+            return onStateReplication(payload);
+        }
+        return ConnectionResult
+        {
+            .IsSuccess = false
+        };
+    }
+
+    void MockFireOnWriteStateChanged(ConnectionWriteState writeState)
+    {
+        if (onWriteStateChanged)
+        {
+            onWriteStateChanged(writeState);
+        }
+    }
+
     void SetMockOnDestructed(std::function<void(void)> onDestructed)
     {
         this->onDestructed = onDestructed;
     }
 
+    void MockSetRespondsToPings(bool respondsToPings)
+    {
+        this->respondsToPings = respondsToPings;
+    }
+
+    uint32_t MockGetPingCount()
+    {
+        return pingCount;
+    }
+
     void SetMockOnSendStreamPublish(
         std::function<void(ConnectionPublishPayload)> mockOnSendStreamPublish)
     {
         this->mockOnSendStreamPublish = mockOnSendStreamPublish;
     }
 
+    void SetMockOnSendStateReplication(
+        std::function<void(ConnectionReplicationPayload)> mockOnSendStateReplication)
+    {
+        this->mockOnSendStateReplication = mockOnSendStateReplication;
+    }
+
     // IConnection
     void Start() override
     { }
@@ -202,6 +240,23 @@ public:
         }
     }
 
+    void SendPing() override
+    {
+        ++pingCount;
+        if (respondsToPings)
+        {
+            lastActivityTime = std::chrono::steady_clock::now();
+        }
+    }
+
+    void SendStateReplication(const ConnectionReplicationPayload& payload) override
+    {
+        if (mockOnSendStateReplication)
+        {
+            mockOnSendStateReplication(payload);
+        }
+    }
+
     void SetOnConnectionClosed(std::function<void(void)> onConnectionClosed) override
     {
         this->onConnectionClosed = onConnectionClosed;
@@ -237,6 +292,16 @@ public:
         this->onStreamRelay = onStreamRelay;
     }
 
+    void SetOnStateReplication(connection_cb_replication_t onStateReplication) override
+    {
+        this->onStateReplication = onStateReplication;
+    }
+
+    void SetOnWriteStateChanged(connection_cb_write_state_t onWriteStateChanged) override
+    {
+        this->onWriteStateChanged = onWriteStateChanged;
+    }
+
     std::string GetHostname() override
     {
         return hostname;
@@ -247,6 +312,11 @@ public:
         this->hostname = hostname;
     }
 
+    std::chrono::steady_clock::time_point GetLastActivityTime() override
+    {
+        return lastActivityTime;
+    }
+
 private:
     std::function<void(void)> onConnectionClosed;
     connection_cb_intro_t onIntro;
@@ -255,12 +325,20 @@ private:
     connection_cb_subscription_t onChannelSubscription;
     connection_cb_publishing_t onStreamPublish;
     connection_cb_relay_t onStreamRelay;
+    connection_cb_replication_t onStateReplication;
+    connection_cb_write_state_t onWriteStateChanged;
     std::string hostname;
 
     // Mock callbacks
     std::function<void(void)> onDestructed;
     std::function<void(ConnectionPublishPayload)> mockOnSendStreamPublish;
+    std::function<void(ConnectionReplicationPayload)> mockOnSendStateReplication;
 
     // Mock data
     std::vector<Stream<MockConnection>> availableStreams;
+    // Pings are sent from the Orchestrator's timer thread
+    std::atomic<bool> respondsToPings { true };
+    std::atomic<uint32_t> pingCount { 0 };
+    std::atomic<std::chrono::steady_clock::time_point> lastActivityTime {
+        std::chrono::steady_clock::now() };
 };
\ No newline at end of file
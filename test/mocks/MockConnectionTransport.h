@@ -9,6 +9,7 @@
 
 #include <IConnectionTransport.h>
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
@@ -27,6 +28,26 @@ public:
         }
     }
 
+    /**
+     * @brief Sets how many bytes the transport claims are still waiting to go out
+     */
+    void MockSetPendingWriteSize(size_t pendingWriteSize)
+    {
+        this->pendingWriteSize = pendingWriteSize;
+    }
+
+    /**
+     * @brief Simulates the socket draining down to the given number of pending bytes
+     */
+    void MockFireWriteProgress(size_t pendingWriteSize)
+    {
+        this->pendingWriteSize = pendingWriteSize;
+        if (onWriteProgress)
+        {
+            onWriteProgress(pendingWriteSize);
+        }
+    }
+
     std::optional<std::vector<std::byte>> WaitForWrite(
         std::chrono::milliseconds timeout = std::chrono::milliseconds(1000))
     {
@@ -63,6 +84,16 @@ public:
         writeConditionVariable.notify_all();
     }
 
+    size_t GetPendingWriteSize() override
+    {
+        return pendingWriteSize;
+    }
+
+    void SetOnWriteProgress(std::function<void(size_t)> onWriteProgress) override
+    {
+        this->onWriteProgress = onWriteProgress;
+    }
+
     void SetOnBytesReceived(
         std::function<void(const std::vector<std::byte>&)> onBytesReceived) override
     {
@@ -78,6 +109,8 @@ private:
     std::mutex writeMutex;
     std::condition_variable writeConditionVariable;
     std::vector<std::byte> writeBuffer;
+    std::atomic<size_t> pendingWriteSize { 0 };
     std::function<void(const std::vector<std::byte>&)> onBytesReceived;
+    std::function<void(size_t)> onWriteProgress;
     std::function<void(void)> onConnectionClosed;
 };
\ No newline at end of file
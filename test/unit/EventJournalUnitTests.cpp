@@ -0,0 +1,167 @@
+/**
+ * @file EventJournalUnitTests.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include "../../src/EventJournal.h"
+
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+
+namespace
+{
+    std::string journalTestPath()
+    {
+        return "/tmp/ftl-orchestrator-journal-test-" + std::to_string(getpid());
+    }
+
+    void removeJournal(const std::string& basePath)
+    {
+        std::string prefix = (std::filesystem::path(basePath).filename().string() + ".");
+        for (const auto& entry : std::filesystem::directory_iterator("/tmp"))
+        {
+            if (entry.path().filename().string().starts_with(prefix))
+            {
+                std::filesystem::remove(entry.path());
+            }
+        }
+    }
+
+    std::vector<JournalEvent> exampleEvents()
+    {
+        return {
+            JournalEvent
+            {
+                .Type = JournalEventType::Intro,
+                .Hostname = "ingest",
+                .Node = SnapshotNode
+                {
+                    .Hostname = "ingest",
+                    .VersionMajor = 1,
+                    .RegionCode = "na-west",
+                },
+            },
+            JournalEvent
+            {
+                .Type = JournalEventType::Subscribe,
+                .Hostname = "edge",
+                .ChannelId = 1234,
+                .StreamKey = { std::byte(0xde), std::byte(0xad) },
+            },
+            JournalEvent
+            {
+                .Type = JournalEventType::Publish,
+                .Hostname = "ingest",
+                .ChannelId = 1234,
+                .StreamId = 5678,
+            },
+            JournalEvent
+            {
+                .Type = JournalEventType::RouteOpen,
+                .Hostname = "ingest",
+                .ChannelId = 1234,
+                .StreamId = 5678,
+                .TargetHostname = "edge",
+            },
+        };
+    }
+}
+
+TEST_CASE("Journaled events can be read back in order", "[journal]")
+{
+    std::string path = journalTestPath();
+    removeJournal(path);
+    std::vector<JournalEvent> events = exampleEvents();
+    {
+        EventJournal journal(path);
+        for (auto& event : events)
+        {
+            event.Sequence = journal.Append(event);
+        }
+        journal.Flush();
+        REQUIRE(EventJournal::ReadEvents(path) == events);
+    }
+    REQUIRE(events.back().Sequence == events.size());
+
+    // Only what comes after the given sequence number
+    std::vector<JournalEvent> laterEvents = EventJournal::ReadEvents(path, 2);
+    REQUIRE(laterEvents.size() == 2);
+    REQUIRE(laterEvents.front() == events.at(2));
+    removeJournal(path);
+}
+
+TEST_CASE("Rotated journal segments can be removed", "[journal]")
+{
+    std::string path = journalTestPath();
+    removeJournal(path);
+    std::vector<JournalEvent> events = exampleEvents();
+    {
+        EventJournal journal(path);
+        journal.Append(events.at(0));
+        journal.Append(events.at(1));
+        REQUIRE(journal.Rotate() == 2);
+        journal.Append(events.at(2));
+        journal.Flush();
+
+        journal.RemoveSegmentsThrough(2);
+        std::vector<JournalEvent> remaining = EventJournal::ReadEvents(path);
+        REQUIRE(remaining.size() == 1);
+        REQUIRE(remaining.at(0).Sequence == 3);
+    }
+
+    // Picking up where the last one left off
+    {
+        EventJournal journal(path, JournalFsyncPolicy::None, std::chrono::milliseconds(0), 4);
+        REQUIRE(journal.Append(events.at(3)) == 4);
+    }
+    std::vector<JournalEvent> remaining = EventJournal::ReadEvents(path);
+    REQUIRE(remaining.size() == 2);
+    REQUIRE(remaining.at(1).Sequence == 4);
+    removeJournal(path);
+}
+
+TEST_CASE("A torn journal write ends its segment", "[journal]")
+{
+    std::string path = journalTestPath();
+    removeJournal(path);
+    {
+        EventJournal journal(path);
+        for (const auto& event : exampleEvents())
+        {
+            journal.Append(event);
+        }
+    }
+    std::string segmentPath = (path + ".00000000000000000001");
+    std::filesystem::resize_file(segmentPath, (std::filesystem::file_size(segmentPath) - 3));
+    REQUIRE(EventJournal::ReadEvents(path).size() == 3);
+    removeJournal(path);
+}
+
+TEST_CASE("Replaying journaled events more than once has no further effect", "[journal]")
+{
+    StateSnapshot state;
+    for (int replay = 0; replay < 2; ++replay)
+    {
+        for (const auto& event : exampleEvents())
+        {
+            event.ApplyTo(state);
+        }
+    }
+    REQUIRE(state.Nodes.size() == 1);
+    REQUIRE(state.Streams.size() == 1);
+    REQUIRE(state.Subscriptions.size() == 1);
+    REQUIRE(state.Routes.size() == 1);
+
+    JournalEvent
+    {
+        .Type = JournalEventType::ConnectionClosed,
+        .Hostname = "ingest",
+    }.ApplyTo(state);
+    REQUIRE(state.Nodes.empty());
+    REQUIRE(state.Streams.empty());
+    REQUIRE(state.Subscriptions.size() == 1);
+    REQUIRE(state.Routes.empty());
+}
@@ -289,4 +289,192 @@ TEST_CASE("Stream publish requests are recognized", "[connection]")
     ftlConnection->Stop();
 }
 
-// TODO stream relay messages
\ No newline at end of file
+// TODO stream relay messages
+TEST_CASE("Ping requests are answered with their payload", "[connection]")
+{
+    auto mockTransport = std::make_shared<MockConnectionTransport>();
+    auto ftlConnection = std::make_shared<FtlConnection>(mockTransport);
+
+    // Start ftl connection thread
+    ftlConnection->Start();
+    auto connectedTime = ftlConnection->GetLastActivityTime();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    // Our payload value
+    uint8_t messageId = 42;
+    std::vector<std::byte> sendPayload { std::byte(0xde), std::byte(0xad) };
+
+    // Construct the message
+    std::vector<std::byte> messageBuffer = FtlConnection::SerializeMessageHeader(
+        {
+            .MessageDirection = OrchestrationMessageDirectionKind::Request,
+            .MessageFailure = false,
+            .MessageType = OrchestrationMessageType::Ping,
+            .MessageId = messageId,
+            .MessagePayloadLength = static_cast<uint16_t>(sendPayload.size()),
+        });
+    messageBuffer.insert(messageBuffer.end(), sendPayload.begin(), sendPayload.end());
+
+    // Send to the FtlConnection
+    mockTransport->MockSetReadBuffer(messageBuffer);
+
+    // Verify response, which should echo the payload without any callbacks involved
+    std::optional<std::vector<std::byte>> response = mockTransport->WaitForWrite();
+    REQUIRE(response.has_value());
+    OrchestrationMessageHeader responseHeader = FtlConnection::ParseMessageHeader(response.value());
+    REQUIRE(responseHeader.MessageDirection == OrchestrationMessageDirectionKind::Response);
+    REQUIRE(responseHeader.MessageFailure == false);
+    REQUIRE(responseHeader.MessageType == OrchestrationMessageType::Ping);
+    REQUIRE(responseHeader.MessageId == messageId);
+    REQUIRE(responseHeader.MessagePayloadLength == sendPayload.size());
+    REQUIRE(std::vector<std::byte>(response.value().begin() + 4, response.value().end()) ==
+        sendPayload);
+
+    // Receiving anything counts as activity
+    REQUIRE(ftlConnection->GetLastActivityTime() > connectedTime);
+
+    ftlConnection->Stop();
+}
+
+TEST_CASE("State replication messages are sent and recognized", "[connection]")
+{
+    auto primaryTransport = std::make_shared<MockConnectionTransport>();
+    auto primaryConnection = std::make_shared<FtlConnection>(primaryTransport);
+    auto standbyTransport = std::make_shared<MockConnectionTransport>();
+    auto standbyConnection = std::make_shared<FtlConnection>(standbyTransport);
+    primaryConnection->Start();
+    standbyConnection->Start();
+
+    std::optional<ConnectionReplicationPayload> recvPayload;
+    standbyConnection->SetOnStateReplication(
+        [&recvPayload](ConnectionReplicationPayload payload)
+        {
+            recvPayload = payload;
+
+            return ConnectionResult
+            {
+                .IsSuccess = true
+            };
+        });
+
+    // Send from one connection, and hand what it wrote to the other
+    std::vector<std::byte> sendEvents { std::byte(0x01), std::byte(0x02), std::byte(0x03) };
+    primaryConnection->SendStateReplication(ConnectionReplicationPayload
+        {
+            .IsSubscribe = false,
+            .Events = sendEvents,
+        });
+    std::optional<std::vector<std::byte>> sent = primaryTransport->WaitForWrite();
+    REQUIRE(sent.has_value());
+    OrchestrationMessageHeader sentHeader = FtlConnection::ParseMessageHeader(sent.value());
+    REQUIRE(sentHeader.MessageDirection == OrchestrationMessageDirectionKind::Request);
+    REQUIRE(sentHeader.MessageType == OrchestrationMessageType::StateReplication);
+    REQUIRE(sentHeader.MessagePayloadLength == (1 + sendEvents.size()));
+    standbyTransport->MockSetReadBuffer(sent.value());
+
+    // Verify response
+    std::optional<std::vector<std::byte>> response = standbyTransport->WaitForWrite();
+    REQUIRE(response.has_value());
+    OrchestrationMessageHeader responseHeader = FtlConnection::ParseMessageHeader(response.value());
+    REQUIRE(responseHeader.MessageDirection == OrchestrationMessageDirectionKind::Response);
+    REQUIRE(responseHeader.MessageFailure == false);
+    REQUIRE(responseHeader.MessageType == OrchestrationMessageType::StateReplication);
+    REQUIRE(responseHeader.MessageId == sentHeader.MessageId);
+
+    // Verify the FtlConnection received the expected value
+    REQUIRE(recvPayload.has_value());
+    REQUIRE(recvPayload.value().IsSubscribe == false);
+    REQUIRE(recvPayload.value().Events == sendEvents);
+
+    primaryConnection->Stop();
+    standbyConnection->Stop();
+}
+
+TEST_CASE("Messages are held back and coalesced while the peer is backed up", "[connection]")
+{
+    auto mockTransport = std::make_shared<MockConnectionTransport>();
+    auto ftlConnection = std::make_shared<FtlConnection>(
+        mockTransport,
+        "edge",
+        FtlConnectionWriteLimits
+        {
+            .HighWatermark = 100,
+            .LowWatermark = 10,
+            .MaxQueuedMessages = 3,
+        });
+    std::vector<ConnectionWriteState> writeStates;
+    ftlConnection->SetOnWriteStateChanged(
+        [&writeStates](ConnectionWriteState writeState) { writeStates.push_back(writeState); });
+    ftlConnection->Start();
+
+    auto publish = [&ftlConnection]()
+    {
+        ftlConnection->SendStreamPublish(ConnectionPublishPayload
+            {
+                .IsPublish = true,
+                .ChannelId = 1234,
+                .StreamId = 1,
+            });
+    };
+    auto relay = [&ftlConnection](bool isStart, std::string target, std::vector<std::byte> key)
+    {
+        ftlConnection->SendStreamRelay(ConnectionRelayPayload
+            {
+                .IsStartRelay = isStart,
+                .ChannelId = 1234,
+                .StreamId = 1,
+                .TargetHostname = target,
+                .StreamKey = key,
+            });
+    };
+
+    // Goes straight out, but leaves the transport past its high watermark
+    mockTransport->MockSetPendingWriteSize(100);
+    publish();
+    REQUIRE(mockTransport->WaitForWrite().has_value());
+    REQUIRE(ftlConnection->GetWriteState() == ConnectionWriteState::BackedUp);
+
+    // A restart replaces the queued start, and a stop cancels a queued start outright
+    relay(true, "edge", { std::byte(0x01) });
+    relay(true, "edge", { std::byte(0x02), std::byte(0x03) });
+    relay(true, "other", { std::byte(0x04) });
+    relay(false, "other", { });
+    publish();
+    REQUIRE(ftlConnection->GetQueuedMessageCount() == 2);
+    REQUIRE(!mockTransport->WaitForWrite(std::chrono::milliseconds(10)).has_value());
+
+    // Draining below the low watermark releases everything in order
+    mockTransport->MockFireWriteProgress(0);
+    REQUIRE(ftlConnection->GetWriteState() == ConnectionWriteState::Flowing);
+    REQUIRE(ftlConnection->GetQueuedMessageCount() == 0);
+    std::optional<std::vector<std::byte>> written = mockTransport->WaitForWrite();
+    REQUIRE(written.has_value());
+    OrchestrationMessageHeader relayHeader = FtlConnection::ParseMessageHeader(written.value());
+    REQUIRE(relayHeader.MessageType == OrchestrationMessageType::StreamRelay);
+    // Start flag, channel, stream, hostname length, "edge" and the latest two byte key
+    REQUIRE(relayHeader.MessagePayloadLength == 17);
+    auto relayEnd = (written.value().begin() + 4 + relayHeader.MessagePayloadLength);
+    REQUIRE(std::vector<std::byte>(relayEnd - 2, relayEnd) ==
+        std::vector<std::byte>{ std::byte(0x02), std::byte(0x03) });
+    OrchestrationMessageHeader publishHeader = FtlConnection::ParseMessageHeader(
+        std::vector<std::byte>(relayEnd, written.value().end()));
+    REQUIRE(publishHeader.MessageType == OrchestrationMessageType::StreamPublish);
+
+    // Holding back more than the limit gives up on the connection
+    mockTransport->MockSetPendingWriteSize(100);
+    publish();
+    REQUIRE(mockTransport->WaitForWrite().has_value());
+    for (int i = 0; i < 4; ++i)
+    {
+        publish();
+    }
+    REQUIRE(ftlConnection->GetWriteState() == ConnectionWriteState::Overflowed);
+    REQUIRE(writeStates == std::vector<ConnectionWriteState>{
+        ConnectionWriteState::BackedUp,
+        ConnectionWriteState::Flowing,
+        ConnectionWriteState::BackedUp,
+        ConnectionWriteState::Overflowed,
+    });
+
+    ftlConnection->Stop();
+}
@@ -0,0 +1,190 @@
+/**
+ * @file InProcessConnectionUnitTests.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include <InProcessConnection.h>
+#include <MpscQueue.h>
+
+#include "../../src/InProcessConnectionManager.h"
+#include "../../src/Orchestrator.h"
+
+#include <future>
+#include <thread>
+#include <vector>
+
+TEST_CASE("MpscQueue keeps each producer's values in order", "[inprocess]")
+{
+    constexpr uint32_t producerCount = 4;
+    constexpr uint32_t valuesPerProducer = 10000;
+    MpscQueue<std::pair<uint32_t, uint32_t>> queue;
+    REQUIRE(queue.TryPop() == std::nullopt);
+
+    std::vector<std::thread> producers;
+    for (uint32_t producer = 0; producer < producerCount; ++producer)
+    {
+        producers.emplace_back(
+            [&queue, producer]()
+            {
+                for (uint32_t i = 0; i < valuesPerProducer; ++i)
+                {
+                    queue.Push({ producer, i });
+                }
+            });
+    }
+
+    std::vector<uint32_t> nextExpected(producerCount, 0);
+    uint32_t popped = 0;
+    uint32_t outOfOrder = 0;
+    while (popped < (producerCount * valuesPerProducer))
+    {
+        if (auto value = queue.TryPop())
+        {
+            if (value->second != nextExpected.at(value->first))
+            {
+                ++outOfOrder;
+            }
+            nextExpected.at(value->first) = (value->second + 1);
+            ++popped;
+        }
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    REQUIRE(outOfOrder == 0);
+    REQUIRE(queue.TryPop() == std::nullopt);
+}
+
+TEST_CASE("In-process connections deliver payloads and report remote closes", "[inprocess]")
+{
+    auto [first, second] = InProcessConnection::CreatePair("first", "second");
+    REQUIRE(first->GetHostname() == "first");
+    REQUIRE(second->GetHostname() == "second");
+
+    std::vector<uint32_t> publishedChannels;
+    std::promise<ConnectionRelayPayload> relayPromise;
+    auto relay = relayPromise.get_future();
+    std::promise<void> secondClosedPromise;
+    auto secondClosed = secondClosedPromise.get_future();
+    bool isFirstCloseReported = false;
+    second->SetOnStreamPublish(
+        [&publishedChannels](ConnectionPublishPayload payload)
+        {
+            publishedChannels.push_back(payload.ChannelId);
+            return ConnectionResult { .IsSuccess = true };
+        });
+    second->SetOnStreamRelay(
+        [&relayPromise](ConnectionRelayPayload payload)
+        {
+            relayPromise.set_value(payload);
+            return ConnectionResult { .IsSuccess = true };
+        });
+    second->SetOnConnectionClosed([&secondClosedPromise]() { secondClosedPromise.set_value(); });
+    first->SetOnConnectionClosed([&isFirstCloseReported]() { isFirstCloseReported = true; });
+
+    // Messages sent before the receiving end starts wait for it
+    first->Start();
+    for (uint32_t channelId = 1; channelId <= 3; ++channelId)
+    {
+        first->SendStreamPublish(ConnectionPublishPayload
+            {
+                .IsPublish = true,
+                .ChannelId = channelId,
+                .StreamId = 10,
+            });
+    }
+    first->SendStreamRelay(ConnectionRelayPayload
+        {
+            .IsStartRelay = true,
+            .ChannelId = 3,
+            .StreamId = 10,
+            .TargetHostname = "edge",
+            .StreamKey = { std::byte(0x01), std::byte(0x02) },
+        });
+    second->Start();
+
+    REQUIRE(relay.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    auto relayPayload = relay.get();
+    REQUIRE(relayPayload.TargetHostname == "edge");
+    REQUIRE(relayPayload.StreamKey == std::vector<std::byte>{ std::byte(0x01), std::byte(0x02) });
+    REQUIRE(publishedChannels == std::vector<uint32_t>{ 1, 2, 3 });
+
+    // Stopping one end is reported to the other, but not to itself
+    first->Stop();
+    REQUIRE(secondClosed.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    REQUIRE(isFirstCloseReported == false);
+    second->Stop();
+}
+
+TEST_CASE("Embedded orchestrator routes streams over in-process connections", "[inprocess]")
+{
+    auto connectionManager = std::make_unique<InProcessConnectionManager>();
+    InProcessConnectionManager* connectionManagerPtr = connectionManager.get();
+    Orchestrator<InProcessConnection> orchestrator(std::move(connectionManager));
+    orchestrator.Init();
+    std::promise<void> readyPromise;
+    auto ready = readyPromise.get_future();
+    std::thread orchestratorThread(
+        [&orchestrator, &readyPromise]() { orchestrator.Run(std::move(readyPromise)); });
+    REQUIRE(ready.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+
+    auto ingest = connectionManagerPtr->Connect("ingest");
+    auto edge = connectionManagerPtr->Connect("edge");
+    std::promise<ConnectionRelayPayload> relayPromise;
+    auto relay = relayPromise.get_future();
+    std::promise<void> ingestClosedPromise;
+    auto ingestClosed = ingestClosedPromise.get_future();
+    ingest->SetOnStreamRelay(
+        [&relayPromise](ConnectionRelayPayload payload)
+        {
+            relayPromise.set_value(payload);
+            return ConnectionResult { .IsSuccess = true };
+        });
+    ingest->SetOnConnectionClosed([&ingestClosedPromise]() { ingestClosedPromise.set_value(); });
+    ingest->Start();
+    edge->Start();
+
+    for (const auto& node : { ingest, edge })
+    {
+        node->SendIntro(ConnectionIntroPayload
+            {
+                .VersionMajor = 0,
+                .VersionMinor = 0,
+                .VersionRevision = 0,
+                .RelayLayer = 0,
+                .RegionCode = "global",
+                .Hostname = node->GetHostname(),
+            });
+    }
+    edge->SendChannelSubscription(ConnectionSubscriptionPayload
+        {
+            .IsSubscribe = true,
+            .ChannelId = 1234,
+            .StreamKey = { std::byte(0x0a) },
+        });
+    ingest->SendStreamPublish(ConnectionPublishPayload
+        {
+            .IsPublish = true,
+            .ChannelId = 1234,
+            .StreamId = 1,
+        });
+
+    // Whichever of the subscription and publish lands first, the ingest is told to relay
+    REQUIRE(relay.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    auto relayPayload = relay.get();
+    REQUIRE(relayPayload.IsStartRelay == true);
+    REQUIRE(relayPayload.ChannelId == 1234);
+    REQUIRE(relayPayload.StreamId == 1);
+    REQUIRE(relayPayload.TargetHostname == "edge");
+    REQUIRE(relayPayload.StreamKey == std::vector<std::byte>{ std::byte(0x0a) });
+
+    // Stopping the orchestrator closes every connection
+    orchestrator.Stop();
+    orchestratorThread.join();
+    REQUIRE(ingestClosed.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    ingest->Stop();
+    edge->Stop();
+}
@@ -0,0 +1,223 @@
+/**
+ * @file IoUringTlsConnectionTransportUnitTests.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include <IoUringEventLoop.h>
+#include <IoUringTlsConnectionTransport.h>
+#include <TlsConnectionTransport.h>
+#include <TlsTransportContext.h>
+
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <sys/socket.h>
+
+namespace
+{
+    const std::vector<std::byte> TEST_PSK = {
+        std::byte(0x00), std::byte(0x01), std::byte(0x02), std::byte(0x03),
+        std::byte(0x04), std::byte(0x05), std::byte(0x06), std::byte(0x07),
+        std::byte(0x08), std::byte(0x09), std::byte(0x0a), std::byte(0x0b),
+        std::byte(0x0c), std::byte(0x0d), std::byte(0x0e), std::byte(0x0f),
+    };
+
+    /**
+     * @brief Collects bytes received from another thread so tests can wait on them
+     */
+    class ReceivedBytes
+    {
+    public:
+        void Append(const std::vector<std::byte>& bytes)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                received.insert(received.end(), bytes.begin(), bytes.end());
+            }
+            conditionVariable.notify_all();
+        }
+
+        std::vector<std::byte> WaitFor(size_t byteCount)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            conditionVariable.wait_for(
+                lock,
+                std::chrono::seconds(5),
+                [this, byteCount]() { return received.size() >= byteCount; });
+            return received;
+        }
+
+    private:
+        std::mutex mutex;
+        std::condition_variable conditionVariable;
+        std::vector<std::byte> received;
+    };
+
+    class IoUringTransportTestsFixture
+    {
+    public:
+        IoUringTransportTestsFixture() :
+            isSupported(IoUringEventLoop::IsSupported()),
+            serverContext(std::make_shared<TlsTransportContext>(
+                true /*isServer*/,
+                TEST_PSK,
+                std::chrono::milliseconds(500))),
+            clientContext(std::make_shared<TlsTransportContext>(false /*isServer*/, TEST_PSK))
+        {
+            if (isSupported)
+            {
+                eventLoop = std::make_shared<IoUringEventLoop>();
+                eventLoop->Start();
+            }
+        }
+
+        ~IoUringTransportTestsFixture()
+        {
+            if (eventLoop)
+            {
+                eventLoop->Stop();
+            }
+        }
+
+        /**
+         * @brief Creates an io_uring server transport on one end of a new socket pair,
+         *  returning it and the other end's handle
+         */
+        std::pair<std::shared_ptr<IoUringTlsConnectionTransport>, int> NewServer()
+        {
+            int socketHandles[2];
+            REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, socketHandles) == 0);
+            auto server = std::make_shared<IoUringTlsConnectionTransport>(
+                eventLoop,
+                serverContext,
+                socketHandles[0],
+                sockaddr_in { 0 });
+            return { server, socketHandles[1] };
+        }
+
+    protected:
+        const bool isSupported;
+        std::shared_ptr<TlsTransportContext> serverContext;
+        std::shared_ptr<TlsTransportContext> clientContext;
+        std::shared_ptr<IoUringEventLoop> eventLoop;
+    };
+}
+
+TEST_CASE_METHOD(
+    IoUringTransportTestsFixture,
+    "io_uring transport exchanges data with a poll transport peer",
+    "[io_uring]")
+{
+    if (!isSupported)
+    {
+        WARN("io_uring is not supported on this kernel, skipping");
+        return;
+    }
+
+    auto [server, clientHandle] = NewServer();
+    auto client = std::make_shared<TlsConnectionTransport>(
+        clientContext,
+        clientHandle,
+        sockaddr_in { 0 });
+
+    ReceivedBytes serverReceived;
+    ReceivedBytes clientReceived;
+    std::promise<bool> handshakePromise;
+    auto handshake = handshakePromise.get_future();
+    std::promise<void> serverClosedPromise;
+    auto serverClosed = serverClosedPromise.get_future();
+    server->SetOnBytesReceived(
+        [&serverReceived](const std::vector<std::byte>& bytes) { serverReceived.Append(bytes); });
+    server->SetOnHandshakeComplete(
+        [&handshakePromise](bool isSuccess) { handshakePromise.set_value(isSuccess); });
+    server->SetOnConnectionClosed([&serverClosedPromise]() { serverClosedPromise.set_value(); });
+    client->SetOnBytesReceived(
+        [&clientReceived](const std::vector<std::byte>& bytes) { clientReceived.Append(bytes); });
+
+    server->StartAsync();
+    client->StartAsync();
+    REQUIRE(handshake.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    REQUIRE(handshake.get() == true);
+
+    // Writes larger than one receive buffer have to be reassembled from several completions
+    std::vector<std::byte> serverPayload(256 * 1024);
+    for (size_t i = 0; i < serverPayload.size(); ++i)
+    {
+        serverPayload[i] = std::byte(i % 251);
+    }
+    server->Write(serverPayload);
+    client->Write({ std::byte(0x01), std::byte(0x02) });
+    client->Write({ std::byte(0x03) });
+
+    REQUIRE(serverReceived.WaitFor(3) ==
+        std::vector<std::byte>{ std::byte(0x01), std::byte(0x02), std::byte(0x03) });
+    REQUIRE(clientReceived.WaitFor(serverPayload.size()) == serverPayload);
+
+    // The peer going away is reported as a close
+    client->Stop();
+    REQUIRE(serverClosed.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    server->Stop();
+}
+
+TEST_CASE_METHOD(
+    IoUringTransportTestsFixture,
+    "io_uring transport closes connections that stall during the handshake",
+    "[io_uring]")
+{
+    if (!isSupported)
+    {
+        WARN("io_uring is not supported on this kernel, skipping");
+        return;
+    }
+
+    auto [server, peerHandle] = NewServer();
+    std::promise<bool> handshakePromise;
+    auto handshake = handshakePromise.get_future();
+    std::promise<void> serverClosedPromise;
+    auto serverClosed = serverClosedPromise.get_future();
+    server->SetOnHandshakeComplete(
+        [&handshakePromise](bool isSuccess) { handshakePromise.set_value(isSuccess); });
+    server->SetOnConnectionClosed([&serverClosedPromise]() { serverClosedPromise.set_value(); });
+    server->StartAsync();
+
+    // The peer never says anything
+    REQUIRE(handshake.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    REQUIRE(handshake.get() == false);
+    REQUIRE(serverClosed.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    char buffer;
+    REQUIRE(recv(peerHandle, &buffer, sizeof(buffer), 0) == 0);
+    close(peerHandle);
+    server->Stop();
+}
+
+TEST_CASE_METHOD(
+    IoUringTransportTestsFixture,
+    "io_uring transport stopped locally closes the socket without a close callback",
+    "[io_uring]")
+{
+    if (!isSupported)
+    {
+        WARN("io_uring is not supported on this kernel, skipping");
+        return;
+    }
+
+    auto [server, clientHandle] = NewServer();
+    auto client = std::make_shared<TlsConnectionTransport>(
+        clientContext,
+        clientHandle,
+        sockaddr_in { 0 });
+    bool isServerCloseReported = false;
+    std::promise<void> clientClosedPromise;
+    auto clientClosed = clientClosedPromise.get_future();
+    server->SetOnConnectionClosed([&isServerCloseReported]() { isServerCloseReported = true; });
+    client->SetOnConnectionClosed([&clientClosedPromise]() { clientClosedPromise.set_value(); });
+    server->StartAsync();
+    client->StartAsync();
+
+    server->Stop();
+    REQUIRE(clientClosed.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    REQUIRE(isServerCloseReported == false);
+    client->Stop();
+}
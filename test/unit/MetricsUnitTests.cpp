@@ -0,0 +1,84 @@
+/**
+ * @file MetricsUnitTests.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include <Metrics.h>
+
+#include <thread>
+#include <vector>
+
+TEST_CASE("Counters sum increments from many threads", "[metrics]")
+{
+    MetricCounter counter;
+    const int numThreads = 8;
+    const int incrementsPerThread = 10000;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numThreads; ++i)
+    {
+        threads.emplace_back(
+            [&counter]()
+            {
+                for (int j = 0; j < incrementsPerThread; ++j)
+                {
+                    counter.Increment();
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    REQUIRE(counter.GetValue() == (numThreads * incrementsPerThread));
+}
+
+TEST_CASE("Histograms bound quantile error", "[metrics]")
+{
+    MetricHistogram histogram;
+    for (uint64_t i = 1; i <= 1000; ++i)
+    {
+        histogram.Record(i);
+    }
+    REQUIRE(histogram.GetCount() == 1000);
+    REQUIRE(histogram.GetSum() == 500500);
+
+    // With four sub-buckets per power of two, estimates are within 25% above the true value
+    uint64_t p50 = histogram.GetQuantile(0.5);
+    REQUIRE(p50 >= 500);
+    REQUIRE(p50 <= 625);
+    uint64_t p99 = histogram.GetQuantile(0.99);
+    REQUIRE(p99 >= 990);
+    REQUIRE(p99 <= 1238);
+
+    // Small values are tracked exactly
+    MetricHistogram smallHistogram;
+    smallHistogram.Record(0);
+    smallHistogram.Record(3);
+    REQUIRE(smallHistogram.GetQuantile(0.0) == 0);
+    REQUIRE(smallHistogram.GetQuantile(0.99) == 3);
+}
+
+TEST_CASE("Registry renders Prometheus text format", "[metrics]")
+{
+    MetricsRegistry registry;
+    registry.GetCounter("test_requests_total", "Requests", "type=\"a\"").Increment(3);
+    registry.GetCounter("test_requests_total", "Requests", "type=\"b\"").Increment();
+    registry.GetHistogram("test_latency_seconds", "Latency", std::string(), 1e-9).Record(1000);
+    std::string output;
+    {
+        auto gauge = registry.AddGauge("test_queue_depth", "Depth", []() { return 7.0; });
+        output = registry.Serialize();
+        REQUIRE(output.find("test_queue_depth 7\n") != std::string::npos);
+    }
+    REQUIRE(output.find("# TYPE test_requests_total counter\n") != std::string::npos);
+    REQUIRE(output.find("test_requests_total{type=\"a\"} 3\n") != std::string::npos);
+    REQUIRE(output.find("test_requests_total{type=\"b\"} 1\n") != std::string::npos);
+    REQUIRE(output.find("# TYPE test_latency_seconds histogram\n") != std::string::npos);
+    REQUIRE(output.find("test_latency_seconds_bucket{le=\"+Inf\"} 1\n") != std::string::npos);
+    REQUIRE(output.find("test_latency_seconds_count 1\n") != std::string::npos);
+
+    // Gauges disappear once their handle is released
+    REQUIRE(registry.Serialize().find("test_queue_depth") == std::string::npos);
+}
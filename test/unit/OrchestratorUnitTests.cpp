@@ -7,8 +7,16 @@
  */
 
 #include <array>
+#include <condition_variable>
+#include <cstdio>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <sstream>
+#include <thread>
+#include <unistd.h>
 #include <vector>
 
 #include "../mocks/MockConnectionManager.h"
@@ -34,10 +42,11 @@ protected:
     /**
      * @brief Initializes an Orchestrator and associated ConnectionManager
      */
-    void init()
+    void init(OrchestratorOptions options = OrchestratorOptions())
     {
         orchestrator = std::make_unique<Orchestrator<MockConnection>>(
-            std::make_unique<MockConnectionManager<MockConnection>>());
+            std::make_unique<MockConnectionManager<MockConnection>>(),
+            options);
         orchestrator->Init();
     }
 
@@ -351,4 +360,531 @@ TEST_CASE_METHOD(
     recvRelayPayloads.clear();
 }
 
+TEST_CASE_METHOD(
+    OrchestratorUnitTestsFixture,
+    "Orchestrator stops relays to all subscribers when a stream is unpublished",
+    "[orchestrator]")
+{
+    init();
+
+    ftl_channel_id_t channelId = 1234;
+    ftl_stream_id_t streamId = 5678;
+
+    // Connect the edge nodes and have them subscribe to updates for this channel
+    const size_t numEdgeConnections = 3;
+    auto edgeConnections = generateAndConnectMockConnections("edge", numEdgeConnections);
+    for (const auto& connection : edgeConnections)
+    {
+        connection->MockFireOnChannelSubscription(
+            {
+                .IsSubscribe = true,
+                .ChannelId = channelId,
+                .StreamKey = std::vector<std::byte>(),
+            });
+    }
+
+    // Connect the ingest and have it publish the stream
+    auto ingest = generateAndConnectMockConnection("ingest");
+    std::vector<ConnectionRelayPayload> recvRelayPayloads;
+    ingest->SetOnStreamRelay(
+        [&recvRelayPayloads](ConnectionRelayPayload payload)
+        {
+            recvRelayPayloads.push_back(payload);
+            return ConnectionResult
+            {
+                .IsSuccess = true
+            };
+        });
+    ingest->MockFireOnStreamPublish(
+        {
+            .IsPublish = true,
+            .ChannelId = channelId,
+            .StreamId = streamId,
+        });
+    REQUIRE(recvRelayPayloads.size() == numEdgeConnections);
+    recvRelayPayloads.clear();
+
+    // Unpublish the stream and make sure every route is torn down
+    ingest->MockFireOnStreamPublish(
+        {
+            .IsPublish = false,
+            .ChannelId = channelId,
+            .StreamId = streamId,
+        });
+    REQUIRE(recvRelayPayloads.size() == numEdgeConnections);
+    for (const auto& connection : edgeConnections)
+    {
+        bool connectionRelayStopped = std::any_of(
+            recvRelayPayloads.begin(),
+            recvRelayPayloads.end(),
+            [&connection, &channelId, &streamId](ConnectionRelayPayload payload)
+            {
+                return (!payload.IsStartRelay) &&
+                    (payload.TargetHostname == connection->GetHostname()) &&
+                    (payload.ChannelId == channelId) &&
+                    (payload.StreamId == streamId);
+            });
+        REQUIRE(connectionRelayStopped == true);
+    }
+    recvRelayPayloads.clear();
+
+    // Subscriptions should survive the unpublish, so a new stream is routed right away
+    ingest->MockFireOnStreamPublish(
+        {
+            .IsPublish = true,
+            .ChannelId = channelId,
+            .StreamId = (streamId + 1),
+        });
+    REQUIRE(recvRelayPayloads.size() == numEdgeConnections);
+    for (const auto& payload : recvRelayPayloads)
+    {
+        REQUIRE(payload.IsStartRelay == true);
+        REQUIRE(payload.StreamId == (streamId + 1));
+    }
+}
+
+TEST_CASE_METHOD(
+    OrchestratorUnitTestsFixture,
+    "Orchestrator closes connections that stop answering heartbeats",
+    "[orchestrator]")
+{
+    init(OrchestratorOptions
+        {
+            .HeartbeatInterval = std::chrono::milliseconds(20),
+            .HeartbeatMissThreshold = 3,
+        });
+
+    ftl_channel_id_t channelId = 1234;
+    ftl_stream_id_t streamId = 5678;
+
+    // Route a stream from a healthy ingest to an edge that is about to go silent
+    auto edge = generateAndConnectMockConnection("edge");
+    edge->MockFireOnChannelSubscription(
+        {
+            .IsSubscribe = true,
+            .ChannelId = channelId,
+            .StreamKey = std::vector<std::byte>(),
+        });
+    auto ingest = generateAndConnectMockConnection("ingest");
+    std::promise<ConnectionRelayPayload> stopRelayPromise;
+    auto stopRelay = stopRelayPromise.get_future();
+    ingest->SetOnStreamRelay(
+        [&stopRelayPromise](ConnectionRelayPayload payload)
+        {
+            if (!payload.IsStartRelay)
+            {
+                stopRelayPromise.set_value(payload);
+            }
+            return ConnectionResult
+            {
+                .IsSuccess = true
+            };
+        });
+    edge->MockSetRespondsToPings(false);
+    ingest->MockFireOnStreamPublish(
+        {
+            .IsPublish = true,
+            .ChannelId = channelId,
+            .StreamId = streamId,
+        });
+
+    // The ingest is told to stop relaying once the edge misses enough heartbeats
+    REQUIRE(stopRelay.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    REQUIRE((std::chrono::steady_clock::now() - edge->GetLastActivityTime()) >=
+        std::chrono::milliseconds(60));
+    REQUIRE(stopRelay.get().TargetHostname == edge->GetHostname());
+    REQUIRE(edge->MockGetPingCount() > 0);
+    REQUIRE(orchestrator->GetConnections().count(edge) == 0);
+
+    // The ingest kept answering, so it stays connected
+    REQUIRE(ingest->MockGetPingCount() > 0);
+    REQUIRE(orchestrator->GetConnections().count(ingest) == 1);
+}
+
+TEST_CASE_METHOD(
+    OrchestratorUnitTestsFixture,
+    "Orchestrator closes connections that fall too far behind",
+    "[orchestrator]")
+{
+    init();
+
+    ftl_channel_id_t channelId = 1234;
+    ftl_stream_id_t streamId = 5678;
+
+    auto edge = generateAndConnectMockConnection("edge");
+    edge->MockFireOnChannelSubscription(
+        {
+            .IsSubscribe = true,
+            .ChannelId = channelId,
+            .StreamKey = std::vector<std::byte>(),
+        });
+    auto ingest = generateAndConnectMockConnection("ingest");
+    std::promise<ConnectionRelayPayload> stopRelayPromise;
+    auto stopRelay = stopRelayPromise.get_future();
+    ingest->SetOnStreamRelay(
+        [&stopRelayPromise](ConnectionRelayPayload payload)
+        {
+            if (!payload.IsStartRelay)
+            {
+                stopRelayPromise.set_value(payload);
+            }
+            return ConnectionResult
+            {
+                .IsSuccess = true
+            };
+        });
+    ingest->MockFireOnStreamPublish(
+        {
+            .IsPublish = true,
+            .ChannelId = channelId,
+            .StreamId = streamId,
+        });
+
+    // Backing up on its own doesn't cost the edge its connection
+    edge->MockFireOnWriteStateChanged(ConnectionWriteState::BackedUp);
+    edge->MockFireOnWriteStateChanged(ConnectionWriteState::Flowing);
+    REQUIRE(orchestrator->GetConnections().count(edge) == 1);
+
+    // Overflowing does, and its routes are torn down
+    edge->MockFireOnWriteStateChanged(ConnectionWriteState::BackedUp);
+    edge->MockFireOnWriteStateChanged(ConnectionWriteState::Overflowed);
+    REQUIRE(stopRelay.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    REQUIRE(stopRelay.get().TargetHostname == edge->GetHostname());
+    REQUIRE(orchestrator->GetConnections().count(edge) == 0);
+    REQUIRE(orchestrator->GetConnections().count(ingest) == 1);
+}
+
+TEST_CASE_METHOD(
+    OrchestratorUnitTestsFixture,
+    "Orchestrator coalesces relay commands within the batching window",
+    "[orchestrator]")
+{
+    init(OrchestratorOptions
+        {
+            .RelayBatchWindow = std::chrono::milliseconds(50),
+        });
+
+    ftl_channel_id_t channelId = 1234;
+    ftl_stream_id_t streamId = 5678;
+
+    auto ingest = generateAndConnectMockConnection("ingest");
+    std::mutex relaysMutex;
+    std::vector<ConnectionRelayPayload> relays;
+    std::promise<void> firstRelayPromise;
+    auto firstRelay = firstRelayPromise.get_future();
+    ingest->SetOnStreamRelay(
+        [&relaysMutex, &relays, &firstRelayPromise](ConnectionRelayPayload payload)
+        {
+            std::lock_guard<std::mutex> lock(relaysMutex);
+            relays.push_back(payload);
+            if (relays.size() == 1)
+            {
+                firstRelayPromise.set_value();
+            }
+            return ConnectionResult
+            {
+                .IsSuccess = true
+            };
+        });
+    ingest->MockFireOnStreamPublish(
+        {
+            .IsPublish = true,
+            .ChannelId = channelId,
+            .StreamId = streamId,
+        });
+
+    // One edge flaps and ends up subscribed, the other flaps and ends up unsubscribed
+    auto edges = generateAndConnectMockConnections("edge", 2);
+    for (int i = 0; i < 3; ++i)
+    {
+        for (const auto& edge : edges)
+        {
+            edge->MockFireOnChannelSubscription(
+                {
+                    .IsSubscribe = true,
+                    .ChannelId = channelId,
+                    .StreamKey = std::vector<std::byte>(),
+                });
+            edge->MockFireOnChannelSubscription(
+                {
+                    .IsSubscribe = false,
+                    .ChannelId = channelId,
+                    .StreamKey = std::vector<std::byte>(),
+                });
+        }
+    }
+    edges.at(0)->MockFireOnChannelSubscription(
+        {
+            .IsSubscribe = true,
+            .ChannelId = channelId,
+            .StreamKey = std::vector<std::byte>(),
+        });
+
+    // Only the net change reaches the ingest, once the window has passed
+    REQUIRE(firstRelay.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::lock_guard<std::mutex> lock(relaysMutex);
+    REQUIRE(relays.size() == 1);
+    REQUIRE(relays.at(0).IsStartRelay == true);
+    REQUIRE(relays.at(0).TargetHostname == edges.at(0)->GetHostname());
+}
+
+TEST_CASE_METHOD(
+    OrchestratorUnitTestsFixture,
+    "Orchestrator keeps routes open for a while after the last unsubscribe",
+    "[orchestrator]")
+{
+    ftl_channel_id_t lingeringChannelId = 1234;
+    ftl_channel_id_t channelId = 4321;
+    init(OrchestratorOptions
+        {
+            .RouteLinger = std::chrono::milliseconds(0),
+            .ChannelRouteLinger = { { lingeringChannelId, std::chrono::milliseconds(100) } },
+        });
+
+    auto ingest = generateAndConnectMockConnection("ingest");
+    std::mutex relaysMutex;
+    std::condition_variable relaysConditionVariable;
+    std::vector<ConnectionRelayPayload> relays;
+    ingest->SetOnStreamRelay(
+        [&relaysMutex, &relaysConditionVariable, &relays](ConnectionRelayPayload payload)
+        {
+            {
+                std::lock_guard<std::mutex> lock(relaysMutex);
+                relays.push_back(payload);
+            }
+            relaysConditionVariable.notify_all();
+            return ConnectionResult
+            {
+                .IsSuccess = true
+            };
+        });
+    auto waitForRelays = [&relaysMutex, &relaysConditionVariable, &relays](size_t count)
+    {
+        std::unique_lock<std::mutex> lock(relaysMutex);
+        relaysConditionVariable.wait_for(
+            lock,
+            std::chrono::seconds(5),
+            [&relays, count]() { return relays.size() >= count; });
+        return relays;
+    };
+    auto edge = generateAndConnectMockConnection("edge");
+    auto setSubscribed = [&edge](ftl_channel_id_t channelId, bool isSubscribe)
+    {
+        edge->MockFireOnChannelSubscription(
+            {
+                .IsSubscribe = isSubscribe,
+                .ChannelId = channelId,
+                .StreamKey = std::vector<std::byte>(),
+            });
+    };
+    setSubscribed(lingeringChannelId, true);
+    setSubscribed(channelId, true);
+    for (auto publishChannelId : { lingeringChannelId, channelId })
+    {
+        ingest->MockFireOnStreamPublish(
+            {
+                .IsPublish = true,
+                .ChannelId = publishChannelId,
+                .StreamId = 1,
+            });
+    }
+    REQUIRE(waitForRelays(2).size() == 2);
+
+    // Without a linger, the route is closed straight away
+    setSubscribed(channelId, false);
+    REQUIRE(relays.size() == 3);
+    REQUIRE(relays.at(2).IsStartRelay == false);
+    REQUIRE(relays.at(2).ChannelId == channelId);
+
+    // A quick resubscribe reuses the lingering route without the ingest hearing about it
+    setSubscribed(lingeringChannelId, false);
+    setSubscribed(lingeringChannelId, true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    REQUIRE(waitForRelays(3).size() == 3);
+
+    // Left alone, it's closed once the linger runs out
+    auto unsubscribedTime = std::chrono::steady_clock::now();
+    setSubscribed(lingeringChannelId, false);
+    auto lingeredRelays = waitForRelays(4);
+    REQUIRE(lingeredRelays.size() == 4);
+    REQUIRE((std::chrono::steady_clock::now() - unsubscribedTime) >=
+        std::chrono::milliseconds(100));
+    REQUIRE(lingeredRelays.at(3).IsStartRelay == false);
+    REQUIRE(lingeredRelays.at(3).ChannelId == lingeringChannelId);
+    REQUIRE(lingeredRelays.at(3).TargetHostname == edge->GetHostname());
+}
+
+TEST_CASE_METHOD(
+    OrchestratorUnitTestsFixture,
+    "Orchestrator restores state from a snapshot without rebuilding routes",
+    "[orchestrator]")
+{
+    std::string snapshotPath =
+        "/tmp/ftl-orchestrator-test-" + std::to_string(getpid()) + ".snapshot";
+    std::remove(snapshotPath.c_str());
+    OrchestratorOptions options
+    {
+        .SnapshotPath = snapshotPath,
+        .SnapshotReconcileTimeout = std::chrono::milliseconds(100),
+    };
+    ftl_channel_id_t channelId = 1234;
+    ftl_stream_id_t streamId = 5678;
+    ConnectionSubscriptionPayload subscription
+    {
+        .IsSubscribe = true,
+        .ChannelId = channelId,
+        .StreamKey = { std::byte(0x0a) },
+    };
+    ConnectionPublishPayload publish
+    {
+        .IsPublish = true,
+        .ChannelId = channelId,
+        .StreamId = streamId,
+    };
+
+    // Route a stream to two edges, then shut down
+    init(options);
+    auto edges = generateAndConnectMockConnections("edge", 2);
+    for (const auto& edge : edges)
+    {
+        edge->MockFireOnChannelSubscription(subscription);
+    }
+    auto ingest = generateAndConnectMockConnection("ingest");
+    ingest->SetOnStreamRelay(
+        [](ConnectionRelayPayload)
+        {
+            return ConnectionResult
+            {
+                .IsSuccess = true
+            };
+        });
+    ingest->MockFireOnStreamPublish(publish);
+    orchestrator->Stop();
+
+    // Start again; the ingest and one edge come back, re-announcing what they had
+    init(options);
+    std::mutex relaysMutex;
+    std::vector<ConnectionRelayPayload> relays;
+    std::promise<void> relayPromise;
+    auto relay = relayPromise.get_future();
+    auto restartedIngest = generateAndConnectMockConnection("ingest");
+    restartedIngest->SetOnStreamRelay(
+        [&relaysMutex, &relays, &relayPromise](ConnectionRelayPayload payload)
+        {
+            std::lock_guard<std::mutex> lock(relaysMutex);
+            relays.push_back(payload);
+            relayPromise.set_value();
+            return ConnectionResult
+            {
+                .IsSuccess = true
+            };
+        });
+    auto restartedEdge = generateAndConnectMockConnection("edge-0");
+    REQUIRE(orchestrator->GetSubscribedChannels(restartedEdge) ==
+        std::set<ftl_channel_id_t>{ channelId });
+    restartedEdge->MockFireOnChannelSubscription(subscription);
+    restartedIngest->MockFireOnStreamPublish(publish);
+    REQUIRE(orchestrator->GetSubscribedChannels(restartedEdge).size() == 1);
+
+    // The ingest is left relaying to the edge that came back, and only hears about the one
+    // that didn't once the reconcile timeout passes
+    REQUIRE(relay.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    std::lock_guard<std::mutex> lock(relaysMutex);
+    REQUIRE(relays.size() == 1);
+    REQUIRE(relays.at(0).IsStartRelay == false);
+    REQUIRE(relays.at(0).TargetHostname == "edge-1");
+    REQUIRE(relays.at(0).StreamId == streamId);
+    std::remove(snapshotPath.c_str());
+}
+
+TEST_CASE_METHOD(
+    OrchestratorUnitTestsFixture,
+    "Orchestrator replays its journal on top of the last snapshot after a crash",
+    "[orchestrator]")
+{
+    std::string statePath = "/tmp/ftl-orchestrator-test-" + std::to_string(getpid());
+    std::string snapshotPath = (statePath + ".snapshot");
+    std::string journalPath = (statePath + ".journal");
+    std::remove(snapshotPath.c_str());
+    OrchestratorOptions options
+    {
+        .SnapshotPath = snapshotPath,
+        .SnapshotReconcileTimeout = std::chrono::seconds(30),
+        .JournalPath = journalPath,
+    };
+    ftl_channel_id_t channelId = 1234;
+    ftl_stream_id_t streamId = 5678;
+    ConnectionSubscriptionPayload subscription
+    {
+        .IsSubscribe = true,
+        .ChannelId = channelId,
+        .StreamKey = { std::byte(0x0a) },
+    };
+
+    // Route a stream to two edges and take a snapshot
+    init(options);
+    auto edges = generateAndConnectMockConnections("edge", 2);
+    for (const auto& edge : edges)
+    {
+        edge->MockFireOnChannelSubscription(subscription);
+    }
+    auto ingest = generateAndConnectMockConnection("ingest");
+    ingest->SetOnStreamRelay(
+        [](ConnectionRelayPayload)
+        {
+            return ConnectionResult
+            {
+                .IsSuccess = true
+            };
+        });
+    ingest->MockFireOnStreamPublish(
+        {
+            .IsPublish = true,
+            .ChannelId = channelId,
+            .StreamId = streamId,
+        });
+    REQUIRE(orchestrator->WriteSnapshot());
+
+    // Then carry on without snapshotting again: one edge leaves, another arrives
+    edges.at(1)->MockFireOnChannelSubscription(
+        {
+            .IsSubscribe = false,
+            .ChannelId = channelId,
+        });
+    auto lateEdge = generateAndConnectMockConnection("edge-late");
+    lateEdge->MockFireOnChannelSubscription(subscription);
+
+    // Crash, and start again before anyone reconnects
+    init(options);
+    REQUIRE(orchestrator->WriteSnapshot());
+    std::optional<StateSnapshot> restored = StateSnapshot::ReadFromFile(snapshotPath);
+    REQUIRE(restored.has_value());
+    REQUIRE(restored->Nodes.size() == 4);
+    REQUIRE(restored->Streams == std::vector<SnapshotStream>
+        {
+            {
+                .IngestHostname = "ingest",
+                .ChannelId = channelId,
+                .StreamId = streamId,
+            },
+        });
+    std::set<std::string> subscribedEdges;
+    for (const auto& restoredSubscription : restored->Subscriptions)
+    {
+        subscribedEdges.insert(restoredSubscription.EdgeHostname);
+    }
+    REQUIRE(subscribedEdges == std::set<std::string> { "edge-0", "edge-late" });
+    std::set<std::string> routedEdges;
+    for (const auto& route : restored->Routes)
+    {
+        routedEdges.insert(route.TargetHostname);
+    }
+    REQUIRE(routedEdges == std::set<std::string> { "edge-0", "edge-late" });
+
+    // The snapshot covers the whole journal, so nothing is left to replay
+    REQUIRE(EventJournal::ReadEvents(journalPath).empty());
+    std::remove(snapshotPath.c_str());
+}
+
 // TODO: Test cases to cover orchestrator/routing logic
\ No newline at end of file
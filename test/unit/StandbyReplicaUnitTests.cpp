@@ -0,0 +1,158 @@
+/**
+ * @file StandbyReplicaUnitTests.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include <InProcessConnection.h>
+
+#include "../../src/InProcessConnectionManager.h"
+#include "../../src/Orchestrator.h"
+#include "../../src/StandbyReplica.h"
+#include "../mocks/MockConnection.h"
+#include "../mocks/MockConnectionManager.h"
+
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    void introduce(const std::shared_ptr<InProcessConnection>& node)
+    {
+        node->SendIntro(ConnectionIntroPayload
+            {
+                .VersionMajor = 0,
+                .VersionMinor = 0,
+                .VersionRevision = 1,
+                .RelayLayer = 0,
+                .RegionCode = "global",
+                .Hostname = node->GetHostname(),
+            });
+    }
+}
+
+TEST_CASE("Standby replicates the primary's state and takes over with it", "[standby]")
+{
+    auto connectionManager = std::make_unique<InProcessConnectionManager>();
+    InProcessConnectionManager* connectionManagerPtr = connectionManager.get();
+    Orchestrator<InProcessConnection> primary(std::move(connectionManager));
+    primary.Init();
+    std::promise<void> readyPromise;
+    auto ready = readyPromise.get_future();
+    std::thread primaryThread(
+        [&primary, &readyPromise]() { primary.Run(std::move(readyPromise)); });
+    REQUIRE(ready.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+
+    // One node is around before the standby, so it arrives with the initial copy of the state
+    auto edge = connectionManagerPtr->Connect("edge");
+    edge->Start();
+    introduce(edge);
+    edge->SendChannelSubscription(ConnectionSubscriptionPayload
+        {
+            .IsSubscribe = true,
+            .ChannelId = 1234,
+            .StreamKey = { std::byte(0x0a) },
+        });
+
+    StandbyReplica<InProcessConnection> standby(
+        [connectionManagerPtr]() { return connectionManagerPtr->Connect("standby"); },
+        StandbyReplicaOptions
+        {
+            .HeartbeatInterval = std::chrono::milliseconds(100),
+        });
+    auto failover = std::async(std::launch::async, [&standby]() { return standby.WaitForFailover(); });
+
+    // ...and the other afterwards, so it's streamed as a change
+    std::promise<void> relayPromise;
+    auto relay = relayPromise.get_future();
+    auto ingest = connectionManagerPtr->Connect("ingest");
+    ingest->SetOnStreamRelay(
+        [&relayPromise](ConnectionRelayPayload)
+        {
+            relayPromise.set_value();
+            return ConnectionResult { .IsSuccess = true };
+        });
+    ingest->Start();
+    introduce(ingest);
+    ingest->SendStreamPublish(ConnectionPublishPayload
+        {
+            .IsPublish = true,
+            .ChannelId = 1234,
+            .StreamId = 5678,
+        });
+    REQUIRE(relay.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+
+    auto deadline = (std::chrono::steady_clock::now() + std::chrono::seconds(5));
+    while (standby.GetState().Routes.empty() && (std::chrono::steady_clock::now() < deadline))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // Losing the primary hands over everything it knew
+    primary.Stop();
+    primaryThread.join();
+    REQUIRE(failover.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    StateSnapshot state = failover.get();
+    REQUIRE(state.Nodes.size() == 2);
+    REQUIRE(state.Streams == std::vector<SnapshotStream>
+        {
+            {
+                .IngestHostname = "ingest",
+                .ChannelId = 1234,
+                .StreamId = 5678,
+            },
+        });
+    REQUIRE(state.Subscriptions == std::vector<SnapshotSubscription>
+        {
+            {
+                .EdgeHostname = "edge",
+                .ChannelId = 1234,
+                .StreamKey = { std::byte(0x0a) },
+            },
+        });
+    REQUIRE(state.Routes == std::vector<SnapshotRoute>
+        {
+            {
+                .ChannelId = 1234,
+                .StreamId = 5678,
+                .IngestHostname = "ingest",
+                .TargetHostname = "edge",
+            },
+        });
+    ingest->Stop();
+    edge->Stop();
+
+    // The standby takes over without restarting the relay when the nodes reconnect
+    auto standbyConnectionManager = std::make_unique<MockConnectionManager<MockConnection>>();
+    auto standbyConnectionManagerPtr = standbyConnectionManager.get();
+    Orchestrator<MockConnection> takeover(std::move(standbyConnectionManager));
+    takeover.Init();
+    takeover.RestoreState(std::move(state));
+    bool isRelaySent = false;
+    auto reconnectedIngest = std::make_shared<MockConnection>("ingest");
+    reconnectedIngest->SetOnStreamRelay(
+        [&isRelaySent](ConnectionRelayPayload)
+        {
+            isRelaySent = true;
+            return ConnectionResult { .IsSuccess = true };
+        });
+    auto reconnectedEdge = std::make_shared<MockConnection>("edge");
+    for (const auto& node : { reconnectedIngest, reconnectedEdge })
+    {
+        standbyConnectionManagerPtr->MockFireNewConnection(node);
+        node->MockFireOnIntro(
+            {
+                .VersionMajor = 0,
+                .VersionMinor = 0,
+                .VersionRevision = 1,
+                .RelayLayer = 0,
+                .RegionCode = "global",
+                .Hostname = node->GetHostname(),
+            });
+    }
+    REQUIRE(takeover.GetSubscribedChannels(reconnectedEdge) ==
+        std::set<ftl_channel_id_t>{ 1234 });
+    REQUIRE(isRelaySent == false);
+}
@@ -0,0 +1,105 @@
+/**
+ * @file StateSnapshotUnitTests.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include "../../src/StateSnapshot.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+namespace
+{
+    std::string snapshotTestPath()
+    {
+        return "/tmp/ftl-orchestrator-snapshot-test-" + std::to_string(getpid()) + ".bin";
+    }
+
+    StateSnapshot exampleSnapshot()
+    {
+        StateSnapshot snapshot;
+        snapshot.WrittenAt = std::chrono::system_clock::time_point(
+            std::chrono::milliseconds(1790000000000));
+        snapshot.Nodes.push_back(SnapshotNode
+            {
+                .Hostname = "ingest",
+                .VersionMajor = 1,
+                .VersionMinor = 2,
+                .VersionRevision = 3,
+                .RelayLayer = 0,
+                .RegionCode = "na-west",
+                .CurrentLoad = 10,
+                .MaximumLoad = 100,
+            });
+        snapshot.Streams.push_back(SnapshotStream
+            {
+                .IngestHostname = "ingest",
+                .ChannelId = 1234,
+                .StreamId = 5678,
+            });
+        snapshot.Subscriptions.push_back(SnapshotSubscription
+            {
+                .EdgeHostname = "edge",
+                .ChannelId = 1234,
+                .StreamKey = { std::byte(0xde), std::byte(0xad) },
+            });
+        snapshot.Routes.push_back(SnapshotRoute
+            {
+                .ChannelId = 1234,
+                .StreamId = 5678,
+                .IngestHostname = "ingest",
+                .TargetHostname = "edge",
+            });
+        return snapshot;
+    }
+}
+
+TEST_CASE("Snapshots survive a round trip through a file", "[snapshot]")
+{
+    std::string path = snapshotTestPath();
+    std::remove(path.c_str());
+    REQUIRE(StateSnapshot::ReadFromFile(path) == std::nullopt);
+
+    StateSnapshot written = exampleSnapshot();
+    written.WriteToFile(path);
+    std::optional<StateSnapshot> read = StateSnapshot::ReadFromFile(path);
+    REQUIRE(read.has_value());
+    REQUIRE(read->WrittenAt == written.WrittenAt);
+    REQUIRE(read->Nodes == written.Nodes);
+    REQUIRE(read->Streams == written.Streams);
+    REQUIRE(read->Subscriptions == written.Subscriptions);
+    REQUIRE(read->Routes == written.Routes);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Damaged snapshots are rejected", "[snapshot]")
+{
+    std::vector<std::byte> bytes = exampleSnapshot().Serialize();
+
+    // Truncated
+    REQUIRE_THROWS(StateSnapshot::Deserialize(bytes.data(), (bytes.size() - 1)));
+
+    // Flipped bit in the body
+    std::vector<std::byte> corrupted = bytes;
+    corrupted.back() ^= std::byte(0x01);
+    REQUIRE_THROWS(StateSnapshot::Deserialize(corrupted.data(), corrupted.size()));
+
+    // Written by a newer schema
+    std::vector<std::byte> newer = bytes;
+    newer.at(9) = std::byte(StateSnapshot::SCHEMA_VERSION + 1);
+    REQUIRE_THROWS(StateSnapshot::Deserialize(newer.data(), newer.size()));
+
+    // Not a snapshot at all
+    std::string path = snapshotTestPath();
+    {
+        std::ofstream file(path);
+        file << "hello";
+    }
+    REQUIRE_THROWS(StateSnapshot::ReadFromFile(path));
+    std::remove(path.c_str());
+}
@@ -0,0 +1,108 @@
+/**
+ * @file TimerWheelUnitTests.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include <TimerWheel.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Records which timers fired, and how long after the test started
+     */
+    class FiredTimers
+    {
+    public:
+        std::function<void()> Callback(int timerNumber)
+        {
+            return [this, timerNumber]()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    fired.push_back(timerNumber);
+                    firedAfter.push_back(std::chrono::steady_clock::now() - startTime);
+                }
+                conditionVariable.notify_all();
+            };
+        }
+
+        std::vector<int> WaitFor(size_t count)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            conditionVariable.wait_for(
+                lock,
+                std::chrono::seconds(5),
+                [this, count]() { return fired.size() >= count; });
+            return fired;
+        }
+
+        std::chrono::steady_clock::duration FiredAfter(size_t index)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return firedAfter.at(index);
+        }
+
+    private:
+        const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        std::mutex mutex;
+        std::condition_variable conditionVariable;
+        std::vector<int> fired;
+        std::vector<std::chrono::steady_clock::duration> firedAfter;
+    };
+}
+
+TEST_CASE("Timers fire in deadline order, never early", "[timers]")
+{
+    TimerWheel wheel(std::chrono::milliseconds(1));
+    FiredTimers fired;
+    wheel.Schedule(std::chrono::milliseconds(50), fired.Callback(50));
+    wheel.Schedule(std::chrono::milliseconds(10), fired.Callback(10));
+    // Far enough out to wait in a higher level of the wheel and cascade down
+    wheel.Schedule(std::chrono::milliseconds(300), fired.Callback(300));
+    wheel.Schedule(std::chrono::milliseconds(30), fired.Callback(30));
+
+    REQUIRE(fired.WaitFor(4) == std::vector<int>{ 10, 30, 50, 300 });
+    REQUIRE(fired.FiredAfter(0) >= std::chrono::milliseconds(10));
+    REQUIRE(fired.FiredAfter(3) >= std::chrono::milliseconds(300));
+    REQUIRE(wheel.GetPendingCount() == 0);
+}
+
+TEST_CASE("Cancelled timers don't fire", "[timers]")
+{
+    TimerWheel wheel(std::chrono::milliseconds(1));
+    FiredTimers fired;
+    auto cancelledId = wheel.Schedule(std::chrono::milliseconds(20), fired.Callback(1));
+    auto firedId = wheel.Schedule(std::chrono::milliseconds(40), fired.Callback(2));
+    REQUIRE(wheel.Cancel(cancelledId) == true);
+    REQUIRE(wheel.GetPendingCount() == 1);
+
+    REQUIRE(fired.WaitFor(1) == std::vector<int>{ 2 });
+    // Too late to cancel once it has fired
+    REQUIRE(wheel.Cancel(firedId) == false);
+    REQUIRE(wheel.Cancel(cancelledId) == false);
+}
+
+TEST_CASE("Timer callbacks can schedule and cancel timers", "[timers]")
+{
+    TimerWheel wheel(std::chrono::milliseconds(1));
+    FiredTimers fired;
+    auto cancelledId = wheel.Schedule(std::chrono::milliseconds(100), fired.Callback(3));
+    wheel.Schedule(
+        std::chrono::milliseconds(10),
+        [&wheel, &fired, cancelledId]()
+        {
+            fired.Callback(1)();
+            wheel.Cancel(cancelledId);
+            wheel.Schedule(std::chrono::milliseconds(10), fired.Callback(2));
+        });
+
+    REQUIRE(fired.WaitFor(2) == std::vector<int>{ 1, 2 });
+    REQUIRE(wheel.GetPendingCount() == 0);
+}
@@ -0,0 +1,178 @@
+/**
+ * @file TlsTransportContextUnitTests.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include <TlsConnectionTransport.h>
+#include <TlsTransportContext.h>
+
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <sys/socket.h>
+
+namespace
+{
+    const std::vector<std::byte> TEST_PSK = {
+        std::byte(0x00), std::byte(0x01), std::byte(0x02), std::byte(0x03),
+        std::byte(0x04), std::byte(0x05), std::byte(0x06), std::byte(0x07),
+        std::byte(0x08), std::byte(0x09), std::byte(0x0a), std::byte(0x0b),
+        std::byte(0x0c), std::byte(0x0d), std::byte(0x0e), std::byte(0x0f),
+    };
+
+    /**
+     * @brief Connects a server and client transport over a local socket pair
+     */
+    std::pair<std::shared_ptr<TlsConnectionTransport>, std::shared_ptr<TlsConnectionTransport>>
+        connectTransportPair(
+            std::shared_ptr<TlsTransportContext> serverContext,
+            std::shared_ptr<TlsTransportContext> clientContext,
+            std::function<void(const std::vector<std::byte>&)> onServerBytesReceived,
+            std::function<void(void)> onServerClosed = nullptr)
+    {
+        int socketHandles[2];
+        REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, socketHandles) == 0);
+        auto server = std::make_shared<TlsConnectionTransport>(
+            serverContext,
+            socketHandles[0],
+            sockaddr_in { 0 });
+        auto client = std::make_shared<TlsConnectionTransport>(
+            clientContext,
+            socketHandles[1],
+            sockaddr_in { 0 });
+        server->SetOnBytesReceived(onServerBytesReceived);
+        if (onServerClosed)
+        {
+            server->SetOnConnectionClosed(onServerClosed);
+        }
+
+        // Servers report the handshake through a callback rather than blocking StartAsync()
+        std::promise<bool> serverHandshakePromise;
+        auto serverHandshake = serverHandshakePromise.get_future();
+        server->SetOnHandshakeComplete(
+            [&serverHandshakePromise](bool isSuccess)
+            {
+                serverHandshakePromise.set_value(isSuccess);
+            });
+        server->StartAsync();
+        client->StartAsync();
+        REQUIRE(serverHandshake.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        return { server, client };
+    }
+}
+
+TEST_CASE("Connections sharing a transport context can each complete a handshake", "[tls]")
+{
+    auto serverContext = std::make_shared<TlsTransportContext>(true /*isServer*/, TEST_PSK);
+    auto clientContext = std::make_shared<TlsTransportContext>(false /*isServer*/, TEST_PSK);
+
+    std::mutex receivedMutex;
+    std::condition_variable receivedConditionVariable;
+    std::map<int, std::vector<std::byte>> receivedBytes;
+
+    constexpr int CONNECTION_COUNT = 3;
+    std::vector<std::shared_ptr<TlsConnectionTransport>> transports;
+    for (int i = 0; i < CONNECTION_COUNT; ++i)
+    {
+        auto [server, client] = connectTransportPair(
+            serverContext,
+            clientContext,
+            [i, &receivedMutex, &receivedConditionVariable, &receivedBytes]
+            (const std::vector<std::byte>& bytes)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(receivedMutex);
+                    auto& received = receivedBytes[i];
+                    received.insert(received.end(), bytes.begin(), bytes.end());
+                }
+                receivedConditionVariable.notify_all();
+            });
+        client->Write({ std::byte(i), std::byte(0xff) });
+        transports.push_back(server);
+        transports.push_back(client);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(receivedMutex);
+        bool allReceived = receivedConditionVariable.wait_for(
+            lock,
+            std::chrono::seconds(5),
+            [&receivedBytes]()
+            {
+                for (int i = 0; i < CONNECTION_COUNT; ++i)
+                {
+                    if (receivedBytes[i].size() < 2)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            });
+        REQUIRE(allReceived);
+        for (int i = 0; i < CONNECTION_COUNT; ++i)
+        {
+            REQUIRE(receivedBytes[i] == std::vector<std::byte>{ std::byte(i), std::byte(0xff) });
+        }
+    }
+
+    for (auto& transport : transports)
+    {
+        transport->Stop();
+    }
+}
+
+TEST_CASE("Handshakes fail when pre-shared keys do not match", "[tls]")
+{
+    auto serverContext = std::make_shared<TlsTransportContext>(true /*isServer*/, TEST_PSK);
+    std::vector<std::byte> wrongPsk = TEST_PSK;
+    wrongPsk.back() = std::byte(0xff);
+    auto clientContext = std::make_shared<TlsTransportContext>(false /*isServer*/, wrongPsk);
+
+    std::promise<void> serverClosedPromise;
+    auto serverClosed = serverClosedPromise.get_future();
+    auto [server, client] = connectTransportPair(
+        serverContext,
+        clientContext,
+        [](const std::vector<std::byte>&) { },
+        [&serverClosedPromise]() { serverClosedPromise.set_value(); });
+
+    REQUIRE(serverClosed.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    client->Stop();
+    server->Stop();
+}
+
+TEST_CASE("Kernel TLS falls back to userspace encryption when it can't be used", "[tls]")
+{
+    // Unix domain sockets can't carry kTLS, so OpenSSL has to fall back
+    auto serverContext = std::make_shared<TlsTransportContext>(
+        true /*isServer*/,
+        TEST_PSK,
+        TlsTransportContext::DEFAULT_HANDSHAKE_TIMEOUT,
+        true /*enableKernelTls*/);
+    auto clientContext = std::make_shared<TlsTransportContext>(
+        false /*isServer*/,
+        TEST_PSK,
+        TlsTransportContext::DEFAULT_HANDSHAKE_TIMEOUT,
+        true /*enableKernelTls*/);
+
+    std::promise<std::vector<std::byte>> receivedPromise;
+    auto received = receivedPromise.get_future();
+    auto [server, client] = connectTransportPair(
+        serverContext,
+        clientContext,
+        [&receivedPromise](const std::vector<std::byte>& bytes)
+        {
+            receivedPromise.set_value(bytes);
+        });
+
+    REQUIRE(server->IsKernelTlsSend() == false);
+    REQUIRE(server->IsKernelTlsReceive() == false);
+    client->Write({ std::byte(0x01) });
+    REQUIRE(received.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    REQUIRE(received.get() == std::vector<std::byte>{ std::byte(0x01) });
+
+    client->Stop();
+    server->Stop();
+}
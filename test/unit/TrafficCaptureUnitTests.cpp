@@ -0,0 +1,147 @@
+/**
+ * @file TrafficCaptureUnitTests.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include "../../src/Orchestrator.h"
+#include "../../src/TrafficCapture.h"
+#include "../mocks/MockConnection.h"
+#include "../mocks/MockConnectionManager.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+
+namespace
+{
+    std::string captureTestPath()
+    {
+        return "/tmp/ftl-orchestrator-capture-test-" + std::to_string(getpid());
+    }
+}
+
+TEST_CASE("Captured messages can be read back in order", "[capture]")
+{
+    std::string path = captureTestPath();
+    uint32_t ingestId;
+    uint32_t edgeId;
+    {
+        TrafficCapture capture(path);
+        ingestId = capture.AddConnection();
+        edgeId = capture.AddConnection();
+        capture.Record(ingestId, ConnectionIntroPayload
+            {
+                .VersionMajor = 0,
+                .VersionMinor = 0,
+                .VersionRevision = 1,
+                .RelayLayer = 0,
+                .RegionCode = "na-west",
+                .Hostname = "ingest",
+            });
+        capture.Record(edgeId, ConnectionSubscriptionPayload
+            {
+                .IsSubscribe = true,
+                .ChannelId = 1234,
+                .StreamKey = { std::byte(0xde), std::byte(0xad) },
+            });
+        capture.Record(ingestId, ConnectionPublishPayload
+            {
+                .IsPublish = true,
+                .ChannelId = 1234,
+                .StreamId = 5678,
+            });
+        capture.Record(ingestId, ConnectionNodeStatePayload
+            {
+                .CurrentLoad = 300,
+                .MaximumLoad = 100000,
+            });
+        capture.Record(edgeId, CapturedClose { });
+    }
+    REQUIRE(ingestId != edgeId);
+
+    std::vector<CaptureRecord> records = TrafficCapture::ReadFromFile(path);
+    REQUIRE(records.size() == 7);
+    for (size_t i = 1; i < records.size(); ++i)
+    {
+        REQUIRE(records.at(i).Timestamp >= records.at(i - 1).Timestamp);
+    }
+    REQUIRE(std::holds_alternative<CapturedConnect>(records.at(0).Message));
+    REQUIRE(records.at(0).ConnectionId == ingestId);
+    REQUIRE(std::holds_alternative<CapturedConnect>(records.at(1).Message));
+    REQUIRE(records.at(1).ConnectionId == edgeId);
+
+    auto& intro = std::get<ConnectionIntroPayload>(records.at(2).Message);
+    REQUIRE(intro.VersionRevision == 1);
+    REQUIRE(intro.RegionCode == "na-west");
+    REQUIRE(intro.Hostname == "ingest");
+
+    auto& subscription = std::get<ConnectionSubscriptionPayload>(records.at(3).Message);
+    REQUIRE(records.at(3).ConnectionId == edgeId);
+    REQUIRE(subscription.IsSubscribe);
+    REQUIRE(subscription.ChannelId == 1234);
+    REQUIRE(subscription.StreamKey == std::vector<std::byte> { std::byte(0xde), std::byte(0xad) });
+
+    auto& publish = std::get<ConnectionPublishPayload>(records.at(4).Message);
+    REQUIRE(publish.IsPublish);
+    REQUIRE(publish.StreamId == 5678);
+
+    auto& nodeState = std::get<ConnectionNodeStatePayload>(records.at(5).Message);
+    REQUIRE(nodeState.CurrentLoad == 300);
+    REQUIRE(nodeState.MaximumLoad == 100000);
+
+    REQUIRE(std::holds_alternative<CapturedClose>(records.at(6).Message));
+    REQUIRE(records.at(6).ConnectionId == edgeId);
+
+    // A capture that was cut off mid-record still yields everything before it
+    std::filesystem::resize_file(path, (std::filesystem::file_size(path) - 1));
+    REQUIRE(TrafficCapture::ReadFromFile(path).size() == 6);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Orchestrator captures the messages it receives", "[capture]")
+{
+    std::string path = captureTestPath();
+    auto connectionManager = std::make_unique<MockConnectionManager<MockConnection>>();
+    MockConnectionManager<MockConnection>* connectionManagerPtr = connectionManager.get();
+    auto orchestrator = std::make_unique<Orchestrator<MockConnection>>(
+        std::move(connectionManager),
+        OrchestratorOptions
+        {
+            .CapturePath = path,
+        });
+    orchestrator->Init();
+
+    auto edge = std::make_shared<MockConnection>("edge");
+    connectionManagerPtr->MockFireNewConnection(edge);
+    edge->MockFireOnIntro(
+        {
+            .VersionMajor = 0,
+            .VersionMinor = 0,
+            .VersionRevision = 1,
+            .RelayLayer = 0,
+            .RegionCode = "global",
+            .Hostname = "edge",
+        });
+    edge->MockFireOnChannelSubscription(
+        {
+            .IsSubscribe = true,
+            .ChannelId = 1234,
+        });
+    edge->MockFireOnConnectionClosed();
+    orchestrator.reset();
+
+    std::vector<CaptureRecord> records = TrafficCapture::ReadFromFile(path);
+    REQUIRE(records.size() == 4);
+    REQUIRE(std::holds_alternative<CapturedConnect>(records.at(0).Message));
+    REQUIRE(std::holds_alternative<ConnectionIntroPayload>(records.at(1).Message));
+    REQUIRE(std::holds_alternative<ConnectionSubscriptionPayload>(records.at(2).Message));
+    REQUIRE(std::holds_alternative<CapturedClose>(records.at(3).Message));
+    for (const auto& record : records)
+    {
+        REQUIRE(record.ConnectionId == records.at(0).ConnectionId);
+    }
+    std::remove(path.c_str());
+}
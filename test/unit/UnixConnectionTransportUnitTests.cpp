@@ -0,0 +1,44 @@
+/**
+ * @file UnixConnectionTransportUnitTests.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include <UnixConnectionTransport.h>
+
+#include <future>
+#include <sys/socket.h>
+
+TEST_CASE("Unix transports exchange bytes and report remote closes", "[unix]")
+{
+    int socketHandles[2];
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, socketHandles) == 0);
+    auto server = std::make_shared<UnixConnectionTransport>(socketHandles[0]);
+    auto client = std::make_shared<UnixConnectionTransport>(socketHandles[1]);
+
+    std::promise<std::vector<std::byte>> receivedPromise;
+    auto received = receivedPromise.get_future();
+    std::promise<void> serverClosedPromise;
+    auto serverClosed = serverClosedPromise.get_future();
+    bool isClientCloseReported = false;
+    server->SetOnBytesReceived(
+        [&receivedPromise](const std::vector<std::byte>& bytes)
+        {
+            receivedPromise.set_value(bytes);
+        });
+    server->SetOnConnectionClosed([&serverClosedPromise]() { serverClosedPromise.set_value(); });
+    client->SetOnConnectionClosed([&isClientCloseReported]() { isClientCloseReported = true; });
+    server->StartAsync();
+    client->StartAsync();
+
+    client->Write({ std::byte(0x01), std::byte(0x02) });
+    REQUIRE(received.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    REQUIRE(received.get() == std::vector<std::byte>{ std::byte(0x01), std::byte(0x02) });
+
+    // Stopping one end is reported to the other, but not to itself
+    client->Stop();
+    REQUIRE(serverClosed.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    REQUIRE(isClientCloseReported == false);
+    server->Stop();
+}
@@ -0,0 +1,587 @@
+/**
+ * @file LoadGenerator.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include "LoadGenerator.h"
+
+#include "FtlOrchestrationClient.h"
+
+#include <algorithm>
+#include <cmath>
+#include <spdlog/spdlog.h>
+#include <thread>
+
+#pragma region Constructor/Destructor
+LoadGenerator::LoadGenerator(LoadGeneratorSettings settings) :
+    settings(settings),
+    random(std::random_device()()),
+    transportContext(FtlOrchestrationClient::CreateTransportContext(settings.PreSharedKey)),
+    relayLatency(1e-9),
+    connectLatency(1e-9),
+    targetHostname(settings.TargetHostname),
+    targetPort(settings.TargetPort),
+    failoverLatency(1e-9)
+{
+    // Precompute the Zipf CDF so picking a channel is a binary search
+    double total = 0;
+    channelPopularityCdf.reserve(settings.ChannelCount);
+    for (int rank = 1; rank <= settings.ChannelCount; ++rank)
+    {
+        total += (1.0 / std::pow(static_cast<double>(rank), settings.ZipfExponent));
+        channelPopularityCdf.push_back(total);
+    }
+    for (auto& value : channelPopularityCdf)
+    {
+        value /= total;
+    }
+
+    auto addNodes =
+        [this](NodeKind kind, int count, const std::string& prefix)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                nodes.push_back(SimulatedNode
+                    {
+                        .Kind = kind,
+                        .Hostname = fmt::format("loadgen-{}-{}", prefix, i),
+                    });
+            }
+        };
+    addNodes(NodeKind::Ingest, settings.IngestCount, "ingest");
+    addNodes(NodeKind::Relay, settings.RelayCount, "relay");
+    addNodes(NodeKind::Edge, settings.EdgeCount, "edge");
+}
+#pragma endregion
+
+#pragma region Public methods
+void LoadGenerator::Run()
+{
+    std::vector<size_t> allNodes(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        allNodes[i] = i;
+    }
+    spdlog::info("LoadGenerator: Connecting {} nodes to {}:{}...",
+        nodes.size(), settings.TargetHostname, settings.TargetPort);
+    connectNodes(allNodes);
+    publishInitialStreams();
+
+    std::vector<size_t> edges = nodesOfKind(NodeKind::Edge);
+    std::vector<size_t> ingests = nodesOfKind(NodeKind::Ingest);
+
+    // Drive the workload in small ticks, carrying fractional events over between ticks
+    const std::chrono::milliseconds tickInterval(10);
+    const double tickSeconds = std::chrono::duration<double>(tickInterval).count();
+    double subscribeBudget = 0;
+    double publishBudget = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    auto nextNodeState = startTime;
+    auto nextStorm = startTime + settings.ReconnectStormInterval;
+    auto nextProgress = startTime + std::chrono::seconds(5);
+    while ((std::chrono::steady_clock::now() - startTime) < settings.Duration)
+    {
+        auto tickStart = std::chrono::steady_clock::now();
+
+        subscribeBudget += (settings.SubscribeRate * tickSeconds);
+        while ((subscribeBudget >= 1.0) && !edges.empty())
+        {
+            subscribeBudget -= 1.0;
+            size_t edgeIndex = edges[random() % edges.size()];
+            toggleSubscription(edgeIndex, pickPopularChannel());
+        }
+
+        publishBudget += (settings.PublishRate * tickSeconds);
+        while ((publishBudget >= 1.0) && !ingests.empty())
+        {
+            publishBudget -= 1.0;
+            // Swap a random live stream for a new one to keep the live fraction steady
+            if (!liveChannelIngest.empty())
+            {
+                auto liveIt = liveChannelIngest.begin();
+                std::advance(liveIt, random() % liveChannelIngest.size());
+                unpublish(liveIt->first);
+            }
+            ftl_channel_id_t channelId = (random() % settings.ChannelCount) + 1;
+            if (!liveChannelIngest.contains(channelId))
+            {
+                publish(ingests[random() % ingests.size()], channelId);
+            }
+        }
+
+        if (tickStart >= nextNodeState)
+        {
+            sendNodeStates();
+            nextNodeState += settings.NodeStateInterval;
+        }
+
+        if ((settings.ReconnectStormInterval.count() > 0) && (tickStart >= nextStorm))
+        {
+            reconnectStorm();
+            nextStorm = std::chrono::steady_clock::now() + settings.ReconnectStormInterval;
+        }
+
+        if (!settings.FailoverHostname.empty() && !isFailedOver)
+        {
+            bool isPrimaryLost = false;
+            {
+                std::lock_guard<std::mutex> lock(lostConnectionsMutex);
+                isPrimaryLost = !lostConnections.empty();
+            }
+            if (isPrimaryLost)
+            {
+                failOver();
+            }
+        }
+
+        if (tickStart >= nextProgress)
+        {
+            printProgress(tickStart - startTime);
+            nextProgress += std::chrono::seconds(5);
+        }
+
+        std::this_thread::sleep_until(tickStart + tickInterval);
+    }
+
+    // Give outstanding relays a moment to arrive before tallying up
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    auto elapsed = (std::chrono::steady_clock::now() - startTime);
+    for (auto& node : nodes)
+    {
+        disconnectNode(node);
+    }
+    printSummary(elapsed);
+}
+#pragma endregion
+
+#pragma region Private methods
+void LoadGenerator::connectNodes(const std::vector<size_t>& nodeIndices)
+{
+    // Handshakes block, so spread them across a few threads
+    std::atomic<size_t> nextIndex { 0 };
+    std::vector<std::thread> connectThreads;
+    for (int i = 0; i < std::max(1, settings.ConnectThreads); ++i)
+    {
+        connectThreads.emplace_back(
+            [this, &nodeIndices, &nextIndex]()
+            {
+                size_t index;
+                while ((index = nextIndex.fetch_add(1)) < nodeIndices.size())
+                {
+                    connectNode(nodes[nodeIndices[index]]);
+                }
+            });
+    }
+    for (auto& thread : connectThreads)
+    {
+        thread.join();
+    }
+}
+
+void LoadGenerator::connectNode(SimulatedNode& node)
+{
+    auto connectStart = std::chrono::steady_clock::now();
+    try
+    {
+        node.Connection = FtlOrchestrationClient::Connect(
+            targetHostname,
+            transportContext,
+            node.Hostname,
+            targetPort);
+        if (!settings.FailoverHostname.empty())
+        {
+            size_t nodeIndex = (&node - nodes.data());
+            std::weak_ptr<FtlConnection> weakConnection = node.Connection;
+            node.Connection->SetOnConnectionClosed(
+                [this, nodeIndex, weakConnection]()
+                {
+                    std::lock_guard<std::mutex> lock(lostConnectionsMutex);
+                    lostConnections.emplace_back(nodeIndex, weakConnection);
+                });
+        }
+        if (node.Kind == NodeKind::Ingest)
+        {
+            node.Connection->SetOnStreamRelay(
+                std::bind(&LoadGenerator::onRelayReceived, this, std::placeholders::_1));
+        }
+        node.Connection->Start();
+        node.Connection->SendIntro(ConnectionIntroPayload
+            {
+                .VersionMajor = 0,
+                .VersionMinor = 0,
+                .VersionRevision = 1,
+                .RelayLayer = static_cast<uint8_t>((node.Kind == NodeKind::Relay) ? 1 : 0),
+                .RegionCode = "loadgen",
+                .Hostname = node.Hostname,
+            });
+        commandsSent++;
+        connectLatency.RecordSince(connectStart);
+    }
+    catch (const std::exception& e)
+    {
+        node.Connection = nullptr;
+        if (!isFailingOver)
+        {
+            spdlog::warn("LoadGenerator: {} failed to connect: {}", node.Hostname, e.what());
+            connectFailures++;
+        }
+    }
+}
+
+void LoadGenerator::disconnectNode(SimulatedNode& node)
+{
+    if (node.Connection)
+    {
+        node.Connection->Stop();
+        node.Connection = nullptr;
+    }
+}
+
+void LoadGenerator::publishInitialStreams()
+{
+    std::vector<size_t> ingests = nodesOfKind(NodeKind::Ingest);
+    if (ingests.empty())
+    {
+        return;
+    }
+    int liveCount = static_cast<int>(settings.ChannelCount * settings.LiveChannelFraction);
+    for (int i = 0; i < liveCount; ++i)
+    {
+        ftl_channel_id_t channelId = (random() % settings.ChannelCount) + 1;
+        if (!liveChannelIngest.contains(channelId))
+        {
+            publish(ingests[random() % ingests.size()], channelId);
+        }
+    }
+}
+
+void LoadGenerator::publish(size_t ingestIndex, ftl_channel_id_t channelId)
+{
+    SimulatedNode& ingest = nodes[ingestIndex];
+    if (!ingest.Connection)
+    {
+        return;
+    }
+
+    // Every edge subscribed to this channel should now get a relay
+    for (const auto& node : nodes)
+    {
+        if ((node.Kind == NodeKind::Edge) && node.Connection && node.Channels.contains(channelId))
+        {
+            expectRelay(channelId, node.Hostname, true);
+        }
+    }
+
+    ftl_stream_id_t streamId = nextStreamId++;
+    ingest.Channels.insert(channelId);
+    liveChannelIngest[channelId] = ingestIndex;
+    liveChannelStream[channelId] = streamId;
+    ingest.Connection->SendStreamPublish(ConnectionPublishPayload
+        {
+            .IsPublish = true,
+            .ChannelId = channelId,
+            .StreamId = streamId,
+        });
+    commandsSent++;
+}
+
+void LoadGenerator::unpublish(ftl_channel_id_t channelId)
+{
+    SimulatedNode& ingest = nodes[liveChannelIngest[channelId]];
+    ftl_stream_id_t streamId = liveChannelStream[channelId];
+    liveChannelIngest.erase(channelId);
+    liveChannelStream.erase(channelId);
+    ingest.Channels.erase(channelId);
+    if (!ingest.Connection)
+    {
+        return;
+    }
+
+    for (const auto& node : nodes)
+    {
+        if ((node.Kind == NodeKind::Edge) && node.Connection && node.Channels.contains(channelId))
+        {
+            expectRelay(channelId, node.Hostname, false);
+        }
+    }
+
+    ingest.Connection->SendStreamPublish(ConnectionPublishPayload
+        {
+            .IsPublish = false,
+            .ChannelId = channelId,
+            .StreamId = streamId,
+        });
+    commandsSent++;
+}
+
+void LoadGenerator::toggleSubscription(size_t edgeIndex, ftl_channel_id_t channelId)
+{
+    SimulatedNode& edge = nodes[edgeIndex];
+    if (!edge.Connection)
+    {
+        return;
+    }
+
+    bool isSubscribe = !edge.Channels.contains(channelId);
+    if (liveChannelIngest.contains(channelId))
+    {
+        expectRelay(channelId, edge.Hostname, isSubscribe);
+    }
+    if (isSubscribe)
+    {
+        edge.Channels.insert(channelId);
+    }
+    else
+    {
+        edge.Channels.erase(channelId);
+    }
+
+    std::vector<std::byte> streamKey(8);
+    std::generate(streamKey.begin(), streamKey.end(),
+        [this]() { return static_cast<std::byte>(random() & 0xFF); });
+    edge.Connection->SendChannelSubscription(ConnectionSubscriptionPayload
+        {
+            .IsSubscribe = isSubscribe,
+            .ChannelId = channelId,
+            .StreamKey = isSubscribe ? streamKey : std::vector<std::byte>(),
+        });
+    commandsSent++;
+}
+
+void LoadGenerator::sendNodeStates()
+{
+    for (auto& node : nodes)
+    {
+        if (node.Connection)
+        {
+            node.Connection->SendNodeState(ConnectionNodeStatePayload
+                {
+                    .CurrentLoad = static_cast<uint32_t>(node.Channels.size()),
+                    .MaximumLoad = 1000,
+                });
+            commandsSent++;
+        }
+    }
+}
+
+void LoadGenerator::reconnectStorm()
+{
+    std::vector<size_t> stormNodes;
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        if (std::uniform_real_distribution<double>(0.0, 1.0)(random) <
+            settings.ReconnectStormFraction)
+        {
+            stormNodes.push_back(i);
+        }
+    }
+    spdlog::info("LoadGenerator: Reconnect storm, cycling {} nodes...", stormNodes.size());
+
+    for (size_t index : stormNodes)
+    {
+        SimulatedNode& node = nodes[index];
+        // The orchestrator tears down every route this edge was receiving
+        if (node.Kind == NodeKind::Edge)
+        {
+            for (const auto& channelId : node.Channels)
+            {
+                if (liveChannelIngest.contains(channelId) &&
+                    nodes[liveChannelIngest[channelId]].Connection)
+                {
+                    expectRelay(channelId, node.Hostname, false);
+                }
+            }
+        }
+        disconnectNode(node);
+    }
+
+    // Let the orchestrator process the disconnects before everyone comes back at once,
+    // otherwise re-published streams can collide with the ones it hasn't cleaned up yet
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    connectNodes(stormNodes);
+
+    // Re-announce everything the reconnected nodes had going on
+    for (size_t index : stormNodes)
+    {
+        SimulatedNode& node = nodes[index];
+        std::set<ftl_channel_id_t> channels = node.Channels;
+        node.Channels.clear();
+        for (const auto& channelId : channels)
+        {
+            if (node.Kind == NodeKind::Edge)
+            {
+                toggleSubscription(index, channelId);
+            }
+            else if (node.Kind == NodeKind::Ingest)
+            {
+                liveChannelIngest.erase(channelId);
+                liveChannelStream.erase(channelId);
+                publish(index, channelId);
+            }
+        }
+    }
+}
+
+void LoadGenerator::failOver()
+{
+    auto failoverStart = std::chrono::steady_clock::now();
+    spdlog::warn("LoadGenerator: Lost the orchestrator, failing over to {}:{}...",
+        settings.FailoverHostname, settings.FailoverPort);
+    targetHostname = settings.FailoverHostname;
+    targetPort = settings.FailoverPort;
+    isFailingOver = true;
+
+    // The standby picks up the routes the primary knew about, so nodes come back with what they
+    // had going on and only need to introduce themselves again
+    std::vector<size_t> remainingNodes;
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        disconnectNode(nodes[i]);
+        remainingNodes.push_back(i);
+    }
+    while (!remainingNodes.empty() &&
+        ((std::chrono::steady_clock::now() - failoverStart) < settings.FailoverTimeout))
+    {
+        connectNodes(remainingNodes);
+        std::erase_if(remainingNodes,
+            [this, failoverStart](size_t index)
+            {
+                if (nodes[index].Connection)
+                {
+                    failoverLatency.RecordSince(failoverStart);
+                    return true;
+                }
+                return false;
+            });
+        if (!remainingNodes.empty())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+    isFailingOver = false;
+    isFailedOver = true;
+    failoverTime = (std::chrono::steady_clock::now() - failoverStart);
+    failoverNodeCount = (nodes.size() - remainingNodes.size());
+    connectFailures += remainingNodes.size();
+    {
+        // Whatever closed before we got here was the old orchestrator going away
+        std::lock_guard<std::mutex> lock(lostConnectionsMutex);
+        lostConnections.clear();
+    }
+    spdlog::warn("LoadGenerator: Failed over {} of {} nodes in {:.3f}ms",
+        failoverNodeCount,
+        nodes.size(),
+        std::chrono::duration<double, std::milli>(failoverTime).count());
+}
+
+void LoadGenerator::expectRelay(
+    ftl_channel_id_t channelId,
+    const std::string& targetHostname,
+    bool isStart)
+{
+    std::lock_guard<std::mutex> lock(pendingRelaysMutex);
+    pendingRelays.try_emplace(
+        std::make_tuple(channelId, targetHostname, isStart),
+        std::chrono::steady_clock::now());
+}
+
+ConnectionResult LoadGenerator::onRelayReceived(ConnectionRelayPayload payload)
+{
+    relaysReceived++;
+    std::lock_guard<std::mutex> lock(pendingRelaysMutex);
+    auto pending = pendingRelays.find(
+        std::make_tuple(payload.ChannelId, payload.TargetHostname, payload.IsStartRelay));
+    if (pending == pendingRelays.end())
+    {
+        unexpectedRelays++;
+    }
+    else
+    {
+        relayLatency.RecordSince(pending->second);
+        pendingRelays.erase(pending);
+    }
+    return ConnectionResult
+    {
+        .IsSuccess = true
+    };
+}
+
+ftl_channel_id_t LoadGenerator::pickPopularChannel()
+{
+    double sample = std::uniform_real_distribution<double>(0.0, 1.0)(random);
+    auto rank = std::lower_bound(channelPopularityCdf.begin(), channelPopularityCdf.end(), sample);
+    return static_cast<ftl_channel_id_t>(
+        std::min<size_t>(std::distance(channelPopularityCdf.begin(), rank),
+            (channelPopularityCdf.size() - 1)) + 1);
+}
+
+std::vector<size_t> LoadGenerator::nodesOfKind(NodeKind kind)
+{
+    std::vector<size_t> returnVal;
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        if (nodes[i].Kind == kind)
+        {
+            returnVal.push_back(i);
+        }
+    }
+    return returnVal;
+}
+
+void LoadGenerator::printProgress(std::chrono::steady_clock::duration elapsed)
+{
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    spdlog::info(
+        "LoadGenerator: {:.0f}s: {} commands ({:.0f}/s), {} relays ({:.0f}/s), "
+        "relay latency p50 {:.3f}ms p99 {:.3f}ms",
+        seconds,
+        commandsSent.load(),
+        (commandsSent.load() / seconds),
+        relaysReceived.load(),
+        (relaysReceived.load() / seconds),
+        (relayLatency.GetQuantile(0.5) / 1e6),
+        (relayLatency.GetQuantile(0.99) / 1e6));
+}
+
+void LoadGenerator::printSummary(std::chrono::steady_clock::duration elapsed)
+{
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    size_t outstandingRelays;
+    {
+        std::lock_guard<std::mutex> lock(pendingRelaysMutex);
+        outstandingRelays = pendingRelays.size();
+    }
+    fmt::print(
+        "\n=== Load generator summary ===\n"
+        "Nodes:              {} ingest, {} edge, {} relay ({} connect failures)\n"
+        "Duration:           {:.1f}s\n"
+        "Commands sent:      {} ({:.1f}/s)\n"
+        "Relays received:    {} ({:.1f}/s), {} unexpected, {} never arrived\n"
+        "Relay latency (ms): p50 {:.3f}, p99 {:.3f}, p999 {:.3f}\n"
+        "Connect time (ms):  p50 {:.3f}, p99 {:.3f}, p999 {:.3f}\n",
+        settings.IngestCount, settings.EdgeCount, settings.RelayCount, connectFailures.load(),
+        seconds,
+        commandsSent.load(), (commandsSent.load() / seconds),
+        relaysReceived.load(), (relaysReceived.load() / seconds), unexpectedRelays.load(),
+        outstandingRelays,
+        (relayLatency.GetQuantile(0.5) / 1e6),
+        (relayLatency.GetQuantile(0.99) / 1e6),
+        (relayLatency.GetQuantile(0.999) / 1e6),
+        (connectLatency.GetQuantile(0.5) / 1e6),
+        (connectLatency.GetQuantile(0.99) / 1e6),
+        (connectLatency.GetQuantile(0.999) / 1e6));
+    if (isFailedOver)
+    {
+        fmt::print(
+            "Failover:           {} of {} nodes moved in {:.3f}ms\n"
+            "Failover time (ms): p50 {:.3f}, p99 {:.3f}, p999 {:.3f}\n",
+            failoverNodeCount, nodes.size(),
+            std::chrono::duration<double, std::milli>(failoverTime).count(),
+            (failoverLatency.GetQuantile(0.5) / 1e6),
+            (failoverLatency.GetQuantile(0.99) / 1e6),
+            (failoverLatency.GetQuantile(0.999) / 1e6));
+    }
+}
+#pragma endregion
@@ -0,0 +1,146 @@
+/**
+ * @file LoadGenerator.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#pragma once
+
+#include "FtlConnection.h"
+#include "FtlTypes.h"
+#include "Metrics.h"
+#include "TlsTransportContext.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Describes the simulated fleet and the workload it replays against an orchestrator
+ */
+struct LoadGeneratorSettings
+{
+    std::string TargetHostname = "127.0.0.1";
+    uint16_t TargetPort = 8085;
+    std::vector<std::byte> PreSharedKey;
+    int IngestCount = 10;
+    int EdgeCount = 100;
+    int RelayCount = 0;
+    int ChannelCount = 1000;
+    // Fraction of channels that are live at any time
+    double LiveChannelFraction = 0.2;
+    // Zipf exponent used to pick which channel an edge (un)subscribes to
+    double ZipfExponent = 1.0;
+    // Publish/unpublish churn across all ingests, per second
+    double PublishRate = 5.0;
+    // Subscribe/unsubscribe toggles across all edges, per second
+    double SubscribeRate = 200.0;
+    std::chrono::milliseconds NodeStateInterval = std::chrono::milliseconds(1000);
+    // Every interval, this fraction of nodes disconnects and immediately reconnects
+    std::chrono::milliseconds ReconnectStormInterval = std::chrono::milliseconds(0);
+    double ReconnectStormFraction = 0.5;
+    std::chrono::seconds Duration = std::chrono::seconds(30);
+    int ConnectThreads = 8;
+    // When set, nodes that lose the orchestrator reconnect to this standby instead, and the time
+    // it takes to move every node over is reported
+    std::string FailoverHostname;
+    uint16_t FailoverPort = 8085;
+    // How long to keep retrying the standby before giving up on a node
+    std::chrono::seconds FailoverTimeout = std::chrono::seconds(30);
+};
+
+/**
+ * @brief
+ *  LoadGenerator simulates a fleet of Janus ingest, edge and relay nodes talking to an
+ *  orchestrator over TLS and measures how quickly relay commands come back.
+ */
+class LoadGenerator
+{
+public:
+    /* Constructor/Destructor */
+    LoadGenerator(LoadGeneratorSettings settings);
+
+    /* Public methods */
+    /**
+     * @brief Connects the simulated fleet, replays the workload for the configured duration,
+     *  then disconnects everything and prints a summary.
+     */
+    void Run();
+
+private:
+    enum class NodeKind
+    {
+        Ingest,
+        Edge,
+        Relay,
+    };
+
+    struct SimulatedNode
+    {
+        NodeKind Kind;
+        std::string Hostname;
+        std::shared_ptr<FtlConnection> Connection;
+        // Channels this edge is subscribed to, or this ingest is publishing
+        std::set<ftl_channel_id_t> Channels;
+    };
+
+    // (channel, target hostname, is start)
+    typedef std::tuple<ftl_channel_id_t, std::string, bool> relay_key_t;
+
+    /* Private members */
+    const LoadGeneratorSettings settings;
+    std::mt19937_64 random;
+    // Shared by every simulated node so reconnects skip per-connection TLS setup
+    std::shared_ptr<TlsTransportContext> transportContext;
+    std::vector<double> channelPopularityCdf;
+    std::vector<SimulatedNode> nodes;
+    std::map<ftl_channel_id_t, size_t> liveChannelIngest;
+    ftl_stream_id_t nextStreamId = 1;
+    std::map<ftl_channel_id_t, ftl_stream_id_t> liveChannelStream;
+    std::mutex pendingRelaysMutex;
+    std::map<relay_key_t, std::chrono::steady_clock::time_point> pendingRelays;
+    std::atomic<uint64_t> commandsSent { 0 };
+    std::atomic<uint64_t> relaysReceived { 0 };
+    std::atomic<uint64_t> unexpectedRelays { 0 };
+    std::atomic<uint64_t> connectFailures { 0 };
+    MetricHistogram relayLatency;
+    MetricHistogram connectLatency;
+    // Connections that closed on us, along with the node they belonged to
+    std::mutex lostConnectionsMutex;
+    std::vector<std::pair<size_t, std::weak_ptr<FtlConnection>>> lostConnections;
+    std::string targetHostname;
+    uint16_t targetPort;
+    // Set while nodes are moved to the standby, where failed attempts are expected and retried
+    std::atomic<bool> isFailingOver { false };
+    bool isFailedOver = false;
+    std::chrono::steady_clock::duration failoverTime { 0 };
+    size_t failoverNodeCount = 0;
+    MetricHistogram failoverLatency;
+
+    /* Private methods */
+    void connectNodes(const std::vector<size_t>& nodeIndices);
+    void connectNode(SimulatedNode& node);
+    void disconnectNode(SimulatedNode& node);
+    void publishInitialStreams();
+    void publish(size_t ingestIndex, ftl_channel_id_t channelId);
+    void unpublish(ftl_channel_id_t channelId);
+    void toggleSubscription(size_t edgeIndex, ftl_channel_id_t channelId);
+    void sendNodeStates();
+    void reconnectStorm();
+    void failOver();
+    void expectRelay(ftl_channel_id_t channelId, const std::string& targetHostname, bool isStart);
+    ConnectionResult onRelayReceived(ConnectionRelayPayload payload);
+    ftl_channel_id_t pickPopularChannel();
+    std::vector<size_t> nodesOfKind(NodeKind kind);
+    void printProgress(std::chrono::steady_clock::duration elapsed);
+    void printSummary(std::chrono::steady_clock::duration elapsed);
+};
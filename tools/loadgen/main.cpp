@@ -0,0 +1,119 @@
+/**
+ * @file main.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ * @brief Entrypoint for the synthetic load generator
+ */
+
+#include "LoadGenerator.h"
+
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    const char* USAGE = 
+        "Usage: janus-ftl-orchestrator-loadgen [--option=value ...]\n"
+        "  --host=127.0.0.1        orchestrator host\n"
+        "  --port=8085             orchestrator port\n"
+        "  --psk=<hex>             pre-shared key (defaults to FTL_ORCHESTRATOR_PSK or the\n"
+        "                          orchestrator's default key)\n"
+        "  --ingests=10            simulated ingest nodes\n"
+        "  --edges=100             simulated edge nodes\n"
+        "  --relays=0              simulated relay nodes\n"
+        "  --channels=1000         channel id space\n"
+        "  --live-fraction=0.2     fraction of channels live at once\n"
+        "  --zipf=1.0              Zipf exponent for channel popularity\n"
+        "  --publish-rate=5        stream publish churn per second\n"
+        "  --subscribe-rate=200    subscribe/unsubscribe toggles per second\n"
+        "  --node-state-ms=1000    node state interval per node\n"
+        "  --storm-ms=0            reconnect storm interval (0 disables)\n"
+        "  --storm-fraction=0.5    fraction of nodes cycled in each storm\n"
+        "  --duration=30           seconds to run\n"
+        "  --connect-threads=8     parallel handshakes while connecting\n"
+        "  --failover-host=        standby orchestrator host to fail over to when the\n"
+        "                          orchestrator is lost (disabled by default)\n"
+        "  --failover-port=8085    standby orchestrator port\n"
+        "  --failover-timeout=30   seconds to keep retrying the standby\n";
+
+    std::vector<std::byte> hexStringToBytes(const std::string& hexString)
+    {
+        std::vector<std::byte> bytes;
+        for (size_t i = 0; (i + 1) < hexString.size(); i += 2)
+        {
+            bytes.push_back(static_cast<std::byte>(std::stoul(hexString.substr(i, 2), nullptr, 16)));
+        }
+        return bytes;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::map<std::string, std::string> options;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg(argv[i]);
+        size_t separator = arg.find('=');
+        if ((arg.rfind("--", 0) != 0) || (separator == std::string::npos))
+        {
+            std::cerr << USAGE;
+            return 1;
+        }
+        options[arg.substr(2, separator - 2)] = arg.substr(separator + 1);
+    }
+
+    // Same default as the orchestrator's Configuration
+    std::string psk = "000102030405060708090a0b0c0d0e0f";
+    if (char* varVal = std::getenv("FTL_ORCHESTRATOR_PSK"))
+    {
+        psk = varVal;
+    }
+
+    LoadGeneratorSettings settings;
+    try
+    {
+        for (const auto& [name, value] : options)
+        {
+            if (name == "host") settings.TargetHostname = value;
+            else if (name == "port") settings.TargetPort = std::stoi(value);
+            else if (name == "psk") psk = value;
+            else if (name == "ingests") settings.IngestCount = std::stoi(value);
+            else if (name == "edges") settings.EdgeCount = std::stoi(value);
+            else if (name == "relays") settings.RelayCount = std::stoi(value);
+            else if (name == "channels") settings.ChannelCount = std::stoi(value);
+            else if (name == "live-fraction") settings.LiveChannelFraction = std::stod(value);
+            else if (name == "zipf") settings.ZipfExponent = std::stod(value);
+            else if (name == "publish-rate") settings.PublishRate = std::stod(value);
+            else if (name == "subscribe-rate") settings.SubscribeRate = std::stod(value);
+            else if (name == "node-state-ms")
+                settings.NodeStateInterval = std::chrono::milliseconds(std::stoi(value));
+            else if (name == "storm-ms")
+                settings.ReconnectStormInterval = std::chrono::milliseconds(std::stoi(value));
+            else if (name == "storm-fraction") settings.ReconnectStormFraction = std::stod(value);
+            else if (name == "duration") settings.Duration = std::chrono::seconds(std::stoi(value));
+            else if (name == "connect-threads") settings.ConnectThreads = std::stoi(value);
+            else if (name == "failover-host") settings.FailoverHostname = value;
+            else if (name == "failover-port") settings.FailoverPort = std::stoi(value);
+            else if (name == "failover-timeout")
+                settings.FailoverTimeout = std::chrono::seconds(std::stoi(value));
+            else
+            {
+                std::cerr << "Unknown option --" << name << "\n" << USAGE;
+                return 1;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Invalid option value: " << e.what() << "\n" << USAGE;
+        return 1;
+    }
+    settings.PreSharedKey = hexStringToBytes(psk);
+
+    LoadGenerator loadGenerator(settings);
+    loadGenerator.Run();
+    return 0;
+}
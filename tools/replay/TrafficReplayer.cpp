@@ -0,0 +1,274 @@
+/**
+ * @file TrafficReplayer.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#include "TrafficReplayer.h"
+
+#include "Orchestrator.h"
+#include "test/mocks/MockConnection.h"
+#include "test/mocks/MockConnectionManager.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fmt/core.h>
+#include <fmt/os.h>
+#include <functional>
+#include <memory>
+#include <set>
+#include <spdlog/spdlog.h>
+
+#pragma region Helpers
+namespace
+{
+    // By captured_message_t index
+    constexpr std::array<const char*, std::variant_size_v<captured_message_t>> MESSAGE_NAMES {
+        "Connect", "Close", "Intro", "Outro", "Node State", "Subscription", "Publish", "Relay",
+    };
+
+    /**
+     * @brief A mock connection that hands relay commands sent to it back to the replayer
+     */
+    class ReplayConnection : public MockConnection
+    {
+    public:
+        ReplayConnection(
+            std::function<void(const std::string&, const ConnectionRelayPayload&)> onRelaySent) :
+            MockConnection(std::string()),
+            onRelaySent(onRelaySent)
+        { }
+
+        void SendStreamRelay(const ConnectionRelayPayload& payload) override
+        {
+            onRelaySent(GetHostname(), payload);
+        }
+
+    private:
+        std::function<void(const std::string&, const ConnectionRelayPayload&)> onRelaySent;
+    };
+
+    /**
+     * @brief Fires a captured message on the connection it was received on
+     */
+    struct MessageFirer
+    {
+        MockConnection& connection;
+
+        void operator()(const CapturedConnect&) { }
+
+        void operator()(const CapturedClose&) { }
+
+        void operator()(const ConnectionIntroPayload& payload)
+        {
+            connection.MockFireOnIntro(payload);
+        }
+
+        void operator()(const ConnectionOutroPayload& payload)
+        {
+            connection.MockFireOnOutro(payload);
+        }
+
+        void operator()(const ConnectionNodeStatePayload& payload)
+        {
+            connection.MockFireOnNodeState(payload);
+        }
+
+        void operator()(const ConnectionSubscriptionPayload& payload)
+        {
+            connection.MockFireOnChannelSubscription(payload);
+        }
+
+        void operator()(const ConnectionPublishPayload& payload)
+        {
+            connection.MockFireOnStreamPublish(payload);
+        }
+
+        void operator()(const ConnectionRelayPayload& payload)
+        {
+            connection.MockFireOnStreamRelay(payload);
+        }
+    };
+}
+#pragma endregion Helpers
+
+#pragma region Constructor/Destructor
+TrafficReplayer::TrafficReplayer(TrafficReplaySettings settings) :
+    settings(settings)
+{ }
+#pragma endregion Constructor/Destructor
+
+#pragma region Public methods
+void TrafficReplayer::Run()
+{
+    std::vector<CaptureRecord> records = TrafficCapture::ReadFromFile(settings.CapturePath);
+    std::array<uint64_t, std::variant_size_v<captured_message_t>> messageCounts { };
+    std::set<uint32_t> connectionIds;
+    for (const auto& record : records)
+    {
+        ++messageCounts.at(record.Message.index());
+        connectionIds.insert(record.ConnectionId);
+    }
+    spdlog::info(
+        "TrafficReplayer: Replaying {} records from {} connections in {}...",
+        records.size(),
+        connectionIds.size(),
+        settings.CapturePath);
+
+    std::vector<RelayCommand> relayCommands;
+    uint64_t rejectedCount = 0;
+    std::chrono::steady_clock::duration elapsed(0);
+    for (int iteration = 0; iteration < settings.Iterations; ++iteration)
+    {
+        std::vector<RelayCommand> iterationRelayCommands;
+        uint64_t iterationRejectedCount = 0;
+        auto startTime = std::chrono::steady_clock::now();
+        replay(records, iterationRelayCommands, iterationRejectedCount);
+        elapsed += (std::chrono::steady_clock::now() - startTime);
+
+        if (iteration == 0)
+        {
+            relayCommands = std::move(iterationRelayCommands);
+            rejectedCount = iterationRejectedCount;
+        }
+        else if (!std::equal(
+            relayCommands.begin(), relayCommands.end(),
+            iterationRelayCommands.begin(), iterationRelayCommands.end(),
+            [](const RelayCommand& lhs, const RelayCommand& rhs)
+            {
+                return ((lhs.IngestHostname == rhs.IngestHostname) &&
+                    (lhs.Payload.IsStartRelay == rhs.Payload.IsStartRelay) &&
+                    (lhs.Payload.ChannelId == rhs.Payload.ChannelId) &&
+                    (lhs.Payload.StreamId == rhs.Payload.StreamId) &&
+                    (lhs.Payload.TargetHostname == rhs.Payload.TargetHostname) &&
+                    (lhs.Payload.StreamKey == rhs.Payload.StreamKey));
+            }))
+        {
+            spdlog::warn(
+                "TrafficReplayer: Iteration {} sent different relay commands than the first",
+                (iteration + 1));
+        }
+    }
+
+    if (!settings.RelayOutputPath.empty())
+    {
+        writeRelayCommands(relayCommands);
+    }
+
+    uint64_t startCount = std::count_if(relayCommands.begin(), relayCommands.end(),
+        [](const RelayCommand& command) { return command.Payload.IsStartRelay; });
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    double capturedSeconds = (records.empty() ? 0 :
+        std::chrono::duration<double>(records.back().Timestamp).count());
+    std::string messageSummary;
+    for (size_t i = 0; i < messageCounts.size(); ++i)
+    {
+        if (messageCounts[i] > 0)
+        {
+            messageSummary += fmt::format(
+                "{}{} {}",
+                (messageSummary.empty() ? "" : ", "),
+                messageCounts[i],
+                MESSAGE_NAMES[i]);
+        }
+    }
+    fmt::print(
+        "\n=== Replay summary ===\n"
+        "Capture:            {} records over {:.1f}s from {} connections\n"
+        "Messages:           {}\n"
+        "Replayed:           {} time(s) in {:.3f}s ({:.0f} events/s)\n"
+        "Rejected:           {}\n"
+        "Relay commands:     {} ({} start, {} stop)\n",
+        records.size(), capturedSeconds, connectionIds.size(),
+        (messageSummary.empty() ? "none" : messageSummary),
+        settings.Iterations, seconds,
+        ((seconds > 0) ? ((records.size() * settings.Iterations) / seconds) : 0.0),
+        rejectedCount,
+        relayCommands.size(), startCount, (relayCommands.size() - startCount));
+}
+#pragma endregion Public methods
+
+#pragma region Private methods
+void TrafficReplayer::replay(
+    const std::vector<CaptureRecord>& records,
+    std::vector<RelayCommand>& relayCommands,
+    uint64_t& rejectedCount)
+{
+    auto connectionManager = std::make_unique<MockConnectionManager<MockConnection>>();
+    MockConnectionManager<MockConnection>* connectionManagerPtr = connectionManager.get();
+    auto orchestrator = std::make_unique<Orchestrator<MockConnection>>(
+        std::move(connectionManager));
+    orchestrator->Init();
+
+    auto onRelaySent =
+        [&relayCommands](const std::string& ingestHostname, const ConnectionRelayPayload& payload)
+        {
+            relayCommands.push_back(RelayCommand
+                {
+                    .IngestHostname = ingestHostname,
+                    .Payload = payload,
+                });
+        };
+    std::map<uint32_t, std::shared_ptr<MockConnection>> connections;
+    for (const auto& record : records)
+    {
+        try
+        {
+            if (std::holds_alternative<CapturedConnect>(record.Message))
+            {
+                auto connection = std::make_shared<ReplayConnection>(onRelaySent);
+                connections[record.ConnectionId] = connection;
+                connectionManagerPtr->MockFireNewConnection(connection);
+                continue;
+            }
+
+            auto connectionIt = connections.find(record.ConnectionId);
+            if (connectionIt == connections.end())
+            {
+                // The capture started after this connection did
+                ++rejectedCount;
+                continue;
+            }
+            if (std::holds_alternative<CapturedClose>(record.Message))
+            {
+                connectionIt->second->MockFireOnConnectionClosed();
+                connections.erase(connectionIt);
+                continue;
+            }
+            std::visit(MessageFirer { .connection = *connectionIt->second }, record.Message);
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::debug(
+                "TrafficReplayer: {} from connection {} was rejected: {}",
+                MESSAGE_NAMES.at(record.Message.index()),
+                record.ConnectionId,
+                e.what());
+            ++rejectedCount;
+        }
+    }
+
+    orchestrator->Stop();
+}
+
+void TrafficReplayer::writeRelayCommands(const std::vector<RelayCommand>& relayCommands)
+{
+    auto output = fmt::output_file(settings.RelayOutputPath);
+    for (const auto& command : relayCommands)
+    {
+        output.print(
+            "{} {} -> {} channel {} stream {}\n",
+            (command.Payload.IsStartRelay ? "start" : "stop"),
+            command.IngestHostname,
+            command.Payload.TargetHostname,
+            command.Payload.ChannelId,
+            command.Payload.StreamId);
+    }
+    spdlog::info(
+        "TrafficReplayer: Wrote {} relay commands to {}",
+        relayCommands.size(),
+        settings.RelayOutputPath);
+}
+#pragma endregion Private methods
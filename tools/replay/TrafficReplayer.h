@@ -0,0 +1,74 @@
+/**
+ * @file TrafficReplayer.h
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ */
+
+#pragma once
+
+#include "TrafficCapture.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief What to replay, and where to write the relay commands it produces
+ */
+struct TrafficReplaySettings
+{
+    std::string CapturePath;
+    // Every relay command is written here, one per line, so runs can be diffed; empty skips it
+    std::string RelayOutputPath;
+    // Times the capture is replayed back to back, each against a fresh orchestrator
+    int Iterations = 1;
+};
+
+/**
+ * @brief
+ *  TrafficReplayer feeds a traffic capture into an Orchestrator<MockConnection> as fast as it
+ *  will go, and reports how quickly it got through and which relay commands came out.
+ *
+ *  Replay runs on a single thread with the orchestrator's default options (no batching window,
+ *  linger or heartbeats), so the same capture always produces the same relay commands.
+ */
+class TrafficReplayer
+{
+public:
+    /* Constructor/Destructor */
+    TrafficReplayer(TrafficReplaySettings settings);
+
+    /* Public methods */
+    /**
+     * @brief Replays the capture and prints a summary
+     * @throws std::runtime_error if the capture or relay output can't be opened
+     */
+    void Run();
+
+private:
+    /**
+     * @brief A relay command the orchestrator sent to an ingest
+     */
+    struct RelayCommand
+    {
+        std::string IngestHostname;
+        ConnectionRelayPayload Payload;
+    };
+
+    /* Private members */
+    const TrafficReplaySettings settings;
+
+    /* Private methods */
+    /**
+     * @brief Replays every record once against a new orchestrator
+     * @param relayCommands relay commands the orchestrator sent, in order
+     * @param rejectedCount records whose handler threw
+     */
+    void replay(
+        const std::vector<CaptureRecord>& records,
+        std::vector<RelayCommand>& relayCommands,
+        uint64_t& rejectedCount);
+    void writeRelayCommands(const std::vector<RelayCommand>& relayCommands);
+};
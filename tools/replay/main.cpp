@@ -0,0 +1,86 @@
+/**
+ * @file main.cpp
+ * @author Hayden McAfee (hayden@outlook.com)
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2026 Hayden McAfee
+ * @brief Entrypoint for the traffic capture replay tool
+ */
+
+#include "TrafficReplayer.h"
+
+#include <iostream>
+#include <spdlog/spdlog.h>
+#include <string>
+
+namespace
+{
+    const char* USAGE = 
+        "Usage: janus-ftl-orchestrator-replay <capture file> [--option=value ...]\n"
+        "  --relays=<path>         write every relay command sent to this file\n"
+        "  --iterations=1          times to replay the capture back to back\n"
+        "  --log-level=warn        orchestrator log level while replaying\n";
+}
+
+int main(int argc, char* argv[])
+{
+    TrafficReplaySettings settings;
+    std::string logLevel = "warn";
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg(argv[i]);
+            size_t separator = arg.find('=');
+            if (arg.rfind("--", 0) != 0)
+            {
+                if (!settings.CapturePath.empty())
+                {
+                    std::cerr << USAGE;
+                    return 1;
+                }
+                settings.CapturePath = arg;
+                continue;
+            }
+            if (separator == std::string::npos)
+            {
+                std::cerr << USAGE;
+                return 1;
+            }
+            std::string name = arg.substr(2, separator - 2);
+            std::string value = arg.substr(separator + 1);
+            if (name == "relays") settings.RelayOutputPath = value;
+            else if (name == "iterations") settings.Iterations = std::stoi(value);
+            else if (name == "log-level") logLevel = value;
+            else
+            {
+                std::cerr << "Unknown option --" << name << "\n" << USAGE;
+                return 1;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Invalid option value: " << e.what() << "\n" << USAGE;
+        return 1;
+    }
+    if (settings.CapturePath.empty() || (settings.Iterations < 1))
+    {
+        std::cerr << USAGE;
+        return 1;
+    }
+
+    // The orchestrator logs every message it handles, which would swamp the replay itself
+    spdlog::set_level(spdlog::level::from_str(logLevel));
+
+    try
+    {
+        TrafficReplayer replayer(settings);
+        replayer.Run();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}